@@ -0,0 +1,269 @@
+#include "nvg_vk_arena.h"
+#include "nvg_vk_buffer.h"
+#include "nvg_vk_frame.h"
+#include "../nanovg.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Helper: Grow a record array to hold at least needed elements (doubling)
+static int nvgvk__grow_array(void** items, int* capacity, int needed, size_t itemSize)
+{
+	if (needed <= *capacity) {
+		return 1;
+	}
+
+	int newCapacity = *capacity > 0 ? *capacity : NVGVK_INITIAL_CALL_COUNT;
+	while (newCapacity < needed) {
+		newCapacity *= 2;
+	}
+
+	void* newItems = realloc(*items, itemSize * (size_t)newCapacity);
+	if (!newItems) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to grow render arena\n");
+		return 0;
+	}
+
+	*items = newItems;
+	*capacity = newCapacity;
+	return 1;
+}
+
+NVGVkCall* nvgvk_alloc_call(NVGVkContext* vk)
+{
+	if (!nvgvk__grow_array((void**)&vk->calls, &vk->callCapacity, vk->callCount + 1, sizeof(NVGVkCall))) {
+		return NULL;
+	}
+
+	NVGVkCall* call = &vk->calls[vk->callCount++];
+	memset(call, 0, sizeof(NVGVkCall));
+	return call;
+}
+
+int nvgvk_alloc_paths(NVGVkContext* vk, int count)
+{
+	if (!nvgvk__grow_array((void**)&vk->paths, &vk->pathCapacity, vk->pathCount + count, sizeof(NVGVkPath))) {
+		return -1;
+	}
+
+	int offset = vk->pathCount;
+	vk->pathCount += count;
+	return offset;
+}
+
+int nvgvk_alloc_uniforms(NVGVkContext* vk, int count)
+{
+	if (!nvgvk__grow_array((void**)&vk->uniforms, &vk->uniformCapacity, vk->uniformCount + count, sizeof(NVGVkUniforms))) {
+		return -1;
+	}
+
+	int offset = vk->uniformCount;
+	vk->uniformCount += count;
+	return offset;
+}
+
+// Helper: Append a new vertex chunk large enough for count vertices
+static NVGVkBuffer* nvgvk__add_vertex_chunk(NVGVkContext* vk, NVGVkFrame* frame, int count)
+{
+	if (frame->vertexChunkCount + 1 > frame->vertexChunkCapacity) {
+		int capacity = frame->vertexChunkCapacity > 0 ? frame->vertexChunkCapacity * 2 : 4;
+		NVGVkBuffer* chunks = (NVGVkBuffer*)realloc(frame->vertexChunks, sizeof(NVGVkBuffer) * capacity);
+		if (!chunks) {
+			fprintf(stderr, "NanoVG Vulkan: Failed to grow vertex chunk list\n");
+			return NULL;
+		}
+		frame->vertexChunks = chunks;
+		frame->vertexChunkCapacity = capacity;
+	}
+
+	// Oversized requests get a dedicated chunk so one draw never spans two buffers
+	int chunkVertices = count > NVGVK_VERTEX_CHUNK_SIZE ? count : NVGVK_VERTEX_CHUNK_SIZE;
+	NVGVkBuffer* chunk = &frame->vertexChunks[frame->vertexChunkCount];
+	VkDeviceSize chunkBytes = (VkDeviceSize)chunkVertices * (sizeof(NVGvertex) + sizeof(uint32_t));
+	if (!nvgvk_buffer_create(vk, chunk, chunkBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to create vertex chunk (%d vertices)\n", chunkVertices);
+		return NULL;
+	}
+	// Capacity covers the vertices; their uniform indices follow (nvgvk_tag_vertices)
+	chunk->capacity = (VkDeviceSize)chunkVertices * sizeof(NVGvertex);
+
+	frame->vertexChunk = frame->vertexChunkCount++;
+	return chunk;
+}
+
+NVGvertex* nvgvk_alloc_vertices(NVGVkContext* vk, int count, int* chunk, int* offset)
+{
+	if (!vk || vk->frameCount == 0 || count < 0) {
+		return NULL;
+	}
+
+	NVGVkFrame* frame = nvgvk_frame_acquire(vk);
+	VkDeviceSize bytes = (VkDeviceSize)count * sizeof(NVGvertex);
+	NVGVkBuffer* buffer = NULL;
+
+	// Chunks are filled in order; skipped space is reclaimed at the next reset
+	while (frame->vertexChunk < frame->vertexChunkCount) {
+		NVGVkBuffer* candidate = &frame->vertexChunks[frame->vertexChunk];
+		if (candidate->size + bytes <= candidate->capacity) {
+			buffer = candidate;
+			break;
+		}
+		if (++frame->vertexChunk < frame->vertexChunkCount) {
+			frame->vertexChunks[frame->vertexChunk].size = 0;
+		}
+	}
+
+	if (!buffer) {
+		buffer = nvgvk__add_vertex_chunk(vk, frame, count);
+		if (!buffer) {
+			return NULL;
+		}
+	}
+
+	*chunk = frame->vertexChunk;
+	*offset = (int)(buffer->size / sizeof(NVGvertex));
+	buffer->size += bytes;
+	vk->vertexCount += count;
+
+	return (NVGvertex*)buffer->mapped + *offset;
+}
+
+NVGvertex* nvgvk_alloc_direct_vertices(NVGVkContext* vk, int count)
+{
+	// Give back the unused tail of the previous block if nothing was allocated after it
+	if (vk->directVerts) {
+		NVGVkBuffer* prev = &vk->frames[vk->frameIndex].vertexChunks[vk->directChunk];
+		if (prev->size == (VkDeviceSize)(vk->directOffset + vk->directCount) * sizeof(NVGvertex)) {
+			prev->size = (VkDeviceSize)(vk->directOffset + vk->directUsed) * sizeof(NVGvertex);
+			vk->vertexCount -= vk->directCount - vk->directUsed;
+		}
+		vk->directVerts = NULL;
+	}
+
+	int chunk, offset;
+	NVGvertex* verts = nvgvk_alloc_vertices(vk, count + NVGVK_DIRECT_VERTEX_SLACK, &chunk, &offset);
+	if (!verts) {
+		return NULL;
+	}
+
+	vk->directVerts = verts;
+	vk->directChunk = chunk;
+	vk->directOffset = offset;
+	vk->directCount = count + NVGVK_DIRECT_VERTEX_SLACK;
+	vk->directUsed = 0;
+	return verts;
+}
+
+int nvgvk_direct_offset(NVGVkContext* vk, const NVGvertex* verts, int count, int* chunk)
+{
+	if (!vk->directVerts || verts < vk->directVerts || verts + count > vk->directVerts + vk->directCount) {
+		return -1;
+	}
+
+	int first = (int)(verts - vk->directVerts);
+	if (first + count > vk->directUsed) {
+		vk->directUsed = first + count;
+	}
+
+	*chunk = vk->directChunk;
+	return vk->directOffset + first;
+}
+
+NVGvertex* nvgvk_direct_append(NVGVkContext* vk, int count, int* offset)
+{
+	if (!vk->directVerts || vk->directUsed + count > vk->directCount) {
+		return NULL;
+	}
+
+	NVGvertex* verts = vk->directVerts + vk->directUsed;
+	*offset = vk->directOffset + vk->directUsed;
+	vk->directUsed += count;
+	return verts;
+}
+
+NVGVkGlyph* nvgvk_alloc_glyphs(NVGVkContext* vk, int count, int* first)
+{
+	if (!vk || vk->frameCount == 0 || count <= 0) {
+		return NULL;
+	}
+
+	// Nothing recorded references the buffer before the flush, so it may still be replaced
+	NVGVkBuffer* buffer = &nvgvk_frame_acquire(vk)->glyphBuffer;
+	VkDeviceSize bytes = (VkDeviceSize)count * sizeof(NVGVkGlyph);
+	if (!nvgvk_buffer_reserve(vk, buffer, buffer->size + bytes)) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to grow glyph buffer (%d glyphs)\n", count);
+		return NULL;
+	}
+
+	*first = (int)(buffer->size / sizeof(NVGVkGlyph));
+	buffer->size += bytes;
+	return (NVGVkGlyph*)buffer->mapped + *first;
+}
+
+void nvgvk_tag_vertices(NVGVkFrame* frame, int chunk, int offset, int count, uint32_t uniformIndex)
+{
+	NVGVkBuffer* buffer = &frame->vertexChunks[chunk];
+	uint32_t* indices = (uint32_t*)((unsigned char*)buffer->mapped + buffer->capacity) + offset;
+	for (int i = 0; i < count; i++) {
+		indices[i] = uniformIndex;
+	}
+}
+
+void nvgvk_arena_reset(NVGVkContext* vk)
+{
+	vk->callCount = 0;
+	vk->pathCount = 0;
+	vk->uniformCount = 0;
+	vk->vertexCount = 0;
+	vk->directVerts = NULL;
+
+	// Drop vertices and glyphs of a cancelled frame; a flushed slot is reset when reacquired
+	if (vk->frameCount > 0) {
+		NVGVkFrame* frame = &vk->frames[vk->frameIndex];
+		if (!frame->pending && !frame->submitted) {
+			nvgvk_vertex_chunks_reset(frame);
+			nvgvk_buffer_reset(&frame->glyphBuffer);
+		}
+	}
+}
+
+void nvgvk_arena_destroy(NVGVkContext* vk)
+{
+	free(vk->calls);
+	free(vk->paths);
+	free(vk->uniforms);
+	free(vk->draws);
+	vk->draws = NULL;
+	vk->drawCapacity = 0;
+	vk->drawCount = 0;
+	vk->calls = NULL;
+	vk->paths = NULL;
+	vk->uniforms = NULL;
+	vk->callCapacity = 0;
+	vk->pathCapacity = 0;
+	vk->uniformCapacity = 0;
+	vk->callCount = 0;
+	vk->pathCount = 0;
+	vk->uniformCount = 0;
+}
+
+void nvgvk_vertex_chunks_reset(NVGVkFrame* frame)
+{
+	// Later chunks are cleared lazily as allocation reaches them
+	frame->vertexChunk = 0;
+	if (frame->vertexChunkCount > 0) {
+		frame->vertexChunks[0].size = 0;
+	}
+}
+
+void nvgvk_vertex_chunks_destroy(NVGVkContext* vk, NVGVkFrame* frame)
+{
+	for (int i = 0; i < frame->vertexChunkCount; i++) {
+		nvgvk_buffer_destroy(vk, &frame->vertexChunks[i]);
+	}
+	free(frame->vertexChunks);
+	frame->vertexChunks = NULL;
+	frame->vertexChunkCount = 0;
+	frame->vertexChunkCapacity = 0;
+	frame->vertexChunk = 0;
+}
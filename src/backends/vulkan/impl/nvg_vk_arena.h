@@ -0,0 +1,56 @@
+#ifndef NVG_VK_ARENA_H
+#define NVG_VK_ARENA_H
+
+#include "nvg_vk_types.h"
+
+// Per-frame geometry arena. Calls, paths and uniforms are growable arrays and
+// vertices live in chunked, persistently mapped GPU buffers owned by the
+// current frame. All storage keeps its high-water capacity across frames.
+
+// Allocate render records. Offsets index vk->paths / vk->uniforms and stay
+// valid when the arrays grow; returned pointers do not. Return NULL / -1 on
+// allocation failure.
+NVGVkCall* nvgvk_alloc_call(NVGVkContext* vk);
+int nvgvk_alloc_paths(NVGVkContext* vk, int count);
+int nvgvk_alloc_uniforms(NVGVkContext* vk, int count);
+
+// Allocate count contiguous vertices in the current frame's vertex chunks.
+// Returns a pointer into mapped GPU memory and the chunk index / first vertex
+// to draw from, or NULL on failure.
+NVGvertex* nvgvk_alloc_vertices(NVGVkContext* vk, int count, int* chunk, int* offset);
+
+// Zero-copy vertex output: hand the front end count vertices of mapped GPU
+// memory to expand paths/text into. Render callbacks then use
+// nvgvk_direct_offset to recognise vertices inside that block and draw them
+// in place instead of copying.
+NVGvertex* nvgvk_alloc_direct_vertices(NVGVkContext* vk, int count);
+
+// Returns the chunk-relative offset of verts[0..count) if it lies inside the
+// current direct block, or -1 if the vertices must be copied.
+int nvgvk_direct_offset(NVGVkContext* vk, const NVGvertex* verts, int count, int* chunk);
+
+// Append count vertices right after the used part of the direct block (the
+// fill cover quad). Returns NULL if the block has no room left.
+NVGvertex* nvgvk_direct_append(NVGVkContext* vk, int count, int* offset);
+
+// Allocate count glyph instances in the current frame's glyph buffer (instanced
+// text). Returns a pointer into mapped GPU memory and the first instance, or
+// NULL on failure. The pointer is only valid until the next allocation.
+NVGVkGlyph* nvgvk_alloc_glyphs(NVGVkContext* vk, int count, int* first);
+
+// Store the uniform index of vertices [offset, offset + count) of a chunk.
+// Shaders look up each vertex's NVGVkFragUniforms with it, so adjacent draws
+// of different calls can share one vkCmdDraw.
+void nvgvk_tag_vertices(NVGVkFrame* frame, int chunk, int offset, int count, uint32_t uniformIndex);
+
+// O(1) reset of everything recorded since the last flush
+void nvgvk_arena_reset(NVGVkContext* vk);
+
+// Free the CPU side arrays (vertex chunks are freed with their frame)
+void nvgvk_arena_destroy(NVGVkContext* vk);
+
+// Vertex chunk lifetime, called by the frame ring
+void nvgvk_vertex_chunks_reset(NVGVkFrame* frame);
+void nvgvk_vertex_chunks_destroy(NVGVkContext* vk, NVGVkFrame* frame);
+
+#endif // NVG_VK_ARENA_H
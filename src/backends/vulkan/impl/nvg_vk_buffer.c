@@ -1,25 +1,9 @@
 #include "nvg_vk_buffer.h"
+#include "nvg_vk_memory.h"
+#include "nvg_vk_frame.h"
 #include <stdio.h>
 #include <string.h>
 
-// Helper function to find suitable memory type
-static uint32_t nvgvk__find_memory_type(NVGVkContext* vk, uint32_t typeFilter,
-                                        VkMemoryPropertyFlags properties)
-{
-	VkPhysicalDeviceMemoryProperties memProperties;
-	vkGetPhysicalDeviceMemoryProperties(vk->physicalDevice, &memProperties);
-
-	for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-		if ((typeFilter & (1 << i)) &&
-		    (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-			return i;
-		}
-	}
-
-	fprintf(stderr, "NanoVG Vulkan: Failed to find suitable memory type\n");
-	return UINT32_MAX;
-}
-
 int nvgvk_buffer_create(NVGVkContext* vk, NVGVkBuffer* buffer,
                         VkDeviceSize size, VkBufferUsageFlags usage)
 {
@@ -47,35 +31,18 @@ int nvgvk_buffer_create(NVGVkContext* vk, NVGVkBuffer* buffer,
 	VkMemoryRequirements memRequirements;
 	vkGetBufferMemoryRequirements(vk->device, buffer->buffer, &memRequirements);
 
-	// Allocate memory (host-visible and coherent for easy CPU access)
-	VkMemoryAllocateInfo allocInfo = {0};
-	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	allocInfo.allocationSize = memRequirements.size;
-	allocInfo.memoryTypeIndex = nvgvk__find_memory_type(vk,
-		memRequirements.memoryTypeBits,
-		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-	if (allocInfo.memoryTypeIndex == UINT32_MAX) {
-		vkDestroyBuffer(vk->device, buffer->buffer, NULL);
-		return 0;
-	}
-
-	if (vkAllocateMemory(vk->device, &allocInfo, NULL, &buffer->memory) != VK_SUCCESS) {
+	// Sub-allocate host-visible, coherent memory; blocks stay persistently mapped
+	if (!nvgvk_memory_alloc(vk, &memRequirements,
+	                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+	                        1, &buffer->allocation)) {
 		fprintf(stderr, "NanoVG Vulkan: Failed to allocate buffer memory\n");
 		vkDestroyBuffer(vk->device, buffer->buffer, NULL);
+		buffer->buffer = VK_NULL_HANDLE;
 		return 0;
 	}
 
-	// Bind buffer memory
-	vkBindBufferMemory(vk->device, buffer->buffer, buffer->memory, 0);
-
-	// Map memory persistently
-	if (vkMapMemory(vk->device, buffer->memory, 0, size, 0, &buffer->mapped) != VK_SUCCESS) {
-		fprintf(stderr, "NanoVG Vulkan: Failed to map buffer memory\n");
-		vkFreeMemory(vk->device, buffer->memory, NULL);
-		vkDestroyBuffer(vk->device, buffer->buffer, NULL);
-		return 0;
-	}
+	vkBindBufferMemory(vk->device, buffer->buffer, buffer->allocation.memory, buffer->allocation.offset);
+	buffer->mapped = buffer->allocation.mapped;
 
 	return 1;
 }
@@ -86,21 +53,14 @@ void nvgvk_buffer_destroy(NVGVkContext* vk, NVGVkBuffer* buffer)
 		return;
 	}
 
-	if (buffer->mapped) {
-		vkUnmapMemory(vk->device, buffer->memory);
-		buffer->mapped = NULL;
-	}
-
-	if (buffer->memory) {
-		vkFreeMemory(vk->device, buffer->memory, NULL);
-		buffer->memory = VK_NULL_HANDLE;
-	}
-
 	if (buffer->buffer) {
 		vkDestroyBuffer(vk->device, buffer->buffer, NULL);
 		buffer->buffer = VK_NULL_HANDLE;
 	}
 
+	buffer->mapped = NULL;
+	nvgvk_memory_free(vk, &buffer->allocation);
+
 	buffer->size = 0;
 	buffer->capacity = 0;
 }
@@ -162,8 +122,8 @@ int nvgvk_buffer_reserve(NVGVkContext* vk, NVGVkBuffer* buffer,
 		newBuffer.size = buffer->size;
 	}
 
-	// Destroy old buffer
-	nvgvk_buffer_destroy(vk, buffer);
+	// Submitted work may still read the old buffer (staging copies)
+	nvgvk_release_buffer(vk, buffer);
 
 	// Replace with new buffer
 	*buffer = newBuffer;
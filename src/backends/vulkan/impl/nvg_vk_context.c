@@ -2,8 +2,14 @@
 #include "nvg_vk_buffer.h"
 #include "nvg_vk_render.h"
 #include "nvg_vk_texture.h"
+#include "nvg_vk_upload.h"
+#include "nvg_vk_frame.h"
+#include "nvg_vk_arena.h"
+#include "nvg_vk_memory.h"
+#include "nvg_vk_pipeline.h"
 #include "nvg_vk_color_space_ubo.h"
 #include "../nanovg.h"
+#include "../nvg_vk.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -24,6 +30,10 @@ int nvgvk_create(void* userPtr, const NVGVkCreateInfo* createInfo)
 	vk->commandPool = createInfo->commandPool;
 	vk->flags = createInfo->flags;
 
+	// Buffers and textures are sub-allocated from shared device memory blocks
+	nvgvk_memory_init(vk);
+	vk->frameSerial = 1;
+
 	// Allocate command buffer
 	VkCommandBufferAllocateInfo cmdAllocInfo = {0};
 	cmdAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -35,45 +45,67 @@ int nvgvk_create(void* userPtr, const NVGVkCreateInfo* createInfo)
 		fprintf(stderr, "NanoVG Vulkan: Failed to allocate command buffer\n");
 		return 0;
 	}
+	vk->ownedCommandBuffer = vk->commandBuffer;
+
+	// Create uniform buffer (for viewSize), one aligned slot per frame in flight.
+	// Slots are selected with a dynamic offset so descriptor sets stay per-texture.
+	VkPhysicalDeviceProperties deviceProperties;
+	vkGetPhysicalDeviceProperties(vk->physicalDevice, &deviceProperties);
+	VkDeviceSize uniformAlignment = deviceProperties.limits.minUniformBufferOffsetAlignment;
+	if (uniformAlignment == 0) {
+		uniformAlignment = 1;
+	}
+	vk->uniformStride = (sizeof(float) * 2 + uniformAlignment - 1) / uniformAlignment * uniformAlignment;
+
+	// Multi-draw indirect must have been enabled by the application at device creation
+	if (vk->flags & NVG_MULTI_DRAW_INDIRECT) {
+		VkPhysicalDeviceFeatures features;
+		vkGetPhysicalDeviceFeatures(vk->physicalDevice, &features);
+		if (features.multiDrawIndirect && deviceProperties.limits.maxDrawIndirectCount > 1) {
+			vk->multiDrawIndirect = 1;
+			vk->maxDrawIndirectCount = deviceProperties.limits.maxDrawIndirectCount;
+		}
+	}
 
-	// Create fence for upload synchronization
-	VkFenceCreateInfo fenceInfo = {0};
-	fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-	fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;  // Start signaled so first use works
-
-	if (vkCreateFence(vk->device, &fenceInfo, NULL, &vk->uploadFence) != VK_SUCCESS) {
-		fprintf(stderr, "NanoVG Vulkan: Failed to create upload fence\n");
-		vkFreeCommandBuffers(vk->device, vk->commandPool, 1, &vk->commandBuffer);
-		return 0;
+	// Likewise descriptor indexing; the table and set 0 together sample NVGVK_MAX_TEXTURES + 1 images
+	if ((vk->flags & NVG_BINDLESS_TEXTURES) && deviceProperties.apiVersion >= VK_API_VERSION_1_1) {
+		VkPhysicalDeviceDescriptorIndexingFeatures indexing = {0};
+		indexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+		VkPhysicalDeviceFeatures2 features2 = {0};
+		features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		features2.pNext = &indexing;
+		vkGetPhysicalDeviceFeatures2(vk->physicalDevice, &features2);
+
+		const VkPhysicalDeviceLimits* limits = &deviceProperties.limits;
+		if (indexing.shaderSampledImageArrayNonUniformIndexing && indexing.descriptorBindingPartiallyBound &&
+		    limits->maxPerStageDescriptorSamplers > NVGVK_MAX_TEXTURES &&
+		    limits->maxPerStageDescriptorSampledImages > NVGVK_MAX_TEXTURES &&
+		    limits->maxDescriptorSetSamplers > NVGVK_MAX_TEXTURES &&
+		    limits->maxDescriptorSetSampledImages > NVGVK_MAX_TEXTURES &&
+		    limits->maxBoundDescriptorSets >= 4) {
+			vk->bindless = 1;
+		}
 	}
 
-	// Initialize vertex data
-	vk->vertexCapacity = NVGVK_INITIAL_VERTEX_COUNT;
-	vk->vertices = (float*)malloc(vk->vertexCapacity * sizeof(NVGvertex));
-	if (!vk->vertices) {
-		fprintf(stderr, "NanoVG Vulkan: Failed to allocate vertex buffer\n");
-		vkDestroyFence(vk->device, vk->uploadFence, NULL);
+	VkDeviceSize uniformBufferSize = vk->uniformStride * NVGVK_MAX_FRAMES_IN_FLIGHT;
+	if (!nvgvk_buffer_create(vk, &vk->uniformBuffer, uniformBufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to create uniform buffer\n");
 		vkFreeCommandBuffers(vk->device, vk->commandPool, 1, &vk->commandBuffer);
 		return 0;
 	}
 
-	// Create vertex buffer
-	VkDeviceSize vertexBufferSize = vk->vertexCapacity * sizeof(NVGvertex);
-	if (!nvgvk_buffer_create(vk, &vk->vertexBuffer, vertexBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)) {
-		fprintf(stderr, "NanoVG Vulkan: Failed to create vertex buffer\n");
-		free(vk->vertices);
-		vkDestroyFence(vk->device, vk->uploadFence, NULL);
+	// Fragment uniform storage layout and pool (the frame ring allocates its sets)
+	if (!nvgvk_uniform_storage_init(vk)) {
+		nvgvk_buffer_destroy(vk, &vk->uniformBuffer);
 		vkFreeCommandBuffers(vk->device, vk->commandPool, 1, &vk->commandBuffer);
 		return 0;
 	}
 
-	// Create uniform buffer (for viewSize)
-	VkDeviceSize uniformBufferSize = sizeof(float) * 2;
-	if (!nvgvk_buffer_create(vk, &vk->uniformBuffer, uniformBufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)) {
-		fprintf(stderr, "NanoVG Vulkan: Failed to create uniform buffer\n");
-		nvgvk_buffer_destroy(vk, &vk->vertexBuffer);
-		free(vk->vertices);
-		vkDestroyFence(vk->device, vk->uploadFence, NULL);
+	// Create frames-in-flight ring (vertex buffers, staging buffers, fences)
+	if (!nvgvk_frames_init(vk, createInfo->framesInFlight)) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to create frame ring\n");
+		nvgvk_uniform_storage_destroy(vk);
+		nvgvk_buffer_destroy(vk, &vk->uniformBuffer);
 		vkFreeCommandBuffers(vk->device, vk->commandPool, 1, &vk->commandBuffer);
 		return 0;
 	}
@@ -81,10 +113,9 @@ int nvgvk_create(void* userPtr, const NVGVkCreateInfo* createInfo)
 	// Initialize texture descriptor system
 	if (!nvgvk__init_texture_descriptors(vk)) {
 		fprintf(stderr, "NanoVG Vulkan: Failed to initialize texture descriptors\n");
+		nvgvk_frames_destroy(vk);
+		nvgvk_uniform_storage_destroy(vk);
 		nvgvk_buffer_destroy(vk, &vk->uniformBuffer);
-		nvgvk_buffer_destroy(vk, &vk->vertexBuffer);
-		free(vk->vertices);
-		vkDestroyFence(vk->device, vk->uploadFence, NULL);
 		vkFreeCommandBuffers(vk->device, vk->commandPool, 1, &vk->commandBuffer);
 		return 0;
 	}
@@ -93,10 +124,9 @@ int nvgvk_create(void* userPtr, const NVGVkCreateInfo* createInfo)
 	if (!nvgvk_init_color_space_layout(vk)) {
 		fprintf(stderr, "NanoVG Vulkan: Failed to initialize color space layout\n");
 		nvgvk__destroy_texture_descriptors(vk);
+		nvgvk_frames_destroy(vk);
+		nvgvk_uniform_storage_destroy(vk);
 		nvgvk_buffer_destroy(vk, &vk->uniformBuffer);
-		nvgvk_buffer_destroy(vk, &vk->vertexBuffer);
-		free(vk->vertices);
-		vkDestroyFence(vk->device, vk->uploadFence, NULL);
 		vkFreeCommandBuffers(vk->device, vk->commandPool, 1, &vk->commandBuffer);
 		return 0;
 	}
@@ -114,18 +144,27 @@ void nvgvk_delete(void* userPtr)
 	// Wait for device to be idle before cleanup
 	vkDeviceWaitIdle(vk->device);
 
+	// Release textures the application did not delete; their memory lives in shared blocks
+	for (int i = 0; i < NVGVK_MAX_TEXTURES; i++) {
+		if (vk->textures[i].image) {
+			nvgvk_delete_texture(vk, i + 1);
+		}
+	}
+
+	// The device is idle, so every released resource can go now
+	nvgvk_collect_garbage(vk, 1);
+
 	// Destroy texture descriptor system
 	nvgvk__destroy_texture_descriptors(vk);
 
-	// Destroy buffers
+	// Destroy frame ring and buffers
+	nvgvk_frames_destroy(vk);
+	nvgvk_uniform_storage_destroy(vk);
 	nvgvk_buffer_destroy(vk, &vk->uniformBuffer);
-	nvgvk_buffer_destroy(vk, &vk->vertexBuffer);
+	nvgvk_destroy_color_space_ubo(vk);
 
-	// Free vertex data
-	if (vk->vertices) {
-		free(vk->vertices);
-		vk->vertices = NULL;
-	}
+	// Free render arena
+	nvgvk_arena_destroy(vk);
 
 	// Free shader path
 	if (vk->shaderBasePath) {
@@ -133,17 +172,21 @@ void nvgvk_delete(void* userPtr)
 		vk->shaderBasePath = NULL;
 	}
 
-	// Destroy fence
-	if (vk->uploadFence) {
-		vkDestroyFence(vk->device, vk->uploadFence, NULL);
-		vk->uploadFence = VK_NULL_HANDLE;
-	}
+	// Persist compiled pipelines for the next run, then drop the cache
+	nvgvk_pipeline_cache_destroy(vk);
+
+	// Free pending upload queue
+	nvgvk_upload_destroy(vk);
+
+	// Free device memory blocks (every buffer and texture is gone by now)
+	nvgvk_memory_destroy(vk);
 
 	// Free command buffer
-	if (vk->commandBuffer) {
-		vkFreeCommandBuffers(vk->device, vk->commandPool, 1, &vk->commandBuffer);
-		vk->commandBuffer = VK_NULL_HANDLE;
+	if (vk->ownedCommandBuffer) {
+		vkFreeCommandBuffers(vk->device, vk->commandPool, 1, &vk->ownedCommandBuffer);
+		vk->ownedCommandBuffer = VK_NULL_HANDLE;
 	}
+	vk->commandBuffer = VK_NULL_HANDLE;
 }
 
 void nvgvk_viewport(void* userPtr, float width, float height, float devicePixelRatio)
@@ -156,6 +199,9 @@ void nvgvk_viewport(void* userPtr, float width, float height, float devicePixelR
 	vk->viewWidth = width;
 	vk->viewHeight = height;
 	vk->devicePixelRatio = devicePixelRatio;
+
+	// nvgBeginFrame: fence the previous frame and wait for this ring slot
+	nvgvk_frame_begin(vk);
 }
 
 void nvgvk_cancel(void* userPtr)
@@ -165,69 +211,84 @@ void nvgvk_cancel(void* userPtr)
 		return;
 	}
 
-	// Reset render state
-	vk->vertexCount = 0;
-	vk->pathCount = 0;
-	vk->callCount = 0;
-	vk->uniformCount = 0;
+	// Reset render state (arena keeps its capacity)
+	nvgvk_arena_reset(vk);
+}
+
+// Helper: Tag every vertex range a call draws with its uniform index
+static void nvgvk__tag_call(NVGVkContext* vk, NVGVkFrame* frame, NVGVkCall* call)
+{
+	uint32_t index = (uint32_t)call->uniformOffset;
+
+	for (int i = 0; i < call->pathCount; i++) {
+		NVGVkPath* path = &vk->paths[call->pathOffset + i];
+		if (path->fillCount > 0) {
+			nvgvk_tag_vertices(frame, call->vertexChunk, path->fillOffset, path->fillCount, index);
+		}
+		if (path->strokeCount > 0) {
+			nvgvk_tag_vertices(frame, call->vertexChunk, path->strokeOffset, path->strokeCount, index);
+		}
+	}
+	if (call->triangleCount > 0) {
+		nvgvk_tag_vertices(frame, call->vertexChunk, call->triangleOffset, call->triangleCount, index);
+	}
 }
 
 void nvgvk_flush(void* userPtr)
 {
 	NVGVkContext* vk = (NVGVkContext*)userPtr;
-	if (!vk || vk->callCount == 0) {
+	if (!vk) {
 		return;
 	}
 
-	printf("[FLUSH] inRenderPass=%d, callCount=%d\n", vk->inRenderPass, vk->callCount);
-
-	// Upload vertex data to buffer
-	if (vk->vertexCount > 0) {
-		VkDeviceSize vertexDataSize = vk->vertexCount * sizeof(NVGvertex);
-		printf("[nvgvk_flush] Uploading %d vertices (%zu bytes) to GPU\n",
-			vk->vertexCount, vertexDataSize);
-
-		// Debug: print vertices at different offsets
-		NVGvertex* verts = (NVGvertex*)vk->vertices;
-		printf("[VERTEX DEBUG] Total vertex count: %d\n", vk->vertexCount);
-		printf("[VERTEX DEBUG] First 5 vertices (title text):\n");
-		for (int i = 18; i < 23 && i < vk->vertexCount; i++) {
-			printf("  Vert %d: pos=(%.1f,%.1f) uv=(%.4f,%.4f)\n",
-				i, (double)verts[i].x, (double)verts[i].y,
-				(double)verts[i].u, (double)verts[i].v);
-		}
-		printf("[VERTEX DEBUG] First test string vertices (offset ~162):\n");
-		for (int i = 162; i < 167 && i < vk->vertexCount; i++) {
-			printf("  Vert %d: pos=(%.1f,%.1f) uv=(%.4f,%.4f)\n",
-				i, (double)verts[i].x, (double)verts[i].y,
-				(double)verts[i].u, (double)verts[i].v);
-		}
+	// Submit this frame's texture/atlas transfers ahead of the frame command buffer
+	nvgvk_upload_submit(vk);
 
-		nvgvk_buffer_upload(vk, &vk->vertexBuffer, vk->vertices, vertexDataSize);
+	NVGVkFrame* frame = nvgvk_frame_acquire(vk);
 
-		// Verify upload: read back vertices from GPU buffer at same offsets
-		NVGvertex* gpuVerts = (NVGvertex*)vk->vertexBuffer.mapped;
-		printf("[VERIFY GPU] Vert 18 (title): pos=(%.1f,%.1f) uv=(%.4f,%.4f)\n",
-			(double)gpuVerts[18].x, (double)gpuVerts[18].y,
-			(double)gpuVerts[18].u, (double)gpuVerts[18].v);
-		printf("[VERIFY GPU] Vert 162 (test string): pos=(%.1f,%.1f) uv=(%.4f,%.4f)\n",
-			(double)gpuVerts[162].x, (double)gpuVerts[162].y,
-			(double)gpuVerts[162].u, (double)gpuVerts[162].v);
+	if (vk->callCount == 0) {
+		// Still retire the slot if transfers were submitted from it
+		if (frame->uploadsSubmitted) {
+			nvgvk_frame_end(vk);
+		}
+		return;
 	}
 
-	// Upload view uniforms (viewSize)
+	printf("[FLUSH] inRenderPass=%d, callCount=%d\n", vk->inRenderPass, vk->callCount);
+
+	// Upload view uniforms (viewSize) into this frame's slot
 	float viewSize[2] = {vk->viewWidth, vk->viewHeight};
 	printf("[nvg_vk] viewSize = %.1f x %.1f, devicePixelRatio = %.2f\n", viewSize[0], viewSize[1], vk->devicePixelRatio);
-	nvgvk_buffer_upload(vk, &vk->uniformBuffer, viewSize, sizeof(viewSize));
+	memcpy((unsigned char*)vk->uniformBuffer.mapped + frame->uniformOffset, viewSize, sizeof(viewSize));
+
+	// Fragment uniforms go to the frame's storage buffer, vertices carry their index
+	if (!nvgvk_frame_upload_uniforms(vk, frame)) {
+		nvgvk_frame_end(vk);
+		nvgvk_cancel(userPtr);
+		return;
+	}
+	for (int i = 0; i < vk->callCount; i++) {
+		nvgvk__tag_call(vk, frame, &vk->calls[i]);
+	}
 
-	// Update descriptor sets for all pipelines
+	// Textures created or deleted since this slot was last recorded
+	if (vk->bindless && !nvgvk_texture_table_update(vk, frame)) {
+		nvgvk_frame_end(vk);
+		nvgvk_cancel(userPtr);
+		return;
+	}
+
+	// Setup writes only the sets whose bindings changed since the previous flush
+	vk->counters.calls = vk->callCount;
 	nvgvk_setup_render(vk);
 
-	// Bind vertex buffer
-	VkDeviceSize offset = 0;
-	vkCmdBindVertexBuffers(vk->commandBuffer, 0, 1, &vk->vertexBuffer.buffer, &offset);
-	printf("[FLUSH] Bound vertex buffer %p with %d vertices uploaded\n",
-	       (void*)vk->vertexBuffer.buffer, vk->vertexCount);
+	// Vertex chunks (or the glyph buffer) are bound lazily as calls switch between them
+	int boundChunk = -2;
+
+	// The command buffer may be new this frame: bind the first pipeline and set unconditionally
+	vk->currentPipeline = VK_NULL_HANDLE;
+	vk->currentDescriptorSet = VK_NULL_HANDLE;
+	vk->drawCount = 0;
 
 	// Bind color space UBO (set = 1) if available
 	// This is bound once per frame and shared across all draw calls
@@ -236,10 +297,40 @@ void nvgvk_flush(void* userPtr)
 		                        vk->pipelines[0].layout, 1, 1, &vk->colorSpaceDescriptorSet, 0, NULL);
 	}
 
+	// Bind this frame's fragment uniforms (set = 2), shared by all draw calls
+	if (vk->pipelines[0].layout != VK_NULL_HANDLE) {
+		vkCmdBindDescriptorSets(vk->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+		                        vk->pipelines[0].layout, 2, 1, &frame->uniformStorageSet, 0, NULL);
+	}
+
+	// Bind this frame's texture table (set = 3), indexed by the calls' image slots
+	if (vk->bindless && frame->textureTableSet != VK_NULL_HANDLE && vk->pipelines[0].layout != VK_NULL_HANDLE) {
+		vkCmdBindDescriptorSets(vk->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+		                        vk->pipelines[0].layout, 3, 1, &frame->textureTableSet, 0, NULL);
+	}
+
 	// Process all render calls
 	for (int i = 0; i < vk->callCount; i++) {
 		NVGVkCall* call = &vk->calls[i];
 
+		if (call->vertexChunk == NVGVK_GLYPH_BUFFER && boundChunk != NVGVK_GLYPH_BUFFER) {
+			// Glyph instances carry their uniform index themselves
+			VkDeviceSize offset = 0;
+			nvgvk_flush_draws(vk);
+			vkCmdBindVertexBuffers(vk->commandBuffer, 0, 1, &frame->glyphBuffer.buffer, &offset);
+			vk->counters.vertexBufferBinds++;
+			boundChunk = NVGVK_GLYPH_BUFFER;
+		} else if (call->vertexChunk != NVGVK_GLYPH_BUFFER && call->vertexChunk != boundChunk) {
+			// Binding 1 is the uniform index stream stored behind the chunk's vertices
+			NVGVkBuffer* chunk = &frame->vertexChunks[call->vertexChunk];
+			VkBuffer buffers[2] = {chunk->buffer, chunk->buffer};
+			VkDeviceSize offsets[2] = {0, chunk->capacity};
+			nvgvk_flush_draws(vk);
+			vkCmdBindVertexBuffers(vk->commandBuffer, 0, 2, buffers, offsets);
+			vk->counters.vertexBufferBinds++;
+			boundChunk = call->vertexChunk;
+		}
+
 		switch (call->type) {
 			case NVGVK_FILL:
 				nvgvk_render_fill(vk, call);
@@ -253,10 +344,23 @@ void nvgvk_flush(void* userPtr)
 			case NVGVK_TRIANGLES:
 				nvgvk_render_triangles(vk, call);
 				break;
+			case NVGVK_GLYPHS:
+				nvgvk_render_glyphs(vk, call);
+				break;
+			case NVGVK_SHAPE:
+				nvgvk_render_shape(vk, call);
+				break;
 			default:
 				break;
 		}
 	}
 
+	nvgvk_flush_draws(vk);
+	vk->flushCounters = vk->counters;
+	memset(&vk->counters, 0, sizeof(vk->counters));
+
+	// The frame's buffers are referenced by vk->commandBuffer until its fence signals
+	nvgvk_frame_end(vk);
+
 	nvgvk_cancel(userPtr);
 }
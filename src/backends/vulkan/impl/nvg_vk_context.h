@@ -10,6 +10,7 @@ typedef struct NVGVkCreateInfo {
 	VkQueue queue;
 	VkCommandPool commandPool;
 	int flags;
+	int framesInFlight;  // Depth of the per-frame resource ring (0 = NVGVK_DEFAULT_FRAMES_IN_FLIGHT)
 } NVGVkCreateInfo;
 
 // Context lifecycle functions
@@ -0,0 +1,376 @@
+#include "nvg_vk_frame.h"
+#include "nvg_vk_buffer.h"
+#include "nvg_vk_arena.h"
+#include "nvg_vk_memory.h"
+#include <stdlib.h>
+#include "../nanovg.h"
+#include <stdio.h>
+#include <string.h>
+
+int nvgvk_frames_init(NVGVkContext* vk, int count)
+{
+	if (count <= 0) {
+		count = NVGVK_DEFAULT_FRAMES_IN_FLIGHT;
+	}
+	if (count > NVGVK_MAX_FRAMES_IN_FLIGHT) {
+		count = NVGVK_MAX_FRAMES_IN_FLIGHT;
+	}
+
+	VkCommandBuffer cmds[NVGVK_MAX_FRAMES_IN_FLIGHT];
+
+	VkCommandBufferAllocateInfo allocInfo = {0};
+	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	allocInfo.commandPool = vk->commandPool;
+	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	allocInfo.commandBufferCount = (uint32_t)count;
+
+	if (vkAllocateCommandBuffers(vk->device, &allocInfo, cmds) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to allocate frame command buffers\n");
+		return 0;
+	}
+
+	vk->frameCount = count;
+	vk->frameIndex = 0;
+
+	for (int i = 0; i < count; i++) {
+		vk->frames[i].uploadCommandBuffer = cmds[i];
+	}
+
+	for (int i = 0; i < count; i++) {
+		NVGVkFrame* frame = &vk->frames[i];
+
+		VkFenceCreateInfo fenceInfo = {0};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+		if (vkCreateFence(vk->device, &fenceInfo, NULL, &frame->fence) != VK_SUCCESS) {
+			fprintf(stderr, "NanoVG Vulkan: Failed to create frame fence\n");
+			nvgvk_frames_destroy(vk);
+			return 0;
+		}
+
+		if (!nvgvk_buffer_create(vk, &frame->stagingBuffer, NVGVK_STAGING_INITIAL_SIZE, VK_BUFFER_USAGE_TRANSFER_SRC_BIT)) {
+			fprintf(stderr, "NanoVG Vulkan: Failed to create frame staging buffer\n");
+			nvgvk_frames_destroy(vk);
+			return 0;
+		}
+
+		frame->uniformOffset = vk->uniformStride * i;
+
+		if (!nvgvk_buffer_create(vk, &frame->indirectBuffer, NVGVK_INDIRECT_INITIAL_SIZE, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT)) {
+			fprintf(stderr, "NanoVG Vulkan: Failed to create frame indirect buffer\n");
+			nvgvk_frames_destroy(vk);
+			return 0;
+		}
+
+		if (!nvgvk_buffer_create(vk, &frame->glyphBuffer, sizeof(NVGVkGlyph) * NVGVK_GLYPH_INITIAL_COUNT,
+		                         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)) {
+			fprintf(stderr, "NanoVG Vulkan: Failed to create frame glyph buffer\n");
+			nvgvk_frames_destroy(vk);
+			return 0;
+		}
+
+		if (!nvgvk_buffer_create(vk, &frame->uniformStorage, sizeof(NVGVkFragUniforms) * NVGVK_INITIAL_CALL_COUNT,
+		                         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)) {
+			fprintf(stderr, "NanoVG Vulkan: Failed to create frame uniform storage\n");
+			nvgvk_frames_destroy(vk);
+			return 0;
+		}
+
+		VkDescriptorSetAllocateInfo setInfo = {0};
+		setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		setInfo.descriptorPool = vk->uniformStoragePool;
+		setInfo.descriptorSetCount = 1;
+		setInfo.pSetLayouts = &vk->uniformStorageLayout;
+
+		if (vkAllocateDescriptorSets(vk->device, &setInfo, &frame->uniformStorageSet) != VK_SUCCESS) {
+			fprintf(stderr, "NanoVG Vulkan: Failed to allocate uniform storage descriptor set\n");
+			nvgvk_frames_destroy(vk);
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+void nvgvk_frames_destroy(NVGVkContext* vk)
+{
+	for (int i = 0; i < vk->frameCount; i++) {
+		NVGVkFrame* frame = &vk->frames[i];
+
+		if (frame->submitted && frame->fence) {
+			vkWaitForFences(vk->device, 1, &frame->fence, VK_TRUE, UINT64_MAX);
+		}
+		nvgvk_buffer_destroy(vk, &frame->stagingBuffer);
+		nvgvk_buffer_destroy(vk, &frame->indirectBuffer);
+		nvgvk_buffer_destroy(vk, &frame->glyphBuffer);
+		nvgvk_buffer_destroy(vk, &frame->uniformStorage);
+		nvgvk_vertex_chunks_destroy(vk, frame);
+		if (frame->fence) {
+			vkDestroyFence(vk->device, frame->fence, NULL);
+		}
+		if (frame->uploadCommandBuffer) {
+			vkFreeCommandBuffers(vk->device, vk->commandPool, 1, &frame->uploadCommandBuffer);
+		}
+		memset(frame, 0, sizeof(NVGVkFrame));
+	}
+
+	// Frees every frame's uniform storage and texture table sets
+	if (vk->uniformStoragePool) {
+		vkResetDescriptorPool(vk->device, vk->uniformStoragePool, 0);
+	}
+	if (vk->textureTablePool) {
+		vkResetDescriptorPool(vk->device, vk->textureTablePool, 0);
+	}
+
+	vk->frameCount = 0;
+	vk->frameIndex = 0;
+}
+
+int nvgvk_uniform_storage_init(NVGVkContext* vk)
+{
+	VkDescriptorSetLayoutBinding binding = {0};
+	binding.binding = 0;
+	binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	binding.descriptorCount = 1;
+	// The instanced text vertex shader reads the glyph transform of its call
+	binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo = {0};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.bindingCount = 1;
+	layoutInfo.pBindings = &binding;
+
+	if (vkCreateDescriptorSetLayout(vk->device, &layoutInfo, NULL, &vk->uniformStorageLayout) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to create uniform storage layout\n");
+		return 0;
+	}
+
+	VkDescriptorPoolSize poolSize = {0};
+	poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSize.descriptorCount = NVGVK_MAX_FRAMES_IN_FLIGHT;
+
+	VkDescriptorPoolCreateInfo poolInfo = {0};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.maxSets = NVGVK_MAX_FRAMES_IN_FLIGHT;
+	poolInfo.poolSizeCount = 1;
+	poolInfo.pPoolSizes = &poolSize;
+
+	if (vkCreateDescriptorPool(vk->device, &poolInfo, NULL, &vk->uniformStoragePool) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to create uniform storage descriptor pool\n");
+		nvgvk_uniform_storage_destroy(vk);
+		return 0;
+	}
+
+	return 1;
+}
+
+void nvgvk_uniform_storage_destroy(NVGVkContext* vk)
+{
+	if (vk->uniformStoragePool) {
+		vkDestroyDescriptorPool(vk->device, vk->uniformStoragePool, NULL);
+		vk->uniformStoragePool = VK_NULL_HANDLE;
+	}
+	if (vk->uniformStorageLayout) {
+		vkDestroyDescriptorSetLayout(vk->device, vk->uniformStorageLayout, NULL);
+		vk->uniformStorageLayout = VK_NULL_HANDLE;
+	}
+}
+
+int nvgvk_frame_upload_uniforms(NVGVkContext* vk, NVGVkFrame* frame)
+{
+	VkDeviceSize size = sizeof(NVGVkFragUniforms) * (VkDeviceSize)vk->uniformCount;
+
+	// Nothing to keep: the slot's previous contents were consumed frameCount frames ago
+	nvgvk_buffer_reset(&frame->uniformStorage);
+	if (!nvgvk_buffer_reserve(vk, &frame->uniformStorage, size)) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to grow frame uniform storage\n");
+		return 0;
+	}
+
+	// NVGVkUniforms keeps viewSize in front of the fragment uniforms
+	NVGVkFragUniforms* dst = (NVGVkFragUniforms*)frame->uniformStorage.mapped;
+	for (int i = 0; i < vk->uniformCount; i++) {
+		memcpy(&dst[i], vk->uniforms[i].scissorMat, sizeof(NVGVkFragUniforms));
+	}
+	frame->uniformStorage.size = size;
+
+	// Point the frame's set at the buffer again after it was reallocated
+	if (frame->uniformStorageBound != frame->uniformStorage.buffer) {
+		VkDescriptorBufferInfo bufferInfo = {0};
+		bufferInfo.buffer = frame->uniformStorage.buffer;
+		bufferInfo.offset = 0;
+		bufferInfo.range = VK_WHOLE_SIZE;
+
+		VkWriteDescriptorSet write = {0};
+		write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet = frame->uniformStorageSet;
+		write.dstBinding = 0;
+		write.descriptorCount = 1;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		write.pBufferInfo = &bufferInfo;
+
+		vkUpdateDescriptorSets(vk->device, 1, &write, 0, NULL);
+		frame->uniformStorageBound = frame->uniformStorage.buffer;
+	}
+
+	return 1;
+}
+
+// Helper: Submit a fence-only batch. It signals once everything submitted to
+// the queue before it (the frame's uploads and command buffer) has completed.
+static void nvgvk__seal_frame(NVGVkContext* vk, NVGVkFrame* frame)
+{
+	if (vkQueueSubmit(vk->queue, 0, NULL, frame->fence) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to submit frame fence\n");
+		vkQueueWaitIdle(vk->queue);
+		frame->pending = 0;
+		vk->completedSerial = frame->serial;
+		return;
+	}
+	frame->pending = 0;
+	frame->submitted = 1;
+}
+
+void nvgvk_frame_begin(NVGVkContext* vk)
+{
+	if (!vk || vk->frameCount == 0) {
+		return;
+	}
+
+	// The application submits the frame command buffer between nvgEndFrame and
+	// the next nvgBeginFrame, so the previous frame can be fenced now
+	for (int i = 0; i < vk->frameCount; i++) {
+		if (vk->frames[i].pending) {
+			nvgvk__seal_frame(vk, &vk->frames[i]);
+		}
+	}
+
+	nvgvk_frame_acquire(vk);
+}
+
+NVGVkFrame* nvgvk_frame_acquire(NVGVkContext* vk)
+{
+	NVGVkFrame* frame = &vk->frames[vk->frameIndex];
+
+	// Only reachable with a single frame in flight (or without nvgBeginFrame)
+	if (frame->pending) {
+		nvgvk__seal_frame(vk, frame);
+	}
+
+	if (frame->submitted) {
+		// Used frameCount frames ago, normally already signaled
+		vkWaitForFences(vk->device, 1, &frame->fence, VK_TRUE, UINT64_MAX);
+		vkResetFences(vk->device, 1, &frame->fence);
+		if (frame->serial > vk->completedSerial) {
+			// Fences signal in submission order, so every earlier frame is done too
+			vk->completedSerial = frame->serial;
+		}
+		nvgvk_buffer_reset(&frame->stagingBuffer);
+		nvgvk_buffer_reset(&frame->indirectBuffer);
+		nvgvk_buffer_reset(&frame->glyphBuffer);
+		nvgvk_vertex_chunks_reset(frame);
+		frame->uploadsSubmitted = 0;
+		frame->submitted = 0;
+		nvgvk_collect_garbage(vk, 0);
+	}
+
+	return frame;
+}
+
+void nvgvk_frame_end(NVGVkContext* vk)
+{
+	if (!vk || vk->frameCount == 0) {
+		return;
+	}
+
+	vk->frames[vk->frameIndex].pending = 1;
+	vk->frames[vk->frameIndex].serial = vk->frameSerial++;
+	vk->frameIndex = (vk->frameIndex + 1) % vk->frameCount;
+}
+
+static void nvgvk__destroy_garbage(NVGVkContext* vk, NVGVkGarbage* item)
+{
+	if (item->descriptorSet && vk->textureDescriptorPool) {
+		vkFreeDescriptorSets(vk->device, vk->textureDescriptorPool, 1, &item->descriptorSet);
+	}
+	if (item->sampler) {
+		vkDestroySampler(vk->device, item->sampler, NULL);
+	}
+	if (item->imageView) {
+		vkDestroyImageView(vk->device, item->imageView, NULL);
+	}
+	if (item->image) {
+		vkDestroyImage(vk->device, item->image, NULL);
+	}
+	if (item->buffer) {
+		vkDestroyBuffer(vk->device, item->buffer, NULL);
+	}
+	nvgvk_memory_free(vk, &item->allocation);
+}
+
+// Helper: Queue item behind the frame being recorded
+static void nvgvk__defer(NVGVkContext* vk, NVGVkGarbage* item)
+{
+	item->serial = vk->frameSerial;
+
+	if (vk->garbageCount + 1 > vk->garbageCapacity) {
+		int capacity = vk->garbageCapacity > 0 ? vk->garbageCapacity * 2 : 16;
+		NVGVkGarbage* garbage = (NVGVkGarbage*)realloc(vk->garbage, sizeof(NVGVkGarbage) * capacity);
+		if (!garbage) {
+			// Out of memory: fall back to destroying the resource right away
+			fprintf(stderr, "NanoVG Vulkan: Failed to grow destruction queue, waiting for device\n");
+			vkDeviceWaitIdle(vk->device);
+			nvgvk__destroy_garbage(vk, item);
+			return;
+		}
+		vk->garbage = garbage;
+		vk->garbageCapacity = capacity;
+	}
+
+	vk->garbage[vk->garbageCount++] = *item;
+}
+
+void nvgvk_release_texture(NVGVkContext* vk, NVGVkTexture* tex)
+{
+	NVGVkGarbage item = {0};
+	item.image = tex->image;
+	item.imageView = tex->imageView;
+	item.sampler = tex->sampler;
+	item.descriptorSet = tex->descriptorSet;
+	item.allocation = tex->allocation;
+	nvgvk__defer(vk, &item);
+
+	memset(tex, 0, sizeof(NVGVkTexture));
+}
+
+void nvgvk_release_buffer(NVGVkContext* vk, NVGVkBuffer* buffer)
+{
+	NVGVkGarbage item = {0};
+	item.buffer = buffer->buffer;
+	item.allocation = buffer->allocation;
+	nvgvk__defer(vk, &item);
+
+	memset(buffer, 0, sizeof(NVGVkBuffer));
+}
+
+void nvgvk_collect_garbage(NVGVkContext* vk, int all)
+{
+	// Queued in serial order, so completed items form a prefix
+	int count = 0;
+	while (count < vk->garbageCount && (all || vk->garbage[count].serial <= vk->completedSerial)) {
+		nvgvk__destroy_garbage(vk, &vk->garbage[count]);
+		count++;
+	}
+
+	if (count > 0) {
+		memmove(vk->garbage, vk->garbage + count, sizeof(NVGVkGarbage) * (vk->garbageCount - count));
+		vk->garbageCount -= count;
+	}
+
+	if (all) {
+		free(vk->garbage);
+		vk->garbage = NULL;
+		vk->garbageCount = 0;
+		vk->garbageCapacity = 0;
+	}
+}
@@ -0,0 +1,41 @@
+#ifndef NVG_VK_FRAME_H
+#define NVG_VK_FRAME_H
+
+#include "nvg_vk_types.h"
+
+// Frame ring lifecycle. count is clamped to [1, NVGVK_MAX_FRAMES_IN_FLIGHT].
+int nvgvk_frames_init(NVGVkContext* vk, int count);
+void nvgvk_frames_destroy(NVGVkContext* vk);
+
+// Fragment uniform storage. Every call's NVGVkFragUniforms is copied into the
+// frame's storage buffer, bound as set 2 and indexed per vertex, instead of
+// being pushed as constants before each draw. The layout and pool outlive the
+// frame ring (init before nvgvk_frames_init, destroy after nvgvk_frames_destroy).
+int nvgvk_uniform_storage_init(NVGVkContext* vk);
+void nvgvk_uniform_storage_destroy(NVGVkContext* vk);
+
+// Copy the uniforms recorded this frame into frame->uniformStorage
+int nvgvk_frame_upload_uniforms(NVGVkContext* vk, NVGVkFrame* frame);
+
+// Called at nvgBeginFrame: fences the previously flushed frame (its command
+// buffer has been submitted by now) and acquires the current ring slot.
+void nvgvk_frame_begin(NVGVkContext* vk);
+
+// Returns the current ring slot, waiting on its fence if it is still in flight
+NVGVkFrame* nvgvk_frame_acquire(NVGVkContext* vk);
+
+// Called at the end of nvgvk_flush: retires the current slot and advances the ring
+void nvgvk_frame_end(NVGVkContext* vk);
+
+// Deferred destruction. Released resources are tagged with the serial of the
+// frame being recorded and destroyed once that frame's fence has been waited
+// on, so deleting a texture never drains the device. The handles are moved
+// out and the struct is zeroed, so its slot can be reused immediately.
+void nvgvk_release_texture(NVGVkContext* vk, NVGVkTexture* tex);
+void nvgvk_release_buffer(NVGVkContext* vk, NVGVkBuffer* buffer);
+
+// Destroy released resources whose frames have completed, or everything when
+// all is set (the device must be idle). Frees the queue itself when all is set.
+void nvgvk_collect_garbage(NVGVkContext* vk, int all);
+
+#endif // NVG_VK_FRAME_H
@@ -0,0 +1,364 @@
+#include "nvg_vk_memory.h"
+#include "../nvg_vk.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Buddy tree layout: node 0 covers the whole block, node n has children 2n+1
+// and 2n+2, and leaves are NVGVK_MEMORY_MIN_ORDER ranges. Each node stores
+// 1 + log2 of the largest free range in its subtree (0 = nothing free).
+#define NVGVK_MEMORY_BLOCK_SIZE ((VkDeviceSize)1 << NVGVK_MEMORY_BLOCK_ORDER)
+#define NVGVK_MEMORY_TREE_NODES ((1 << (NVGVK_MEMORY_BLOCK_ORDER - NVGVK_MEMORY_MIN_ORDER + 1)) - 1)
+
+// Helper: Find a memory type allowed by typeFilter with all requested properties
+static uint32_t nvgvk__find_memory_type(NVGVkContext* vk, uint32_t typeFilter,
+                                        VkMemoryPropertyFlags properties)
+{
+	const VkPhysicalDeviceMemoryProperties* memProperties = &vk->memory.properties;
+
+	for (uint32_t i = 0; i < memProperties->memoryTypeCount; i++) {
+		if ((typeFilter & (1 << i)) &&
+		    (memProperties->memoryTypes[i].propertyFlags & properties) == properties) {
+			return i;
+		}
+	}
+
+	fprintf(stderr, "NanoVG Vulkan: Failed to find suitable memory type\n");
+	return UINT32_MAX;
+}
+
+static int nvgvk__host_visible(NVGVkContext* vk, uint32_t memoryType)
+{
+	return (vk->memory.properties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+}
+
+// Helper: Smallest buddy order holding size bytes
+static int nvgvk__buddy_order(VkDeviceSize size)
+{
+	int order = NVGVK_MEMORY_MIN_ORDER;
+	while (((VkDeviceSize)1 << order) < size) {
+		order++;
+	}
+	return order;
+}
+
+// Helper: Recompute the ancestors of node (of the given order) after it changed
+static void nvgvk__buddy_update(unsigned char* tree, int node, int order)
+{
+	while (node > 0) {
+		node = (node - 1) / 2;
+		order++;
+
+		unsigned char left = tree[2 * node + 1];
+		unsigned char right = tree[2 * node + 2];
+		if (left == order && right == order) {
+			// Both halves free: merge back into one range
+			tree[node] = (unsigned char)(order + 1);
+		} else {
+			tree[node] = left > right ? left : right;
+		}
+	}
+}
+
+static void nvgvk__buddy_init(unsigned char* tree)
+{
+	int node = 0;
+	for (int order = NVGVK_MEMORY_BLOCK_ORDER; order >= NVGVK_MEMORY_MIN_ORDER; order--) {
+		int count = 1 << (NVGVK_MEMORY_BLOCK_ORDER - order);
+		memset(tree + node, order + 1, (size_t)count);
+		node += count;
+	}
+}
+
+// Helper: Take a free range of the given order, returns its offset
+static VkDeviceSize nvgvk__buddy_alloc(unsigned char* tree, int order)
+{
+	int node = 0;
+	int nodeOrder = NVGVK_MEMORY_BLOCK_ORDER;
+
+	while (nodeOrder > order) {
+		// Prefer the left child so allocations pack towards the block start
+		node = tree[2 * node + 1] > order ? 2 * node + 1 : 2 * node + 2;
+		nodeOrder--;
+	}
+
+	tree[node] = 0;
+	nvgvk__buddy_update(tree, node, order);
+
+	int first = (1 << (NVGVK_MEMORY_BLOCK_ORDER - order)) - 1;
+	return (VkDeviceSize)(node - first) << order;
+}
+
+static void nvgvk__buddy_free(unsigned char* tree, VkDeviceSize offset, int order)
+{
+	int first = (1 << (NVGVK_MEMORY_BLOCK_ORDER - order)) - 1;
+	int node = first + (int)(offset >> order);
+
+	tree[node] = (unsigned char)(order + 1);
+	nvgvk__buddy_update(tree, node, order);
+}
+
+// Helper: Linear resources only need their own blocks when bufferImageGranularity
+// is coarser than the smallest buddy range
+static int nvgvk__block_kind(NVGVkContext* vk, int linear)
+{
+	if (vk->memory.bufferImageGranularity <= ((VkDeviceSize)1 << NVGVK_MEMORY_MIN_ORDER)) {
+		return 0;
+	}
+	return linear ? 1 : 0;
+}
+
+static void nvgvk__free_block(NVGVkContext* vk, NVGVkMemoryBlock* block)
+{
+	if (block->mapped) {
+		vkUnmapMemory(vk->device, block->memory);
+	}
+	if (block->memory) {
+		vkFreeMemory(vk->device, block->memory, NULL);
+	}
+	free(block->tree);
+	memset(block, 0, sizeof(NVGVkMemoryBlock));
+	vk->memory.blockCount--;
+}
+
+// Helper: Allocate a new block, returns its index or -1
+static int nvgvk__add_block(NVGVkContext* vk, uint32_t memoryType, int kind)
+{
+	NVGVkMemory* mem = &vk->memory;
+
+	// Reuse a released slot so allocation block indices stay stable
+	int index = -1;
+	for (int i = 0; i < mem->blockCapacity; i++) {
+		if (!mem->blocks[i].memory) {
+			index = i;
+			break;
+		}
+	}
+
+	if (index < 0) {
+		int capacity = mem->blockCapacity > 0 ? mem->blockCapacity * 2 : 4;
+		NVGVkMemoryBlock* blocks = (NVGVkMemoryBlock*)realloc(mem->blocks, sizeof(NVGVkMemoryBlock) * capacity);
+		if (!blocks) {
+			fprintf(stderr, "NanoVG Vulkan: Failed to grow memory block list\n");
+			return -1;
+		}
+		memset(blocks + mem->blockCapacity, 0, sizeof(NVGVkMemoryBlock) * (capacity - mem->blockCapacity));
+		index = mem->blockCapacity;
+		mem->blocks = blocks;
+		mem->blockCapacity = capacity;
+	}
+
+	NVGVkMemoryBlock* block = &mem->blocks[index];
+	block->tree = (unsigned char*)malloc(NVGVK_MEMORY_TREE_NODES);
+	if (!block->tree) {
+		return -1;
+	}
+	nvgvk__buddy_init(block->tree);
+
+	VkMemoryAllocateInfo allocInfo = {0};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = NVGVK_MEMORY_BLOCK_SIZE;
+	allocInfo.memoryTypeIndex = memoryType;
+
+	if (vkAllocateMemory(vk->device, &allocInfo, NULL, &block->memory) != VK_SUCCESS) {
+		free(block->tree);
+		memset(block, 0, sizeof(NVGVkMemoryBlock));
+		return -1;
+	}
+	mem->blockCount++;
+
+	if (nvgvk__host_visible(vk, memoryType) &&
+	    vkMapMemory(vk->device, block->memory, 0, VK_WHOLE_SIZE, 0, &block->mapped) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to map memory block\n");
+		block->mapped = NULL;
+		nvgvk__free_block(vk, block);
+		return -1;
+	}
+
+	block->memoryType = memoryType;
+	block->linear = kind;
+	return index;
+}
+
+static int nvgvk__alloc_dedicated(NVGVkContext* vk, VkDeviceSize size, uint32_t memoryType,
+                                  NVGVkAllocation* alloc)
+{
+	VkMemoryAllocateInfo allocInfo = {0};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = size;
+	allocInfo.memoryTypeIndex = memoryType;
+
+	if (vkAllocateMemory(vk->device, &allocInfo, NULL, &alloc->memory) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to allocate device memory\n");
+		alloc->memory = VK_NULL_HANDLE;
+		return 0;
+	}
+
+	if (nvgvk__host_visible(vk, memoryType) &&
+	    vkMapMemory(vk->device, alloc->memory, 0, VK_WHOLE_SIZE, 0, &alloc->mapped) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to map device memory\n");
+		vkFreeMemory(vk->device, alloc->memory, NULL);
+		memset(alloc, 0, sizeof(NVGVkAllocation));
+		return 0;
+	}
+
+	alloc->offset = 0;
+	alloc->size = size;
+	alloc->block = -1;
+	vk->memory.dedicatedCount++;
+	vk->memory.dedicatedBytes += size;
+	return 1;
+}
+
+static void nvgvk__suballoc(NVGVkContext* vk, int index, int order, NVGVkAllocation* alloc)
+{
+	NVGVkMemoryBlock* block = &vk->memory.blocks[index];
+
+	alloc->memory = block->memory;
+	alloc->offset = nvgvk__buddy_alloc(block->tree, order);
+	alloc->size = (VkDeviceSize)1 << order;
+	alloc->mapped = block->mapped ? (unsigned char*)block->mapped + alloc->offset : NULL;
+	alloc->block = index;
+
+	block->used += alloc->size;
+	block->allocationCount++;
+	vk->memory.allocationCount++;
+}
+
+void nvgvk_memory_init(NVGVkContext* vk)
+{
+	NVGVkMemory* mem = &vk->memory;
+	memset(mem, 0, sizeof(NVGVkMemory));
+
+	vkGetPhysicalDeviceMemoryProperties(vk->physicalDevice, &mem->properties);
+
+	VkPhysicalDeviceProperties deviceProperties;
+	vkGetPhysicalDeviceProperties(vk->physicalDevice, &deviceProperties);
+	mem->bufferImageGranularity = deviceProperties.limits.bufferImageGranularity;
+}
+
+void nvgvk_memory_destroy(NVGVkContext* vk)
+{
+	NVGVkMemory* mem = &vk->memory;
+
+	if (mem->allocationCount > 0 || mem->dedicatedCount > 0) {
+		fprintf(stderr, "NanoVG Vulkan: %d device memory allocations leaked\n",
+		        mem->allocationCount + mem->dedicatedCount);
+	}
+
+	for (int i = 0; i < mem->blockCapacity; i++) {
+		if (mem->blocks[i].memory) {
+			nvgvk__free_block(vk, &mem->blocks[i]);
+		}
+	}
+	free(mem->blocks);
+	mem->blocks = NULL;
+	mem->blockCount = 0;
+	mem->blockCapacity = 0;
+}
+
+int nvgvk_memory_alloc(NVGVkContext* vk, const VkMemoryRequirements* req,
+                       VkMemoryPropertyFlags properties, int linear,
+                       NVGVkAllocation* alloc)
+{
+	memset(alloc, 0, sizeof(NVGVkAllocation));
+	alloc->block = -1;
+
+	uint32_t memoryType = nvgvk__find_memory_type(vk, req->memoryTypeBits, properties);
+	if (memoryType == UINT32_MAX) {
+		return 0;
+	}
+
+	// Buddy ranges are aligned to their size, so rounding up covers the alignment
+	VkDeviceSize size = req->size > req->alignment ? req->size : req->alignment;
+	if (size <= NVGVK_MEMORY_DEDICATED_SIZE) {
+		NVGVkMemory* mem = &vk->memory;
+		int order = nvgvk__buddy_order(size);
+		int kind = nvgvk__block_kind(vk, linear);
+
+		for (int i = 0; i < mem->blockCapacity; i++) {
+			NVGVkMemoryBlock* block = &mem->blocks[i];
+			if (block->memory && block->memoryType == memoryType && block->linear == kind &&
+			    block->tree[0] > order) {
+				nvgvk__suballoc(vk, i, order, alloc);
+				return 1;
+			}
+		}
+
+		int index = nvgvk__add_block(vk, memoryType, kind);
+		if (index >= 0) {
+			nvgvk__suballoc(vk, index, order, alloc);
+			return 1;
+		}
+		// No room for another block: try an exact-size allocation instead
+	}
+
+	return nvgvk__alloc_dedicated(vk, req->size, memoryType, alloc);
+}
+
+void nvgvk_memory_free(NVGVkContext* vk, NVGVkAllocation* alloc)
+{
+	if (!vk || !alloc || !alloc->memory) {
+		return;
+	}
+
+	NVGVkMemory* mem = &vk->memory;
+
+	if (alloc->block < 0) {
+		if (alloc->mapped) {
+			vkUnmapMemory(vk->device, alloc->memory);
+		}
+		vkFreeMemory(vk->device, alloc->memory, NULL);
+		mem->dedicatedCount--;
+		mem->dedicatedBytes -= alloc->size;
+		memset(alloc, 0, sizeof(NVGVkAllocation));
+		return;
+	}
+
+	NVGVkMemoryBlock* block = &mem->blocks[alloc->block];
+	nvgvk__buddy_free(block->tree, alloc->offset, nvgvk__buddy_order(alloc->size));
+	block->used -= alloc->size;
+	block->allocationCount--;
+	mem->allocationCount--;
+
+	// Keep one empty block per memory type and kind to absorb create/destroy churn
+	if (block->allocationCount == 0) {
+		for (int i = 0; i < mem->blockCapacity; i++) {
+			NVGVkMemoryBlock* other = &mem->blocks[i];
+			if (other != block && other->memory && other->allocationCount == 0 &&
+			    other->memoryType == block->memoryType && other->linear == block->linear) {
+				nvgvk__free_block(vk, block);
+				break;
+			}
+		}
+	}
+
+	memset(alloc, 0, sizeof(NVGVkAllocation));
+}
+
+void nvgvk_memory_stats(NVGVkContext* vk, NVGVkMemoryStats* stats)
+{
+	NVGVkMemory* mem = &vk->memory;
+	memset(stats, 0, sizeof(NVGVkMemoryStats));
+
+	uint64_t freeBytes = 0;
+	for (int i = 0; i < mem->blockCapacity; i++) {
+		NVGVkMemoryBlock* block = &mem->blocks[i];
+		if (!block->memory) {
+			continue;
+		}
+		uint64_t largest = block->tree[0] > 0 ? (uint64_t)1 << (block->tree[0] - 1) : 0;
+		if (largest > stats->largestFreeBytes) {
+			stats->largestFreeBytes = largest;
+		}
+		stats->blockBytes += NVGVK_MEMORY_BLOCK_SIZE;
+		stats->usedBytes += block->used;
+		freeBytes += NVGVK_MEMORY_BLOCK_SIZE - block->used;
+	}
+
+	stats->blockCount = mem->blockCount;
+	stats->allocationCount = mem->allocationCount;
+	stats->dedicatedCount = mem->dedicatedCount;
+	stats->dedicatedBytes = mem->dedicatedBytes;
+	stats->fragmentation = freeBytes > 0 ? 1.0f - (float)((double)stats->largestFreeBytes / (double)freeBytes) : 0.0f;
+}
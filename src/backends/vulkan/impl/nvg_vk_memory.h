@@ -0,0 +1,32 @@
+#ifndef NVG_VK_MEMORY_H
+#define NVG_VK_MEMORY_H
+
+#include "nvg_vk_types.h"
+
+// Device memory sub-allocator. Buffers and images are placed in large
+// VkDeviceMemory blocks (one set per memory type) that are split with a buddy
+// policy, so creating a texture or growing a buffer does not cost a
+// vkAllocateMemory call. Ranges are aligned to their own power-of-two size, and
+// linear and optimal resources only share a block when bufferImageGranularity
+// is no larger than the smallest range. Host-visible blocks stay mapped.
+
+typedef struct NVGVkMemoryStats NVGVkMemoryStats;  // See nvg_vk.h
+
+// Query memory properties; call before the first allocation
+void nvgvk_memory_init(NVGVkContext* vk);
+
+// Free every block (all allocations must have been released)
+void nvgvk_memory_destroy(NVGVkContext* vk);
+
+// Allocate memory for req from a memory type with the given properties.
+// linear is 1 for buffers, 0 for optimal-tiling images. Returns 0 on failure.
+int nvgvk_memory_alloc(NVGVkContext* vk, const VkMemoryRequirements* req,
+                       VkMemoryPropertyFlags properties, int linear,
+                       NVGVkAllocation* alloc);
+
+// Return a range to its block (no-op for a zeroed allocation)
+void nvgvk_memory_free(NVGVkContext* vk, NVGVkAllocation* alloc);
+
+void nvgvk_memory_stats(NVGVkContext* vk, NVGVkMemoryStats* stats);
+
+#endif // NVG_VK_MEMORY_H
@@ -1,7 +1,10 @@
 #include "nvg_vk_pipeline.h"
 #include "nvg_vk_shader.h"
+#include "nvg_vk_render.h"
 #include "../nanovg.h"
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 // Helper: Create descriptor set layout for textures and uniforms
@@ -9,9 +12,9 @@ static int nvgvk__create_descriptor_layout(NVGVkContext* vk, NVGVkPipeline* pipe
 {
 	VkDescriptorSetLayoutBinding bindings[2] = {0};
 
-	// Binding 0: Uniform buffer (viewSize)
+	// Binding 0: Uniform buffer (viewSize, dynamic offset selects the frame slot)
 	bindings[0].binding = 0;
-	bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 	bindings[0].descriptorCount = 1;
 	bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
@@ -34,27 +37,22 @@ static int nvgvk__create_descriptor_layout(NVGVkContext* vk, NVGVkPipeline* pipe
 	return 1;
 }
 
-// Helper: Create pipeline layout with push constants
+// Helper: Create pipeline layout
 static int nvgvk__create_pipeline_layout(NVGVkContext* vk, NVGVkPipeline* pipeline)
 {
-	// Push constant range for fragment uniforms (accessible from both stages)
-	VkPushConstantRange pushConstant = {0};
-	pushConstant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-	pushConstant.offset = 0;
-	pushConstant.size = sizeof(NVGVkFragUniforms);
-
-	// Descriptor sets: [0] = textures/uniforms, [1] = color space UBO
-	VkDescriptorSetLayout setLayouts[2] = {
+	// Descriptor sets: [0] = textures/uniforms, [1] = color space UBO, [2] = fragment uniforms,
+	// [3] = bindless texture table (only with vk->bindless)
+	VkDescriptorSetLayout setLayouts[4] = {
 		pipeline->descriptorSetLayout,
-		vk->colorSpaceDescriptorLayout
+		vk->colorSpaceDescriptorLayout,
+		vk->uniformStorageLayout,
+		vk->textureTableLayout
 	};
 
 	VkPipelineLayoutCreateInfo layoutInfo = {0};
 	layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-	layoutInfo.setLayoutCount = 2;
+	layoutInfo.setLayoutCount = vk->bindless ? 4 : 3;
 	layoutInfo.pSetLayouts = setLayouts;
-	layoutInfo.pushConstantRangeCount = 1;
-	layoutInfo.pPushConstantRanges = &pushConstant;
 
 	if (vkCreatePipelineLayout(vk->device, &layoutInfo, NULL, &pipeline->layout) != VK_SUCCESS) {
 		fprintf(stderr, "NanoVG Vulkan: Failed to create pipeline layout\n");
@@ -71,18 +69,50 @@ typedef enum {
 	STENCIL_TEST_NONZERO        // Test stencil !=0 (for cover pass, color enabled)
 } StencilMode;
 
+// Helper: Instanced text pipelines (glyph instance stream, 4 vertex strips)
+static int nvgvk__is_glyph_pipeline(int type)
+{
+	return type >= NVGVK_PIPELINE_GLYPHS_ALPHA && type <= NVGVK_PIPELINE_GLYPHS_IMG;
+}
+
+// Helper: Stencil mode and topology of a pipeline type
+static void nvgvk__pipeline_state(int type, StencilMode* stencilMode, VkPrimitiveTopology* topology)
+{
+	*stencilMode = STENCIL_NONE;
+	*topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+	if (type == NVGVK_PIPELINE_FILL_STENCIL) {
+		*stencilMode = STENCIL_WRITE;
+		*topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;  // Modified NanoVG generates triangle lists
+	} else if (type == NVGVK_PIPELINE_FILL_COVER_GRAD || type == NVGVK_PIPELINE_FILL_COVER_IMG) {
+		*stencilMode = STENCIL_TEST_NONZERO;
+		*topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;  // Bounding quad uses triangle list
+	} else if (type == NVGVK_PIPELINE_IMG_STENCIL) {
+		*stencilMode = STENCIL_TEST_NONZERO;
+	} else if (type == NVGVK_PIPELINE_FRINGE) {
+		*stencilMode = STENCIL_NONE;
+		*topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;  // Fringe uses triangle strip
+	} else if (nvgvk__is_glyph_pipeline(type)) {
+		*topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;  // One 4 vertex strip per glyph instance
+	}
+}
+
 // Helper: Create graphics pipeline
-static int nvgvk__create_graphics_pipeline(NVGVkContext* vk, NVGVkPipeline* pipeline,
+static int nvgvk__create_graphics_pipeline(NVGVkContext* vk, NVGVkPipeline* pipeline, VkPipeline* out,
                                             VkRenderPass renderPass, NVGVkShaderSet* shaders,
-                                            StencilMode stencilMode, VkPrimitiveTopology topology)
+                                            StencilMode stencilMode, VkPrimitiveTopology topology,
+                                            const NVGVkBlend* blend, int instanced)
 {
-	// Vertex input state
-	VkVertexInputBindingDescription binding = {0};
-	binding.binding = 0;
-	binding.stride = sizeof(NVGvertex);
-	binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+	// Vertex input state: vertices, and the uniform index stream behind them in the chunk
+	VkVertexInputBindingDescription bindings[2] = {0};
+	bindings[0].binding = 0;
+	bindings[0].stride = sizeof(NVGvertex);
+	bindings[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+	bindings[1].binding = 1;
+	bindings[1].stride = sizeof(uint32_t);
+	bindings[1].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-	VkVertexInputAttributeDescription attrs[2] = {0};
+	VkVertexInputAttributeDescription attrs[3] = {0};
 	// Position
 	attrs[0].location = 0;
 	attrs[0].binding = 0;
@@ -93,14 +123,44 @@ static int nvgvk__create_graphics_pipeline(NVGVkContext* vk, NVGVkPipeline* pipe
 	attrs[1].binding = 0;
 	attrs[1].format = VK_FORMAT_R32G32_SFLOAT;
 	attrs[1].offset = sizeof(float) * 2;
+	// Uniform index
+	attrs[2].location = 2;
+	attrs[2].binding = 1;
+	attrs[2].format = VK_FORMAT_R32_UINT;
+	attrs[2].offset = 0;
 
 	VkPipelineVertexInputStateCreateInfo vertexInputInfo = {0};
 	vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-	vertexInputInfo.vertexBindingDescriptionCount = 1;
-	vertexInputInfo.pVertexBindingDescriptions = &binding;
-	vertexInputInfo.vertexAttributeDescriptionCount = 2;
+	vertexInputInfo.vertexBindingDescriptionCount = 2;
+	vertexInputInfo.pVertexBindingDescriptions = bindings;
+	vertexInputInfo.vertexAttributeDescriptionCount = 3;
 	vertexInputInfo.pVertexAttributeDescriptions = attrs;
 
+	// Instanced text: one NVGVkGlyph per instance, the quad corner comes from gl_VertexIndex
+	VkVertexInputBindingDescription glyphBinding = {0};
+	VkVertexInputAttributeDescription glyphAttrs[3] = {0};
+	if (instanced) {
+		glyphBinding.binding = 0;
+		glyphBinding.stride = sizeof(NVGVkGlyph);
+		glyphBinding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+		// Rect (x, y, w, h)
+		glyphAttrs[0].location = 0;
+		glyphAttrs[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+		glyphAttrs[0].offset = offsetof(NVGVkGlyph, x);
+		// UV rect (s0, t0, s1, t1)
+		glyphAttrs[1].location = 1;
+		glyphAttrs[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+		glyphAttrs[1].offset = offsetof(NVGVkGlyph, s0);
+		// Uniform index of the text run
+		glyphAttrs[2].location = 2;
+		glyphAttrs[2].format = VK_FORMAT_R32_UINT;
+		glyphAttrs[2].offset = offsetof(NVGVkGlyph, uniformIndex);
+
+		vertexInputInfo.vertexBindingDescriptionCount = 1;
+		vertexInputInfo.pVertexBindingDescriptions = &glyphBinding;
+		vertexInputInfo.pVertexAttributeDescriptions = glyphAttrs;
+	}
+
 	// Input assembly
 	VkPipelineInputAssemblyStateCreateInfo inputAssembly = {0};
 	inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
@@ -156,11 +216,11 @@ static int nvgvk__create_graphics_pipeline(NVGVkContext* vk, NVGVkPipeline* pipe
 	// Color blend
 	VkPipelineColorBlendAttachmentState colorBlendAttachment = {0};
 	colorBlendAttachment.blendEnable = VK_TRUE;
-	colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-	colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+	colorBlendAttachment.srcColorBlendFactor = blend->srcColor;
+	colorBlendAttachment.dstColorBlendFactor = blend->dstColor;
 	colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
-	colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-	colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+	colorBlendAttachment.srcAlphaBlendFactor = blend->srcAlpha;
+	colorBlendAttachment.dstAlphaBlendFactor = blend->dstAlpha;
 	colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
 
 	// Disable color writes for stencil write pass
@@ -218,7 +278,7 @@ static int nvgvk__create_graphics_pipeline(NVGVkContext* vk, NVGVkPipeline* pipe
 	pipelineInfo.renderPass = renderPass;
 	pipelineInfo.subpass = 0;
 
-	if (vkCreateGraphicsPipelines(vk->device, VK_NULL_HANDLE, 1, &pipelineInfo, NULL, &pipeline->pipeline) != VK_SUCCESS) {
+	if (vkCreateGraphicsPipelines(vk->device, vk->pipelineCache, 1, &pipelineInfo, NULL, out) != VK_SUCCESS) {
 		fprintf(stderr, "NanoVG Vulkan: Failed to create graphics pipeline\n");
 		return 0;
 	}
@@ -237,18 +297,25 @@ int nvgvk_create_pipelines(NVGVkContext* vk, VkRenderPass renderPass)
 		return 0;
 	}
 
+	// Without seed data the cache still collects this run's pipelines for saving
+	if (!vk->pipelineCache) {
+		nvgvk_pipeline_cache_load(vk, NULL, 0);
+	}
+
 	// Create descriptor pool
 	// Need space for: NVGVK_PIPELINE_COUNT pipeline descriptor sets + 1 color space UBO descriptor set
-	VkDescriptorPoolSize poolSizes[2] = {0};
-	poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-	poolSizes[0].descriptorCount = NVGVK_PIPELINE_COUNT + 1;  // +1 for color space UBO
+	VkDescriptorPoolSize poolSizes[3] = {0};
+	poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	poolSizes[0].descriptorCount = NVGVK_PIPELINE_COUNT;
 	poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 	poolSizes[1].descriptorCount = NVGVK_PIPELINE_COUNT;
+	poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	poolSizes[2].descriptorCount = 1;  // color space UBO
 
 	VkDescriptorPoolCreateInfo poolInfo = {0};
 	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 	poolInfo.maxSets = NVGVK_PIPELINE_COUNT + 1;  // +1 for color space UBO descriptor set
-	poolInfo.poolSizeCount = 2;
+	poolInfo.poolSizeCount = 3;
 	poolInfo.pPoolSizes = poolSizes;
 
 	if (vkCreateDescriptorPool(vk->device, &poolInfo, NULL, &vk->pipelines[0].descriptorPool) != VK_SUCCESS) {
@@ -256,8 +323,9 @@ int nvgvk_create_pipelines(NVGVkContext* vk, VkRenderPass renderPass)
 		nvgvk_destroy_shaders(vk);
 		return 0;
 	}
+	vk->renderPass = renderPass;
 
-	// Create pipelines
+	// Create layouts and descriptor sets per pipeline type
 	for (int i = 0; i < NVGVK_PIPELINE_COUNT; i++) {
 		NVGVkPipeline* pipeline = &vk->pipelines[i];
 
@@ -273,27 +341,7 @@ int nvgvk_create_pipelines(NVGVkContext* vk, VkRenderPass renderPass)
 			return 0;
 		}
 
-		// Graphics pipeline - configure stencil mode and topology based on pipeline type
-		StencilMode stencilMode = STENCIL_NONE;
-		VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-
-		if (i == NVGVK_PIPELINE_FILL_STENCIL) {
-			stencilMode = STENCIL_WRITE;
-			topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;  // Modified NanoVG generates triangle lists
-		} else if (i == NVGVK_PIPELINE_FILL_COVER_GRAD || i == NVGVK_PIPELINE_FILL_COVER_IMG) {
-			stencilMode = STENCIL_TEST_NONZERO;
-			topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;  // Bounding quad uses triangle list
-		} else if (i == NVGVK_PIPELINE_IMG_STENCIL) {
-			stencilMode = STENCIL_TEST_NONZERO;
-		} else if (i == NVGVK_PIPELINE_FRINGE) {
-			stencilMode = STENCIL_NONE;
-			topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;  // Fringe uses triangle strip
-		}
-
-		if (!nvgvk__create_graphics_pipeline(vk, pipeline, renderPass, &vk->shaders[i], stencilMode, topology)) {
-			nvgvk_destroy_pipelines(vk);
-			return 0;
-		}
+		// Graphics pipelines are variants created on first use (nvgvk_bind_pipeline)
 
 		// Allocate descriptor set
 		VkDescriptorSetAllocateInfo allocInfo = {0};
@@ -320,13 +368,26 @@ void nvgvk_destroy_pipelines(NVGVkContext* vk)
 
 	vkDeviceWaitIdle(vk->device);
 
+	for (int i = 0; i < vk->pipelineVariantCount; i++) {
+		vkDestroyPipeline(vk->device, vk->pipelineVariants[i].pipeline, NULL);
+	}
+	free(vk->pipelineVariants);
+	vk->pipelineVariants = NULL;
+	vk->pipelineVariantCount = 0;
+	vk->pipelineVariantCapacity = 0;
+	memset(vk->pipelineBuckets, 0, sizeof(vk->pipelineBuckets));
+	vk->currentPipeline = VK_NULL_HANDLE;
+	vk->currentDescriptorSet = VK_NULL_HANDLE;
+
 	for (int i = 0; i < NVGVK_PIPELINE_COUNT; i++) {
 		NVGVkPipeline* pipeline = &vk->pipelines[i];
 
-		if (pipeline->pipeline) {
-			vkDestroyPipeline(vk->device, pipeline->pipeline, NULL);
-			pipeline->pipeline = VK_NULL_HANDLE;
-		}
+		// Sets are freed with the pool below
+		pipeline->descriptorSet = VK_NULL_HANDLE;
+		pipeline->writtenBuffer = VK_NULL_HANDLE;
+		pipeline->writtenImageView = VK_NULL_HANDLE;
+		pipeline->writtenSampler = VK_NULL_HANDLE;
+
 		if (pipeline->layout) {
 			vkDestroyPipelineLayout(vk->device, pipeline->layout, NULL);
 			pipeline->layout = VK_NULL_HANDLE;
@@ -345,19 +406,281 @@ void nvgvk_destroy_pipelines(NVGVkContext* vk)
 	nvgvk_destroy_shaders(vk);
 }
 
-void nvgvk_bind_pipeline(NVGVkContext* vk, NVGVkPipelineType type)
+// Helper: Hash a pipeline key (FNV-1a over its fields)
+static unsigned int nvgvk__pipeline_hash(const NVGVkPipelineKey* key)
 {
-	if (!vk || type >= NVGVK_PIPELINE_COUNT) {
-		return;
+	uint64_t words[6] = {
+		(uint64_t)key->type,
+		(uint64_t)key->blend.srcColor,
+		(uint64_t)key->blend.dstColor,
+		(uint64_t)key->blend.srcAlpha,
+		(uint64_t)key->blend.dstAlpha,
+		(uint64_t)(uintptr_t)key->renderPass
+	};
+	uint64_t h = 14695981039346656037ull;
+	for (int i = 0; i < 6; i++) {
+		h ^= words[i];
+		h *= 1099511628211ull;
+	}
+	return (unsigned int)(h ^ (h >> 32));
+}
+
+static int nvgvk__pipeline_key_equal(const NVGVkPipelineKey* a, const NVGVkPipelineKey* b)
+{
+	return a->type == b->type && a->renderPass == b->renderPass &&
+	       a->blend.srcColor == b->blend.srcColor && a->blend.dstColor == b->blend.dstColor &&
+	       a->blend.srcAlpha == b->blend.srcAlpha && a->blend.dstAlpha == b->blend.dstAlpha;
+}
+
+VkPipeline nvgvk_get_pipeline(NVGVkContext* vk, NVGVkPipelineType type, const NVGVkBlend* blend)
+{
+	static const NVGVkBlend sourceOver = {
+		VK_BLEND_FACTOR_SRC_ALPHA, VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+		VK_BLEND_FACTOR_ONE, VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA
+	};
+
+	if (!vk || type >= NVGVK_PIPELINE_COUNT || !vk->renderPass) {
+		return VK_NULL_HANDLE;
+	}
+
+	// The stencil pass writes no color, so all composite operations share one variant
+	NVGVkPipelineKey key;
+	memset(&key, 0, sizeof(key));
+	key.type = type;
+	key.blend = (blend && type != NVGVK_PIPELINE_FILL_STENCIL) ? *blend : sourceOver;
+	key.renderPass = vk->renderPass;
+
+	unsigned int bucket = nvgvk__pipeline_hash(&key) % NVGVK_PIPELINE_BUCKETS;
+	for (int i = vk->pipelineBuckets[bucket]; i != 0; i = vk->pipelineVariants[i - 1].next) {
+		NVGVkPipelineVariant* variant = &vk->pipelineVariants[i - 1];
+		if (nvgvk__pipeline_key_equal(&variant->key, &key)) {
+			return variant->pipeline;
+		}
+	}
+
+	// Miss: compile the variant (the pipeline cache makes repeats across runs cheap)
+	if (vk->pipelineVariantCount >= vk->pipelineVariantCapacity) {
+		int newCapacity = vk->pipelineVariantCapacity == 0 ? NVGVK_PIPELINE_COUNT * 2 : vk->pipelineVariantCapacity * 2;
+		NVGVkPipelineVariant* variants = (NVGVkPipelineVariant*)realloc(vk->pipelineVariants,
+		                                                               sizeof(NVGVkPipelineVariant) * newCapacity);
+		if (!variants) {
+			return VK_NULL_HANDLE;
+		}
+		vk->pipelineVariants = variants;
+		vk->pipelineVariantCapacity = newCapacity;
+	}
+
+	StencilMode stencilMode;
+	VkPrimitiveTopology topology;
+	nvgvk__pipeline_state(type, &stencilMode, &topology);
+
+	VkPipeline pipeline = VK_NULL_HANDLE;
+	if (!nvgvk__create_graphics_pipeline(vk, &vk->pipelines[type], &pipeline, key.renderPass,
+	                                     &vk->shaders[type], stencilMode, topology, &key.blend,
+	                                     nvgvk__is_glyph_pipeline(type))) {
+		return VK_NULL_HANDLE;
+	}
+
+	NVGVkPipelineVariant* variant = &vk->pipelineVariants[vk->pipelineVariantCount++];
+	variant->key = key;
+	variant->pipeline = pipeline;
+	variant->next = vk->pipelineBuckets[bucket];
+	vk->pipelineBuckets[bucket] = vk->pipelineVariantCount;
+	return pipeline;
+}
+
+NVGVkPipeline* nvgvk_bind_pipeline(NVGVkContext* vk, NVGVkPipelineType type, const NVGVkBlend* blend)
+{
+	VkPipeline pipeline = nvgvk_get_pipeline(vk, type, blend);
+	if (!pipeline) {
+		return NULL;
+	}
+
+	// Skip if already bound (avoid redundant state changes); a variant belongs to one type
+	if (vk->currentPipeline == pipeline) {
+		vk->counters.pipelineBindsSkipped++;
+		return &vk->pipelines[type];
 	}
 
-	// Skip if already bound (avoid redundant state changes)
-	if (vk->currentPipeline == type && vk->commandBuffer != VK_NULL_HANDLE) {
+	nvgvk_flush_draws(vk);
+	vk->currentPipeline = pipeline;
+	vk->currentPipelineStrip = type == NVGVK_PIPELINE_FRINGE || nvgvk__is_glyph_pipeline(type);
+	vkCmdBindPipeline(vk->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+	vk->counters.pipelineBinds++;
+
+	// Bindless: set 0 only carries viewSize, so one set serves every type and texture
+	VkDescriptorSet set = vk->bindless ? vk->pipelines[0].descriptorSet : vk->pipelines[type].descriptorSet;
+	nvgvk_bind_descriptor_set(vk, vk->pipelines[type].layout, set);
+	return &vk->pipelines[type];
+}
+
+void nvgvk_bind_descriptor_set(NVGVkContext* vk, VkPipelineLayout layout, VkDescriptorSet set)
+{
+	// All set 0 layouts are identical, so a bound set stays valid across pipelines
+	if (vk->currentDescriptorSet == set) {
+		vk->counters.descriptorBindsSkipped++;
 		return;
 	}
+	nvgvk_flush_draws(vk);
+	vk->currentDescriptorSet = set;
+	vk->counters.descriptorBinds++;
 
-	vk->currentPipeline = type;
-	vkCmdBindPipeline(vk->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vk->pipelines[type].pipeline);
+	// Binding 0 is a dynamic UBO: select the viewSize slot of the frame being recorded
+	uint32_t dynamicOffset = (uint32_t)vk->frames[vk->frameIndex].uniformOffset;
 	vkCmdBindDescriptorSets(vk->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-	                        vk->pipelines[type].layout, 0, 1, &vk->pipelines[type].descriptorSet, 0, NULL);
+	                        layout, 0, 1, &set, 1, &dynamicOffset);
+}
+
+// Helper: Check a VkPipelineCacheHeaderVersionOne against this device
+static int nvgvk__pipeline_cache_valid(NVGVkContext* vk, const void* data, size_t size)
+{
+	// headerSize, headerVersion, vendorID, deviceID, then pipelineCacheUUID
+	uint32_t header[4];
+	if (size < sizeof(header) + VK_UUID_SIZE) {
+		return 0;
+	}
+	memcpy(header, data, sizeof(header));
+
+	VkPhysicalDeviceProperties props;
+	vkGetPhysicalDeviceProperties(vk->physicalDevice, &props);
+
+	if (header[0] < sizeof(header) + VK_UUID_SIZE || header[0] > size ||
+	    header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+	    header[2] != props.vendorID || header[3] != props.deviceID ||
+	    memcmp((const unsigned char*)data + sizeof(header), props.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+		return 0;
+	}
+	return 1;
+}
+
+int nvgvk_pipeline_cache_load(NVGVkContext* vk, const void* data, size_t size)
+{
+	if (!vk) {
+		return 0;
+	}
+
+	// Pipelines already compiled: seed data would no longer help
+	if (vk->pipelineVariantCount > 0) {
+		fprintf(stderr, "NanoVG Vulkan: Pipeline cache must be loaded before the first frame\n");
+		return 0;
+	}
+
+	if (data && !nvgvk__pipeline_cache_valid(vk, data, size)) {
+		fprintf(stderr, "NanoVG Vulkan: Pipeline cache data does not match this device, ignoring\n");
+		data = NULL;
+		size = 0;
+	}
+
+	VkPipelineCacheCreateInfo cacheInfo = {0};
+	cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	cacheInfo.initialDataSize = data ? size : 0;
+	cacheInfo.pInitialData = data;
+
+	VkPipelineCache cache = VK_NULL_HANDLE;
+	if (vkCreatePipelineCache(vk->device, &cacheInfo, NULL, &cache) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to create pipeline cache\n");
+		return 0;
+	}
+
+	if (vk->pipelineCache) {
+		vkDestroyPipelineCache(vk->device, vk->pipelineCache, NULL);
+	}
+	vk->pipelineCache = cache;
+	return data != NULL;
+}
+
+int nvgvk_pipeline_cache_load_file(NVGVkContext* vk, const char* path)
+{
+	FILE* file = fopen(path, "rb");
+	if (!file) {
+		// First run: the cache starts empty at the first flush
+		return 0;
+	}
+
+	fseek(file, 0, SEEK_END);
+	long fileSize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	void* data = fileSize > 0 ? malloc((size_t)fileSize) : NULL;
+	if (!data || fread(data, 1, (size_t)fileSize, file) != (size_t)fileSize) {
+		fclose(file);
+		free(data);
+		return 0;
+	}
+	fclose(file);
+
+	int result = nvgvk_pipeline_cache_load(vk, data, (size_t)fileSize);
+	free(data);
+	return result;
+}
+
+int nvgvk_pipeline_cache_data(NVGVkContext* vk, void* data, size_t* size)
+{
+	if (!vk || !size || !vk->pipelineCache) {
+		return 0;
+	}
+
+	VkResult result = vkGetPipelineCacheData(vk->device, vk->pipelineCache, size, data);
+	return result == VK_SUCCESS;
+}
+
+int nvgvk_pipeline_cache_save_file(NVGVkContext* vk, const char* path)
+{
+	size_t size = 0;
+	if (!nvgvk_pipeline_cache_data(vk, NULL, &size) || size == 0) {
+		return 0;
+	}
+
+	void* data = malloc(size);
+	if (!data) {
+		return 0;
+	}
+	if (!nvgvk_pipeline_cache_data(vk, data, &size)) {
+		free(data);
+		return 0;
+	}
+
+	// Write a temporary file and rename it so a crash never leaves a torn cache
+	size_t pathLen = strlen(path);
+	char* tmpPath = (char*)malloc(pathLen + 5);
+	if (!tmpPath) {
+		free(data);
+		return 0;
+	}
+	memcpy(tmpPath, path, pathLen);
+	memcpy(tmpPath + pathLen, ".tmp", 5);
+
+	int ok = 0;
+	FILE* file = fopen(tmpPath, "wb");
+	if (file) {
+		ok = fwrite(data, 1, size, file) == size;
+		ok = fclose(file) == 0 && ok;
+	}
+	if (ok && rename(tmpPath, path) != 0) {
+		// Some platforms refuse to rename over an existing file
+		remove(path);
+		ok = rename(tmpPath, path) == 0;
+	}
+	if (!ok) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to write pipeline cache %s\n", path);
+		remove(tmpPath);
+	}
+
+	free(tmpPath);
+	free(data);
+	return ok;
+}
+
+void nvgvk_pipeline_cache_destroy(NVGVkContext* vk)
+{
+	if (vk->pipelineCache) {
+		if (vk->pipelineCachePath) {
+			nvgvk_pipeline_cache_save_file(vk, vk->pipelineCachePath);
+		}
+		vkDestroyPipelineCache(vk->device, vk->pipelineCache, NULL);
+		vk->pipelineCache = VK_NULL_HANDLE;
+	}
+
+	free(vk->pipelineCachePath);
+	vk->pipelineCachePath = NULL;
 }
@@ -14,12 +14,39 @@ typedef enum NVGVkPipelineType {
 	NVGVK_PIPELINE_FRINGE = 6,           // AA fringe rendering (triangle strip)
 	NVGVK_PIPELINE_TEXT_MSDF = 7,        // MSDF text rendering
 	NVGVK_PIPELINE_TEXT_SUBPIXEL = 8,    // LCD subpixel text rendering
-	NVGVK_PIPELINE_TEXT_ALPHA = 9        // Grayscale alpha text rendering
+	NVGVK_PIPELINE_TEXT_ALPHA = 9,       // Grayscale alpha text rendering
+	NVGVK_PIPELINE_GLYPHS_ALPHA = 10,    // Instanced text (one NVGVkGlyph per instance), grayscale
+	NVGVK_PIPELINE_GLYPHS_MSDF = 11,     // Instanced text, MSDF
+	NVGVK_PIPELINE_GLYPHS_SUBPIXEL = 12, // Instanced text, LCD subpixel
+	NVGVK_PIPELINE_GLYPHS_IMG = 13,      // Instanced text, RGBA (color glyphs)
+	NVGVK_PIPELINE_SHAPE = 14            // Analytic rect/rounded rect/ellipse quad (signed distance coverage)
 } NVGVkPipelineType;
 
 // Pipeline management
 int nvgvk_create_pipelines(NVGVkContext* vk, VkRenderPass renderPass);
 void nvgvk_destroy_pipelines(NVGVkContext* vk);
-void nvgvk_bind_pipeline(NVGVkContext* vk, NVGVkPipelineType type);
+
+// Pipeline variants: one VkPipeline per (type, blend factors, render pass), where
+// the type fixes shaders, stencil state and topology and the render pass fixes
+// color format and sample count. Variants are compiled on first use and live
+// until nvgvk_destroy_pipelines. blend NULL selects source-over.
+VkPipeline nvgvk_get_pipeline(NVGVkContext* vk, NVGVkPipelineType type, const NVGVkBlend* blend);
+// Bind the variant and the type's descriptor set. Returns the type's layout
+// state, or NULL if the variant could not be created (skip the draw).
+NVGVkPipeline* nvgvk_bind_pipeline(NVGVkContext* vk, NVGVkPipelineType type, const NVGVkBlend* blend);
+
+// Pipeline cache. Load before the first flush (pipelines are created there);
+// data from another driver or device is rejected by header validation.
+int nvgvk_pipeline_cache_load(NVGVkContext* vk, const void* data, size_t size);
+int nvgvk_pipeline_cache_load_file(NVGVkContext* vk, const char* path);
+int nvgvk_pipeline_cache_save_file(NVGVkContext* vk, const char* path);
+// Vulkan two-call idiom: data NULL returns the required size
+int nvgvk_pipeline_cache_data(NVGVkContext* vk, void* data, size_t* size);
+// Save to pipelineCachePath (if set) and destroy the cache
+void nvgvk_pipeline_cache_destroy(NVGVkContext* vk);
+
+// Bind a set-0 descriptor set with the current frame's uniform offset (skipped
+// if the set is already bound)
+void nvgvk_bind_descriptor_set(NVGVkContext* vk, VkPipelineLayout layout, VkDescriptorSet set);
 
 #endif // NVG_VK_PIPELINE_H
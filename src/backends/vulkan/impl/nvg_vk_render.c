@@ -1,6 +1,9 @@
 #include "nvg_vk_render.h"
 #include "nvg_vk_pipeline.h"
+#include "nvg_vk_buffer.h"
+#include "../nanovg.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 // Helper: Update descriptor set with texture
@@ -23,6 +26,12 @@ static void nvgvk__update_descriptors(NVGVkContext* vk, int texId, NVGVkPipeline
 		imageInfo.sampler = vk->textures[0].sampler;
 	}
 
+	// The set still holds these bindings: nothing to write
+	if (pipeline->writtenBuffer == bufferInfo.buffer && pipeline->writtenImageView == imageInfo.imageView &&
+	    pipeline->writtenSampler == imageInfo.sampler) {
+		return;
+	}
+
 	VkWriteDescriptorSet writes[2] = {0};
 
 	// Uniform buffer
@@ -30,7 +39,7 @@ static void nvgvk__update_descriptors(NVGVkContext* vk, int texId, NVGVkPipeline
 	writes[0].dstSet = pipeline->descriptorSet;
 	writes[0].dstBinding = 0;
 	writes[0].descriptorCount = 1;
-	writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 	writes[0].pBufferInfo = &bufferInfo;
 
 	// Texture sampler
@@ -42,12 +51,17 @@ static void nvgvk__update_descriptors(NVGVkContext* vk, int texId, NVGVkPipeline
 	writes[1].pImageInfo = &imageInfo;
 
 	vkUpdateDescriptorSets(vk->device, 2, writes, 0, NULL);
+	vk->counters.descriptorWrites++;
+
+	pipeline->writtenBuffer = bufferInfo.buffer;
+	pipeline->writtenImageView = imageInfo.imageView;
+	pipeline->writtenSampler = imageInfo.sampler;
 }
 
-// Setup render (updates all descriptor sets BEFORE command buffer recording)
+// Setup render (updates changed descriptor sets BEFORE command buffer recording)
 void nvgvk_setup_render(NVGVkContext* vk)
 {
-	// Update descriptor sets for all pipelines
+	// Update descriptor sets whose bindings changed since they were last written
 	for (int i = 0; i < NVGVK_PIPELINE_COUNT; i++) {
 		nvgvk__update_descriptors(vk, -1, &vk->pipelines[i]);
 	}
@@ -77,7 +91,8 @@ void nvgvk_begin_render_pass(NVGVkContext* vk, VkRenderPass renderPass, VkFrameb
 	vk->scissor = scissor;
 
 	// Invalidate pipeline state (force rebind on first use)
-	vk->currentPipeline = NVGVK_PIPELINE_COUNT;  // Invalid value
+	vk->currentPipeline = VK_NULL_HANDLE;
+	vk->currentDescriptorSet = VK_NULL_HANDLE;
 
 	vk->inRenderPass = 1;
 }
@@ -95,6 +110,117 @@ void nvgvk_end_render_pass(NVGVkContext* vk)
 	vk->activeFramebuffer = VK_NULL_HANDLE;
 }
 
+// Helper: Make room for one more queued draw (0 if the queue cannot grow)
+static int nvgvk__reserve_draw(NVGVkContext* vk)
+{
+	if (vk->drawCount + 1 <= vk->drawCapacity) {
+		return 1;
+	}
+
+	int capacity = vk->drawCapacity > 0 ? vk->drawCapacity * 2 : 64;
+	VkDrawIndirectCommand* draws = (VkDrawIndirectCommand*)realloc(vk->draws, sizeof(VkDrawIndirectCommand) * capacity);
+	if (!draws) {
+		return 0;
+	}
+	vk->draws = draws;
+	vk->drawCapacity = capacity;
+	return 1;
+}
+
+void nvgvk_draw(NVGVkContext* vk, int first, int count)
+{
+	// Strips cannot be joined without connecting their last and first vertices
+	if (vk->drawCount > 0 && !vk->currentPipelineStrip) {
+		VkDrawIndirectCommand* last = &vk->draws[vk->drawCount - 1];
+		if ((uint32_t)first == last->firstVertex + last->vertexCount) {
+			last->vertexCount += (uint32_t)count;
+			return;
+		}
+	}
+
+	if (!nvgvk__reserve_draw(vk)) {
+		// Out of memory: record what is batched so far and start over
+		nvgvk_flush_draws(vk);
+		if (vk->drawCapacity == 0) {
+			vkCmdDraw(vk->commandBuffer, (uint32_t)count, 1, (uint32_t)first, 0);
+			vk->counters.draws++;
+			return;
+		}
+	}
+
+	VkDrawIndirectCommand* draw = &vk->draws[vk->drawCount++];
+	draw->vertexCount = (uint32_t)count;
+	draw->instanceCount = 1;
+	draw->firstVertex = (uint32_t)first;
+	draw->firstInstance = 0;
+}
+
+void nvgvk_draw_glyphs(NVGVkContext* vk, int first, int count)
+{
+	// Runs written one after another continue the queued instance range
+	if (vk->drawCount > 0) {
+		VkDrawIndirectCommand* last = &vk->draws[vk->drawCount - 1];
+		if ((uint32_t)first == last->firstInstance + last->instanceCount) {
+			last->instanceCount += (uint32_t)count;
+			return;
+		}
+		// Never queue a second range: indirect draws with firstInstance != 0
+		// would need the drawIndirectFirstInstance feature
+		nvgvk_flush_draws(vk);
+	}
+
+	if (!nvgvk__reserve_draw(vk)) {
+		vkCmdDraw(vk->commandBuffer, 4, (uint32_t)count, 0, (uint32_t)first);
+		vk->counters.draws++;
+		return;
+	}
+
+	VkDrawIndirectCommand* draw = &vk->draws[vk->drawCount++];
+	draw->vertexCount = 4;
+	draw->instanceCount = (uint32_t)count;
+	draw->firstVertex = 0;
+	draw->firstInstance = (uint32_t)first;
+}
+
+void nvgvk_flush_draws(NVGVkContext* vk)
+{
+	if (vk->drawCount == 0) {
+		return;
+	}
+
+	// Many disjoint ranges (per-path stencil fills, fringe strips): one indirect draw
+	if (vk->multiDrawIndirect && vk->drawCount > 1) {
+		NVGVkBuffer* buffer = &vk->frames[vk->frameIndex].indirectBuffer;
+		VkDeviceSize offset = buffer->size;
+		VkDeviceSize bytes = sizeof(VkDrawIndirectCommand) * (VkDeviceSize)vk->drawCount;
+
+		// A replaced buffer is released behind this frame, so earlier draws stay valid
+		if (nvgvk_buffer_reserve(vk, buffer, offset + bytes)) {
+			memcpy((unsigned char*)buffer->mapped + offset, vk->draws, (size_t)bytes);
+			buffer->size = offset + bytes;
+
+			for (uint32_t i = 0; i < (uint32_t)vk->drawCount; i += vk->maxDrawIndirectCount) {
+				uint32_t count = (uint32_t)vk->drawCount - i;
+				if (count > vk->maxDrawIndirectCount) {
+					count = vk->maxDrawIndirectCount;
+				}
+				vkCmdDrawIndirect(vk->commandBuffer, buffer->buffer, offset + sizeof(VkDrawIndirectCommand) * i,
+				                  count, sizeof(VkDrawIndirectCommand));
+				vk->counters.draws++;
+			}
+			vk->drawCount = 0;
+			return;
+		}
+	}
+
+	for (int i = 0; i < vk->drawCount; i++) {
+		VkDrawIndirectCommand* draw = &vk->draws[i];
+		vkCmdDraw(vk->commandBuffer, draw->vertexCount, draw->instanceCount, draw->firstVertex, draw->firstInstance);
+		vk->counters.draws++;
+	}
+	vk->drawCount = 0;
+}
+
 // Helper: Set stencil test state
 static void nvgvk__set_stencil_test(VkCommandBuffer cmd, int enable, VkCompareOp compareOp,
                                      VkStencilOp passOp, uint32_t ref, uint32_t compareMask, uint32_t writeMask)
@@ -107,6 +233,26 @@ static void nvgvk__set_stencil_test(VkCommandBuffer cmd, int enable, VkCompareOp
 	}
 }
 
+// Helper: Bind the set-0 descriptor set a call samples from. With the bindless
+// table the texture is selected by the call's uniforms, so the set bound by
+// nvgvk_bind_pipeline stays and texture switches no longer split draws.
+static void nvgvk__bind_image(NVGVkContext* vk, NVGVkPipeline* pipeline, int image)
+{
+	if (vk->bindless) {
+		return;
+	}
+
+	if (image > 0) {
+		int texId = image - 1;
+		if (texId >= 0 && texId < NVGVK_MAX_TEXTURES && vk->textures[texId].image != VK_NULL_HANDLE) {
+			nvgvk_bind_descriptor_set(vk, pipeline->layout, vk->textures[texId].descriptorSet);
+		}
+	} else {
+		// Bind pipeline's default descriptor set
+		nvgvk_bind_descriptor_set(vk, pipeline->layout, pipeline->descriptorSet);
+	}
+}
+
 void nvgvk_render_fill(NVGVkContext* vk, NVGVkCall* call)
 {
 	if (!vk || !call || call->pathCount == 0) {
@@ -117,20 +263,15 @@ void nvgvk_render_fill(NVGVkContext* vk, NVGVkCall* call)
 	// Pass 1: Write to stencil buffer (color writes disabled)
 	// Pass 2: Draw cover quad where stencil != 0 (color writes enabled)
 
-	// Get uniforms
-	NVGVkFragUniforms* frag = (NVGVkFragUniforms*)(&vk->uniforms[call->uniformOffset].scissorMat);
-
 	// === PASS 1: Stencil Write ===
 	// Bind stencil write pipeline (color writes disabled)
-	nvgvk_bind_pipeline(vk, NVGVK_PIPELINE_FILL_STENCIL);
-	NVGVkPipeline* stencilPipeline = &vk->pipelines[NVGVK_PIPELINE_FILL_STENCIL];
-
-	// Push constants
-	vkCmdPushConstants(vk->commandBuffer, stencilPipeline->layout,
-	                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-	                   0, sizeof(NVGVkFragUniforms), frag);
+	NVGVkPipeline* stencilPipeline = nvgvk_bind_pipeline(vk, NVGVK_PIPELINE_FILL_STENCIL, NULL);
+	if (!stencilPipeline) {
+		return;
+	}
 
 	// Set stencil reference/masks (pipeline has stencil ops configured)
+	nvgvk_flush_draws(vk);
 	vkCmdSetStencilReference(vk->commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, 0);
 	vkCmdSetStencilCompareMask(vk->commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, 0xFF);
 	vkCmdSetStencilWriteMask(vk->commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, 0xFF);
@@ -139,7 +280,7 @@ void nvgvk_render_fill(NVGVkContext* vk, NVGVkCall* call)
 	for (int i = 0; i < call->pathCount; i++) {
 		NVGVkPath* path = &vk->paths[call->pathOffset + i];
 		if (path->fillCount > 0) {
-			vkCmdDraw(vk->commandBuffer, path->fillCount, 1, path->fillOffset, 0);
+			nvgvk_draw(vk, path->fillOffset, path->fillCount);
 		}
 	}
 
@@ -148,52 +289,37 @@ void nvgvk_render_fill(NVGVkContext* vk, NVGVkCall* call)
 	// Note: image > 0 means texture, image == 0 means solid color or gradient
 	NVGVkPipelineType coverPipeline = (call->image > 0) ?
 		NVGVK_PIPELINE_FILL_COVER_IMG : NVGVK_PIPELINE_FILL_COVER_GRAD;
-	nvgvk_bind_pipeline(vk, coverPipeline);
-	NVGVkPipeline* pipeline = &vk->pipelines[coverPipeline];
-
-	// Bind texture descriptor set if using image
-	if (call->image > 0) {
-		int texId = call->image - 1;
-		if (texId >= 0 && texId < NVGVK_MAX_TEXTURES && vk->textures[texId].image != VK_NULL_HANDLE) {
-			vkCmdBindDescriptorSets(vk->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-			                        pipeline->layout, 0, 1, &vk->textures[texId].descriptorSet, 0, NULL);
-		}
-	} else {
-		// Bind pipeline's default descriptor set for gradients
-		vkCmdBindDescriptorSets(vk->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-		                        pipeline->layout, 0, 1, &pipeline->descriptorSet, 0, NULL);
+	NVGVkPipeline* pipeline = nvgvk_bind_pipeline(vk, coverPipeline, &call->blend);
+	if (!pipeline) {
+		return;
 	}
 
-	// Push constants (same uniforms for cover pass)
-	vkCmdPushConstants(vk->commandBuffer, pipeline->layout,
-	                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-	                   0, sizeof(NVGVkFragUniforms), frag);
+	// Bind texture descriptor set if using image
+	nvgvk__bind_image(vk, pipeline, call->image);
 
 	// Set stencil test parameters (pipeline configured for NOT_EQUAL test)
+	nvgvk_flush_draws(vk);
 	vkCmdSetStencilReference(vk->commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, 0);
 	vkCmdSetStencilCompareMask(vk->commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, 0xFF);
 	vkCmdSetStencilWriteMask(vk->commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, 0xFF);
 
 	// Draw bounding quad (only pixels where stencil != 0 will be drawn)
 	if (call->triangleCount >= 3) {
-		vkCmdDraw(vk->commandBuffer, call->triangleCount, 1, call->triangleOffset, 0);
+		nvgvk_draw(vk, call->triangleOffset, call->triangleCount);
 	}
 
 	// === PASS 3: AA Fringe ===
 	// Draw anti-aliasing fringe (triangle strip around edges)
-	nvgvk_bind_pipeline(vk, NVGVK_PIPELINE_FRINGE);
-	NVGVkPipeline* fringePipeline = &vk->pipelines[NVGVK_PIPELINE_FRINGE];
-
-	// Push constants (same uniforms)
-	vkCmdPushConstants(vk->commandBuffer, fringePipeline->layout,
-	                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-	                   0, sizeof(NVGVkFragUniforms), frag);
+	NVGVkPipeline* fringePipeline = nvgvk_bind_pipeline(vk, NVGVK_PIPELINE_FRINGE, &call->blend);
+	if (!fringePipeline) {
+		return;
+	}
 
 	// Draw fringe for all paths
 	for (int i = 0; i < call->pathCount; i++) {
 		NVGVkPath* path = &vk->paths[call->pathOffset + i];
 		if (path->strokeCount > 0) {
-			vkCmdDraw(vk->commandBuffer, path->strokeCount, 1, path->strokeOffset, 0);
+			nvgvk_draw(vk, path->strokeOffset, path->strokeCount);
 		}
 	}
 }
@@ -206,32 +332,18 @@ void nvgvk_render_convex_fill(NVGVkContext* vk, NVGVkCall* call)
 
 	// Convex fills can be drawn directly without stencil - use SIMPLE pipeline
 	NVGVkPipelineType pipelineType = (call->image >= 0) ? NVGVK_PIPELINE_IMG : NVGVK_PIPELINE_SIMPLE;
-	NVGVkPipeline* pipeline = &vk->pipelines[pipelineType];
-	nvgvk_bind_pipeline(vk, pipelineType);
-
-	// Bind texture descriptor set if using image
-	if (call->image > 0) {
-		int texId = call->image - 1;
-		if (texId >= 0 && texId < NVGVK_MAX_TEXTURES && vk->textures[texId].image != VK_NULL_HANDLE) {
-			vkCmdBindDescriptorSets(vk->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-			                        pipeline->layout, 0, 1, &vk->textures[texId].descriptorSet, 0, NULL);
-		}
-	} else {
-		// Bind pipeline's default descriptor set
-		vkCmdBindDescriptorSets(vk->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-		                        pipeline->layout, 0, 1, &pipeline->descriptorSet, 0, NULL);
+	NVGVkPipeline* pipeline = nvgvk_bind_pipeline(vk, pipelineType, &call->blend);
+	if (!pipeline) {
+		return;
 	}
 
-	// Skip viewSize (2 floats) to get FragUniforms
-	NVGVkFragUniforms* frag = (NVGVkFragUniforms*)(&vk->uniforms[call->uniformOffset].scissorMat);
-	vkCmdPushConstants(vk->commandBuffer, pipeline->layout,
-	                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-	                   0, sizeof(NVGVkFragUniforms), frag);
+	// Bind texture descriptor set if using image
+	nvgvk__bind_image(vk, pipeline, call->image);
 
 	for (int i = 0; i < call->pathCount; i++) {
 		NVGVkPath* path = &vk->paths[call->pathOffset + i];
 		if (path->fillCount > 0) {
-			vkCmdDraw(vk->commandBuffer, path->fillCount, 1, path->fillOffset, 0);
+			nvgvk_draw(vk, path->fillOffset, path->fillCount);
 		}
 	}
 }
@@ -244,19 +356,15 @@ void nvgvk_render_stroke(NVGVkContext* vk, NVGVkCall* call)
 
 	// Strokes use FRINGE pipeline (triangle strip with AA support)
 	NVGVkPipelineType pipelineType = NVGVK_PIPELINE_FRINGE;
-	NVGVkPipeline* pipeline = &vk->pipelines[pipelineType];
-	nvgvk_bind_pipeline(vk, pipelineType);
-
-	// Skip viewSize (2 floats) to get FragUniforms
-	NVGVkFragUniforms* frag = (NVGVkFragUniforms*)(&vk->uniforms[call->uniformOffset].scissorMat);
-	vkCmdPushConstants(vk->commandBuffer, pipeline->layout,
-	                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-	                   0, sizeof(NVGVkFragUniforms), frag);
+	NVGVkPipeline* pipeline = nvgvk_bind_pipeline(vk, pipelineType, &call->blend);
+	if (!pipeline) {
+		return;
+	}
 
 	for (int i = 0; i < call->pathCount; i++) {
 		NVGVkPath* path = &vk->paths[call->pathOffset + i];
 		if (path->strokeCount > 0) {
-			vkCmdDraw(vk->commandBuffer, path->strokeCount, 1, path->strokeOffset, 0);
+			nvgvk_draw(vk, path->strokeOffset, path->strokeCount);
 		}
 	}
 }
@@ -291,24 +399,18 @@ void nvgvk_render_triangles(NVGVkContext* vk, NVGVkCall* call)
 			pipelineType = NVGVK_PIPELINE_IMG;
 		}
 	}
-	NVGVkPipeline* pipeline = &vk->pipelines[pipelineType];
-
-	nvgvk_bind_pipeline(vk, pipelineType);
+	NVGVkPipeline* pipeline = nvgvk_bind_pipeline(vk, pipelineType, &call->blend);
+	if (!pipeline) {
+		return;
+	}
 
 	// Bind texture descriptor set if using image
 	if (call->image > 0) {
 		int texId = call->image - 1;
 		printf("[nvgvk_render_triangles] Binding texture %d (image %d), descriptorSet=%p, image=%p\n",
 			texId, call->image, (void*)vk->textures[texId].descriptorSet, (void*)vk->textures[texId].image);
-		if (texId >= 0 && texId < NVGVK_MAX_TEXTURES && vk->textures[texId].image != VK_NULL_HANDLE) {
-			vkCmdBindDescriptorSets(vk->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-			                        pipeline->layout, 0, 1, &vk->textures[texId].descriptorSet, 0, NULL);
-		}
-	} else {
-		// Bind pipeline's default descriptor set
-		vkCmdBindDescriptorSets(vk->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-		                        pipeline->layout, 0, 1, &pipeline->descriptorSet, 0, NULL);
 	}
+	nvgvk__bind_image(vk, pipeline, call->image);
 
 	// Skip viewSize (2 floats) to get FragUniforms
 	NVGVkFragUniforms* frag = (NVGVkFragUniforms*)(&vk->uniforms[call->uniformOffset].scissorMat);
@@ -316,91 +418,101 @@ void nvgvk_render_triangles(NVGVkContext* vk, NVGVkCall* call)
 	printf("[nvgvk_render_triangles] texType=%d, type=%d, innerCol=(%.2f,%.2f,%.2f,%.2f)\n",
 		frag->texType, frag->type, frag->innerCol[0], frag->innerCol[1], frag->innerCol[2], frag->innerCol[3]);
 
-	vkCmdPushConstants(vk->commandBuffer, pipeline->layout,
-	                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-	                   0, sizeof(NVGVkFragUniforms), frag);
-
 	printf("[DRAW] triangles: count=%d offset=%d image=%d\n",
 		call->triangleCount, call->triangleOffset, call->image);
-	vkCmdDraw(vk->commandBuffer, call->triangleCount, 1, call->triangleOffset, 0);
+	nvgvk_draw(vk, call->triangleOffset, call->triangleCount);
+}
+
+void nvgvk_render_glyphs(NVGVkContext* vk, NVGVkCall* call)
+{
+	if (!vk || !call || call->glyphCount == 0) {
+		return;
+	}
+
+	// Same fragment shaders as the triangle text path, selected by the atlas type
+	NVGVkPipelineType pipelineType = NVGVK_PIPELINE_GLYPHS_IMG;
+	int texId = call->image - 1;
+	if (texId >= 0 && texId < NVGVK_MAX_TEXTURES) {
+		switch (vk->textures[texId].type) {
+			case NVG_TEXTURE_ALPHA:        pipelineType = NVGVK_PIPELINE_GLYPHS_ALPHA; break;
+			case NVG_TEXTURE_MSDF:         pipelineType = NVGVK_PIPELINE_GLYPHS_MSDF; break;
+			case NVG_TEXTURE_LCD_SUBPIXEL: pipelineType = NVGVK_PIPELINE_GLYPHS_SUBPIXEL; break;
+			default:                       break;
+		}
+	}
+	NVGVkPipeline* pipeline = nvgvk_bind_pipeline(vk, pipelineType, &call->blend);
+	if (!pipeline) {
+		return;
+	}
+
+	nvgvk__bind_image(vk, pipeline, call->image);
+
+	// Each glyph is one instance of a 4 vertex strip
+	nvgvk_draw_glyphs(vk, call->glyphOffset, call->glyphCount);
+}
+
+void nvgvk_render_shape(NVGVkContext* vk, NVGVkCall* call)
+{
+	if (!vk || !call || call->triangleCount == 0) {
+		return;
+	}
+
+	// One quad, coverage comes from the shape's signed distance (no stencil, no fringe)
+	NVGVkPipeline* pipeline = nvgvk_bind_pipeline(vk, NVGVK_PIPELINE_SHAPE, &call->blend);
+	if (!pipeline) {
+		return;
+	}
+
+	nvgvk__bind_image(vk, pipeline, 0);
+	nvgvk_draw(vk, call->triangleOffset, call->triangleCount);
 }
 
-void nvgvk_get_blend_factors(int blendFunc, VkBlendFactor* srcColor, VkBlendFactor* dstColor,
-                              VkBlendFactor* srcAlpha, VkBlendFactor* dstAlpha)
+// Helper: Convert one NVGblendFactor bit to a Vulkan blend factor (-1 if invalid)
+static int nvgvk__blend_factor(int factor)
 {
-	// NanoVG blend modes
-	switch (blendFunc) {
-		case 0: // Source over
-			*srcColor = VK_BLEND_FACTOR_ONE;
-			*dstColor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-			*srcAlpha = VK_BLEND_FACTOR_ONE;
-			*dstAlpha = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-			break;
-		case 1: // Source in
-			*srcColor = VK_BLEND_FACTOR_DST_ALPHA;
-			*dstColor = VK_BLEND_FACTOR_ZERO;
-			*srcAlpha = VK_BLEND_FACTOR_DST_ALPHA;
-			*dstAlpha = VK_BLEND_FACTOR_ZERO;
-			break;
-		case 2: // Source out
-			*srcColor = VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
-			*dstColor = VK_BLEND_FACTOR_ZERO;
-			*srcAlpha = VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
-			*dstAlpha = VK_BLEND_FACTOR_ZERO;
-			break;
-		case 3: // Atop
-			*srcColor = VK_BLEND_FACTOR_DST_ALPHA;
-			*dstColor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-			*srcAlpha = VK_BLEND_FACTOR_DST_ALPHA;
-			*dstAlpha = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-			break;
-		case 4: // Destination over
-			*srcColor = VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
-			*dstColor = VK_BLEND_FACTOR_ONE;
-			*srcAlpha = VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
-			*dstAlpha = VK_BLEND_FACTOR_ONE;
-			break;
-		case 5: // Destination in
-			*srcColor = VK_BLEND_FACTOR_ZERO;
-			*dstColor = VK_BLEND_FACTOR_SRC_ALPHA;
-			*srcAlpha = VK_BLEND_FACTOR_ZERO;
-			*dstAlpha = VK_BLEND_FACTOR_SRC_ALPHA;
-			break;
-		case 6: // Destination out
-			*srcColor = VK_BLEND_FACTOR_ZERO;
-			*dstColor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-			*srcAlpha = VK_BLEND_FACTOR_ZERO;
-			*dstAlpha = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-			break;
-		case 7: // Destination atop
-			*srcColor = VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
-			*dstColor = VK_BLEND_FACTOR_SRC_ALPHA;
-			*srcAlpha = VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
-			*dstAlpha = VK_BLEND_FACTOR_SRC_ALPHA;
-			break;
-		case 8: // Lighter
-			*srcColor = VK_BLEND_FACTOR_ONE;
-			*dstColor = VK_BLEND_FACTOR_ONE;
-			*srcAlpha = VK_BLEND_FACTOR_ONE;
-			*dstAlpha = VK_BLEND_FACTOR_ONE;
-			break;
-		case 9: // Copy
-			*srcColor = VK_BLEND_FACTOR_ONE;
-			*dstColor = VK_BLEND_FACTOR_ZERO;
-			*srcAlpha = VK_BLEND_FACTOR_ONE;
-			*dstAlpha = VK_BLEND_FACTOR_ZERO;
-			break;
-		case 10: // XOR
-			*srcColor = VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
-			*dstColor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-			*srcAlpha = VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
-			*dstAlpha = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-			break;
-		default:
-			*srcColor = VK_BLEND_FACTOR_ONE;
-			*dstColor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-			*srcAlpha = VK_BLEND_FACTOR_ONE;
-			*dstAlpha = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-			break;
+	switch (factor) {
+		case NVG_ZERO:                return VK_BLEND_FACTOR_ZERO;
+		case NVG_ONE:                 return VK_BLEND_FACTOR_ONE;
+		case NVG_SRC_COLOR:           return VK_BLEND_FACTOR_SRC_COLOR;
+		case NVG_ONE_MINUS_SRC_COLOR: return VK_BLEND_FACTOR_ONE_MINUS_SRC_COLOR;
+		case NVG_DST_COLOR:           return VK_BLEND_FACTOR_DST_COLOR;
+		case NVG_ONE_MINUS_DST_COLOR: return VK_BLEND_FACTOR_ONE_MINUS_DST_COLOR;
+		case NVG_SRC_ALPHA:           return VK_BLEND_FACTOR_SRC_ALPHA;
+		case NVG_ONE_MINUS_SRC_ALPHA: return VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+		case NVG_DST_ALPHA:           return VK_BLEND_FACTOR_DST_ALPHA;
+		case NVG_ONE_MINUS_DST_ALPHA: return VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
+		case NVG_SRC_ALPHA_SATURATE:  return VK_BLEND_FACTOR_SRC_ALPHA_SATURATE;
+		default:                      return -1;
 	}
 }
+
+void nvgvk_get_blend_factors(int srcRGB, int dstRGB, int srcAlpha, int dstAlpha, NVGVkBlend* blend)
+{
+	int factors[4] = {
+		nvgvk__blend_factor(srcRGB),
+		nvgvk__blend_factor(dstRGB),
+		nvgvk__blend_factor(srcAlpha),
+		nvgvk__blend_factor(dstAlpha)
+	};
+
+	if (factors[0] < 0 || factors[1] < 0 || factors[2] < 0 || factors[3] < 0) {
+		// Invalid composite state: fall back to source over
+		factors[0] = VK_BLEND_FACTOR_ONE;
+		factors[1] = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+		factors[2] = VK_BLEND_FACTOR_ONE;
+		factors[3] = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+	}
+
+	// NanoVG's factors assume premultiplied color, but the fragment shaders output
+	// straight color: weight the source by its alpha instead of one. Source over
+	// becomes the classic straight-alpha blend; other source factors are exact for
+	// opaque sources.
+	if (factors[0] == VK_BLEND_FACTOR_ONE) {
+		factors[0] = VK_BLEND_FACTOR_SRC_ALPHA;
+	}
+
+	blend->srcColor = (VkBlendFactor)factors[0];
+	blend->dstColor = (VkBlendFactor)factors[1];
+	blend->srcAlpha = (VkBlendFactor)factors[2];
+	blend->dstAlpha = (VkBlendFactor)factors[3];
+}
@@ -12,14 +12,28 @@ void nvgvk_begin_render_pass(NVGVkContext* vk, VkRenderPass renderPass, VkFrameb
                               VkViewport viewport, VkRect2D scissor);
 void nvgvk_end_render_pass(NVGVkContext* vk);
 
+// Draw batching. Vertices carry their call's uniform index, so a draw that
+// continues the previous one's vertex range under the same pipeline, descriptor
+// set and vertex chunk extends it instead of recording a new vkCmdDraw. Other
+// ranges queue up as VkDrawIndirectCommands and are recorded together: one
+// vkCmdDrawIndirect with multiDrawIndirect, a vkCmdDraw loop otherwise. Binding
+// helpers flush the queue before changing state.
+void nvgvk_draw(NVGVkContext* vk, int first, int count);
+void nvgvk_flush_draws(NVGVkContext* vk);
+
+// Instanced text: draw glyph instances [first, first + count) of the frame's
+// glyph buffer as vkCmdDraw(4, count). Consecutive runs merge into one draw.
+void nvgvk_draw_glyphs(NVGVkContext* vk, int first, int count);
+
 // Rendering functions
 void nvgvk_render_fill(NVGVkContext* vk, NVGVkCall* call);
 void nvgvk_render_convex_fill(NVGVkContext* vk, NVGVkCall* call);
 void nvgvk_render_stroke(NVGVkContext* vk, NVGVkCall* call);
 void nvgvk_render_triangles(NVGVkContext* vk, NVGVkCall* call);
+void nvgvk_render_glyphs(NVGVkContext* vk, NVGVkCall* call);
+void nvgvk_render_shape(NVGVkContext* vk, NVGVkCall* call);
 
-// Helper: Convert NanoVG blend mode to Vulkan blend factors
-void nvgvk_get_blend_factors(int blendFunc, VkBlendFactor* srcColor, VkBlendFactor* dstColor,
-                              VkBlendFactor* srcAlpha, VkBlendFactor* dstAlpha);
+// Helper: Convert NanoVG composite blend factors (NVGblendFactor) to Vulkan blend factors
+void nvgvk_get_blend_factors(int srcRGB, int dstRGB, int srcAlpha, int dstAlpha, NVGVkBlend* blend);
 
 #endif // NVG_VK_RENDER_H
@@ -16,8 +16,99 @@ static const char* nvgvk__shader_files[][2] = {
 	{"img.vert.spv", "text_msdf_simple.frag.spv"},      // TEXT_MSDF
 	{"img.vert.spv", "text_subpixel.frag.spv"},         // TEXT_SUBPIXEL
 	{"img.vert.spv", "text_alpha.frag.spv"},            // TEXT_ALPHA
+	{"text_instanced.vert.spv", "text_alpha.frag.spv"},        // GLYPHS_ALPHA
+	{"text_instanced.vert.spv", "text_msdf_simple.frag.spv"},  // GLYPHS_MSDF
+	{"text_instanced.vert.spv", "text_subpixel.frag.spv"},     // GLYPHS_SUBPIXEL
+	{"text_instanced.vert.spv", "img.frag.spv"},               // GLYPHS_IMG
+	{"simple.vert.spv", "shape.frag.spv"},              // SHAPE
 };
 
+// Fragment shaders sampling the bindless texture table (NULL = no texture sampled)
+static const char* nvgvk__bindless_frag_files[] = {
+	NULL,                                   // FILL_STENCIL
+	NULL,                                   // FILL_COVER_GRAD
+	"fill_img_bindless.frag.spv",           // FILL_COVER_IMG
+	NULL,                                   // SIMPLE
+	"img_bindless.frag.spv",                // IMG
+	"img_bindless.frag.spv",                // IMG_STENCIL
+	NULL,                                   // FRINGE
+	"text_msdf_simple_bindless.frag.spv",   // TEXT_MSDF
+	"text_subpixel_bindless.frag.spv",      // TEXT_SUBPIXEL
+	"text_alpha_bindless.frag.spv",         // TEXT_ALPHA
+	"text_alpha_bindless.frag.spv",         // GLYPHS_ALPHA
+	"text_msdf_simple_bindless.frag.spv",   // GLYPHS_MSDF
+	"text_subpixel_bindless.frag.spv",      // GLYPHS_SUBPIXEL
+	"img_bindless.frag.spv",                // GLYPHS_IMG
+	NULL,                                   // SHAPE
+};
+
+#ifdef NVGVK_EMBEDDED_SHADERS
+// SPIR-V compiled by the build (see NANOVG_EMBEDDED_SHADERS in CMakeLists.txt)
+#include "fill_grad.vert.spv.h"
+#include "fill_grad.frag.spv.h"
+#include "fill_img.vert.spv.h"
+#include "fill_img.frag.spv.h"
+#include "simple.vert.spv.h"
+#include "simple.frag.spv.h"
+#include "img.vert.spv.h"
+#include "img.frag.spv.h"
+#include "text_msdf_simple.frag.spv.h"
+#include "text_subpixel.frag.spv.h"
+#include "text_alpha.frag.spv.h"
+#include "text_instanced.vert.spv.h"
+#include "fill_img_bindless.frag.spv.h"
+#include "img_bindless.frag.spv.h"
+#include "text_msdf_simple_bindless.frag.spv.h"
+#include "text_subpixel_bindless.frag.spv.h"
+#include "text_alpha_bindless.frag.spv.h"
+#include "shape.frag.spv.h"
+
+typedef struct NVGVkSpirv {
+	const uint32_t* code;
+	size_t size;
+} NVGVkSpirv;
+
+#define NVGVK_SPIRV(words) {words, sizeof(words)}
+
+// Same order as nvgvk__shader_files
+static const NVGVkSpirv nvgvk__shader_code[][2] = {
+	{NVGVK_SPIRV(nvgvk_spv_fill_grad_vert), NVGVK_SPIRV(nvgvk_spv_fill_grad_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_fill_grad_vert), NVGVK_SPIRV(nvgvk_spv_fill_grad_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_fill_img_vert), NVGVK_SPIRV(nvgvk_spv_fill_img_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_simple_vert), NVGVK_SPIRV(nvgvk_spv_simple_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_img_vert), NVGVK_SPIRV(nvgvk_spv_img_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_img_vert), NVGVK_SPIRV(nvgvk_spv_img_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_simple_vert), NVGVK_SPIRV(nvgvk_spv_simple_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_img_vert), NVGVK_SPIRV(nvgvk_spv_text_msdf_simple_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_img_vert), NVGVK_SPIRV(nvgvk_spv_text_subpixel_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_img_vert), NVGVK_SPIRV(nvgvk_spv_text_alpha_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_text_instanced_vert), NVGVK_SPIRV(nvgvk_spv_text_alpha_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_text_instanced_vert), NVGVK_SPIRV(nvgvk_spv_text_msdf_simple_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_text_instanced_vert), NVGVK_SPIRV(nvgvk_spv_text_subpixel_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_text_instanced_vert), NVGVK_SPIRV(nvgvk_spv_img_frag)},
+	{NVGVK_SPIRV(nvgvk_spv_simple_vert), NVGVK_SPIRV(nvgvk_spv_shape_frag)},
+};
+
+// Same order as nvgvk__bindless_frag_files
+static const NVGVkSpirv nvgvk__bindless_frag_code[] = {
+	{NULL, 0},
+	{NULL, 0},
+	NVGVK_SPIRV(nvgvk_spv_fill_img_bindless_frag),
+	{NULL, 0},
+	NVGVK_SPIRV(nvgvk_spv_img_bindless_frag),
+	NVGVK_SPIRV(nvgvk_spv_img_bindless_frag),
+	{NULL, 0},
+	NVGVK_SPIRV(nvgvk_spv_text_msdf_simple_bindless_frag),
+	NVGVK_SPIRV(nvgvk_spv_text_subpixel_bindless_frag),
+	NVGVK_SPIRV(nvgvk_spv_text_alpha_bindless_frag),
+	NVGVK_SPIRV(nvgvk_spv_text_alpha_bindless_frag),
+	NVGVK_SPIRV(nvgvk_spv_text_msdf_simple_bindless_frag),
+	NVGVK_SPIRV(nvgvk_spv_text_subpixel_bindless_frag),
+	NVGVK_SPIRV(nvgvk_spv_img_bindless_frag),
+	{NULL, 0},
+};
+#endif
+
 static char* nvgvk__build_shader_path(const char* basePath, const char* filename)
 {
 	const char* base = basePath ? basePath : "src/shaders";
@@ -34,6 +125,46 @@ static char* nvgvk__build_shader_path(const char* basePath, const char* filename
 	return path;
 }
 
+// Helper: Create stage (0 = vertex, 1 = fragment) of shader set index. Embedded
+// SPIR-V is used unless a shader path was set (development override).
+static VkShaderModule nvgvk__load_shader(NVGVkContext* vk, int index, int stage)
+{
+	// Texture sampling fragment shaders have a bindless table variant
+	int bindless = vk->bindless && stage == 1 && nvgvk__bindless_frag_files[index];
+	const char* file = bindless ? nvgvk__bindless_frag_files[index] : nvgvk__shader_files[index][stage];
+
+#ifdef NVGVK_EMBEDDED_SHADERS
+	if (!vk->shaderBasePath) {
+		const NVGVkSpirv* spirv = bindless ? &nvgvk__bindless_frag_code[index] : &nvgvk__shader_code[index][stage];
+
+		VkShaderModuleCreateInfo createInfo = {0};
+		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		createInfo.codeSize = spirv->size;
+		createInfo.pCode = spirv->code;
+
+		VkShaderModule module = VK_NULL_HANDLE;
+		if (vkCreateShaderModule(vk->device, &createInfo, NULL, &module) != VK_SUCCESS) {
+			fprintf(stderr, "NanoVG Vulkan: Failed to create embedded shader module: %s\n", file);
+			return VK_NULL_HANDLE;
+		}
+		return module;
+	}
+#endif
+
+	char* path = nvgvk__build_shader_path(vk->shaderBasePath, file);
+	if (!path) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to allocate memory for shader path\n");
+		return VK_NULL_HANDLE;
+	}
+
+	VkShaderModule module = vk_load_shader_module(vk->device, path);
+	if (module == VK_NULL_HANDLE) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to load shader: %s\n", path);
+	}
+	free(path);
+	return module;
+}
+
 int nvgvk_create_shaders(NVGVkContext* vk)
 {
 	if (!vk) {
@@ -43,45 +174,17 @@ int nvgvk_create_shaders(NVGVkContext* vk)
 	for (int i = 0; i < NVGVK_SHADER_COUNT; i++) {
 		NVGVkShaderSet* shader = &vk->shaders[i];
 
-		// Build vertex shader path
-		char* vertPath = nvgvk__build_shader_path(vk->shaderBasePath, nvgvk__shader_files[i][0]);
-		if (!vertPath) {
-			fprintf(stderr, "NanoVG Vulkan: Failed to allocate memory for shader path\n");
-			nvgvk_destroy_shaders(vk);
-			return 0;
-		}
-
-		// Load vertex shader
-		shader->vertShader = vk_load_shader_module(vk->device, vertPath);
+		shader->vertShader = nvgvk__load_shader(vk, i, 0);
 		if (shader->vertShader == VK_NULL_HANDLE) {
-			fprintf(stderr, "NanoVG Vulkan: Failed to load vertex shader: %s\n", vertPath);
-			free(vertPath);
 			nvgvk_destroy_shaders(vk);
 			return 0;
 		}
-		free(vertPath);
 
-		// Build fragment shader path
-		char* fragPath = nvgvk__build_shader_path(vk->shaderBasePath, nvgvk__shader_files[i][1]);
-		if (!fragPath) {
-			fprintf(stderr, "NanoVG Vulkan: Failed to allocate memory for shader path\n");
-			vkDestroyShaderModule(vk->device, shader->vertShader, NULL);
-			shader->vertShader = VK_NULL_HANDLE;
-			nvgvk_destroy_shaders(vk);
-			return 0;
-		}
-
-		// Load fragment shader
-		shader->fragShader = vk_load_shader_module(vk->device, fragPath);
+		shader->fragShader = nvgvk__load_shader(vk, i, 1);
 		if (shader->fragShader == VK_NULL_HANDLE) {
-			fprintf(stderr, "NanoVG Vulkan: Failed to load fragment shader: %s\n", fragPath);
-			free(fragPath);
-			vkDestroyShaderModule(vk->device, shader->vertShader, NULL);
-			shader->vertShader = VK_NULL_HANDLE;
 			nvgvk_destroy_shaders(vk);
 			return 0;
 		}
-		free(fragPath);
 	}
 
 	return 1;
@@ -16,6 +16,11 @@ typedef enum NVGVkShaderType {
 	NVGVK_SHADER_TEXT_MSDF,
 	NVGVK_SHADER_TEXT_SUBPIXEL,
 	NVGVK_SHADER_TEXT_ALPHA,
+	NVGVK_SHADER_GLYPHS_ALPHA,
+	NVGVK_SHADER_GLYPHS_MSDF,
+	NVGVK_SHADER_GLYPHS_SUBPIXEL,
+	NVGVK_SHADER_GLYPHS_IMG,
+	NVGVK_SHADER_SHAPE,
 	NVGVK_SHADER_COUNT
 } NVGVkShaderType;
 
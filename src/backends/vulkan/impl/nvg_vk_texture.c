@@ -1,5 +1,8 @@
 #include "nvg_vk_texture.h"
 #include "nvg_vk_buffer.h"
+#include "nvg_vk_upload.h"
+#include "nvg_vk_memory.h"
+#include "nvg_vk_frame.h"
 #include "../nanovg.h"
 #include <stdio.h>
 #include <string.h>
@@ -17,22 +20,6 @@ VkFormat nvgvk__get_vk_format(int type)
 	return VK_FORMAT_R8_UNORM;  // ALPHA
 }
 
-// Helper: Find memory type
-static uint32_t nvgvk__find_memory_type(NVGVkContext* vk, uint32_t typeFilter,
-                                        VkMemoryPropertyFlags properties)
-{
-	VkPhysicalDeviceMemoryProperties memProperties;
-	vkGetPhysicalDeviceMemoryProperties(vk->physicalDevice, &memProperties);
-
-	for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-		if ((typeFilter & (1 << i)) &&
-		    (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-			return i;
-		}
-	}
-	return UINT32_MAX;
-}
-
 // Allocate a texture slot
 int nvgvk__allocate_texture(NVGVkContext* vk)
 {
@@ -53,9 +40,9 @@ int nvgvk__init_texture_descriptors(NVGVkContext* vk)
 	// Create descriptor set layout for textures (uniform buffer + sampler)
 	VkDescriptorSetLayoutBinding bindings[2] = {0};
 
-	// Binding 0: Uniform buffer (viewSize)
+	// Binding 0: Uniform buffer (viewSize, dynamic offset selects the frame slot)
 	bindings[0].binding = 0;
-	bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 	bindings[0].descriptorCount = 1;
 	bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
@@ -77,13 +64,14 @@ int nvgvk__init_texture_descriptors(NVGVkContext* vk)
 
 	// Create descriptor pool for all texture descriptor sets
 	VkDescriptorPoolSize poolSizes[2] = {0};
-	poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 	poolSizes[0].descriptorCount = NVGVK_MAX_TEXTURES;
 	poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 	poolSizes[1].descriptorCount = NVGVK_MAX_TEXTURES;
 
 	VkDescriptorPoolCreateInfo poolInfo = {0};
 	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;  // Sets of deleted textures are recycled
 	poolInfo.poolSizeCount = 2;
 	poolInfo.pPoolSizes = poolSizes;
 	poolInfo.maxSets = NVGVK_MAX_TEXTURES;
@@ -95,12 +83,148 @@ int nvgvk__init_texture_descriptors(NVGVkContext* vk)
 		return 0;
 	}
 
+	// Devices that cannot create the table keep using per-texture sets
+	if (vk->bindless && !nvgvk__init_texture_table(vk)) {
+		fprintf(stderr, "NanoVG Vulkan: Bindless texture table unavailable, using per-texture descriptor sets\n");
+		vk->bindless = 0;
+	}
+
+	return 1;
+}
+
+// Helper: Create the bindless texture table layout and the pool of its per-frame sets
+int nvgvk__init_texture_table(NVGVkContext* vk)
+{
+	// Slots stay unwritten until the first texture exists
+	VkDescriptorBindingFlags bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+
+	VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo = {0};
+	flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+	flagsInfo.bindingCount = 1;
+	flagsInfo.pBindingFlags = &bindingFlags;
+
+	VkDescriptorSetLayoutBinding binding = {0};
+	binding.binding = 0;
+	binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	binding.descriptorCount = NVGVK_MAX_TEXTURES;
+	binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo = {0};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.pNext = &flagsInfo;
+	layoutInfo.bindingCount = 1;
+	layoutInfo.pBindings = &binding;
+
+	if (vkCreateDescriptorSetLayout(vk->device, &layoutInfo, NULL, &vk->textureTableLayout) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to create texture table layout\n");
+		return 0;
+	}
+
+	VkDescriptorPoolSize poolSize = {0};
+	poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	poolSize.descriptorCount = NVGVK_MAX_TEXTURES * NVGVK_MAX_FRAMES_IN_FLIGHT;
+
+	VkDescriptorPoolCreateInfo poolInfo = {0};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.maxSets = NVGVK_MAX_FRAMES_IN_FLIGHT;
+	poolInfo.poolSizeCount = 1;
+	poolInfo.pPoolSizes = &poolSize;
+
+	if (vkCreateDescriptorPool(vk->device, &poolInfo, NULL, &vk->textureTablePool) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to create texture table pool\n");
+		vkDestroyDescriptorSetLayout(vk->device, vk->textureTableLayout, NULL);
+		vk->textureTableLayout = VK_NULL_HANDLE;
+		return 0;
+	}
+
+	return 1;
+}
+
+int nvgvk_texture_table_update(NVGVkContext* vk, NVGVkFrame* frame)
+{
+	if (!frame->textureTableSet) {
+		VkDescriptorSetAllocateInfo allocInfo = {0};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = vk->textureTablePool;
+		allocInfo.descriptorSetCount = 1;
+		allocInfo.pSetLayouts = &vk->textureTableLayout;
+
+		if (vkAllocateDescriptorSets(vk->device, &allocInfo, &frame->textureTableSet) != VK_SUCCESS) {
+			fprintf(stderr, "NanoVG Vulkan: Failed to allocate texture table set\n");
+			frame->textureTableSet = VK_NULL_HANDLE;
+			return 0;
+		}
+		memset(frame->textureTableSerials, 0, sizeof(frame->textureTableSerials));
+	}
+
+	// Empty slots point at the first live texture: calls without an image still
+	// run sampling shaders (e.g. convex fills) and read their slot
+	NVGVkTexture* placeholder = NULL;
+	for (int i = 0; i < NVGVK_MAX_TEXTURES && !placeholder; i++) {
+		if (vk->textures[i].image) {
+			placeholder = &vk->textures[i];
+		}
+	}
+	if (!placeholder) {
+		return 1;
+	}
+
+	// The frame's fence has been waited on, so its set is not in use. Runs of
+	// changed slots are written with one VkWriteDescriptorSet each.
+	VkDescriptorImageInfo imageInfos[NVGVK_MAX_TEXTURES];
+	VkWriteDescriptorSet writes[NVGVK_MAX_TEXTURES];
+	int writeCount = 0;
+	int prev = -2;
+
+	for (int i = 0; i < NVGVK_MAX_TEXTURES; i++) {
+		NVGVkTexture* tex = vk->textures[i].image ? &vk->textures[i] : placeholder;
+		if (frame->textureTableSerials[i] == tex->serial) {
+			continue;
+		}
+
+		imageInfos[i].sampler = tex->sampler;
+		imageInfos[i].imageView = tex->imageView;
+		imageInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		frame->textureTableSerials[i] = tex->serial;
+
+		if (prev == i - 1) {
+			writes[writeCount - 1].descriptorCount++;
+		} else {
+			VkWriteDescriptorSet* write = &writes[writeCount++];
+			memset(write, 0, sizeof(*write));
+			write->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			write->dstSet = frame->textureTableSet;
+			write->dstBinding = 0;
+			write->dstArrayElement = (uint32_t)i;
+			write->descriptorCount = 1;
+			write->descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			write->pImageInfo = &imageInfos[i];
+		}
+		prev = i;
+	}
+
+	if (writeCount > 0) {
+		vkUpdateDescriptorSets(vk->device, (uint32_t)writeCount, writes, 0, NULL);
+		vk->counters.descriptorWrites++;
+	}
 	return 1;
 }
 
 // Destroy texture descriptor system
 void nvgvk__destroy_texture_descriptors(NVGVkContext* vk)
 {
+	// Frees every frame's table set
+	if (vk->textureTablePool) {
+		vkDestroyDescriptorPool(vk->device, vk->textureTablePool, NULL);
+		vk->textureTablePool = VK_NULL_HANDLE;
+	}
+	for (int i = 0; i < vk->frameCount; i++) {
+		vk->frames[i].textureTableSet = VK_NULL_HANDLE;
+	}
+	if (vk->textureTableLayout) {
+		vkDestroyDescriptorSetLayout(vk->device, vk->textureTableLayout, NULL);
+		vk->textureTableLayout = VK_NULL_HANDLE;
+	}
 	if (vk->textureDescriptorPool) {
 		vkDestroyDescriptorPool(vk->device, vk->textureDescriptorPool, NULL);
 		vk->textureDescriptorPool = VK_NULL_HANDLE;
@@ -144,7 +268,7 @@ int nvgvk__allocate_texture_descriptor_set(NVGVkContext* vk, NVGVkTexture* tex)
 	writes[0].dstSet = tex->descriptorSet;
 	writes[0].dstBinding = 0;
 	writes[0].descriptorCount = 1;
-	writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 	writes[0].pBufferInfo = &bufferInfo;
 
 	// Texture sampler
@@ -156,6 +280,7 @@ int nvgvk__allocate_texture_descriptor_set(NVGVkContext* vk, NVGVkTexture* tex)
 	writes[1].pImageInfo = &imageInfo;
 
 	vkUpdateDescriptorSets(vk->device, 2, writes, 0, NULL);
+	vk->counters.descriptorWrites++;
 
 	return 1;
 }
@@ -219,7 +344,6 @@ int nvgvk_create_texture(void* userPtr, int type, int w, int h,
 	tex->flags = imageFlags;
 
 	VkFormat format = nvgvk__get_vk_format(type);
-	int bytesPerPixel = (type == NVG_TEXTURE_RGBA || type == 3) ? 4 : 1;  // RGBA/MSDF=4, ALPHA=1
 
 	// Create image
 	VkImageCreateInfo imageInfo = {0};
@@ -245,21 +369,14 @@ int nvgvk_create_texture(void* userPtr, int type, int w, int h,
 	VkMemoryRequirements memReq;
 	vkGetImageMemoryRequirements(vk->device, tex->image, &memReq);
 
-	VkMemoryAllocateInfo allocInfo = {0};
-	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	allocInfo.allocationSize = memReq.size;
-	allocInfo.memoryTypeIndex = nvgvk__find_memory_type(vk, memReq.memoryTypeBits,
-	                                                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-	if (allocInfo.memoryTypeIndex == UINT32_MAX ||
-	    vkAllocateMemory(vk->device, &allocInfo, NULL, &tex->memory) != VK_SUCCESS) {
+	if (!nvgvk_memory_alloc(vk, &memReq, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0, &tex->allocation)) {
 		fprintf(stderr, "NanoVG Vulkan: Failed to allocate image memory\n");
 		vkDestroyImage(vk->device, tex->image, NULL);
 		tex->image = VK_NULL_HANDLE;
 		return -1;
 	}
 
-	vkBindImageMemory(vk->device, tex->image, tex->memory, 0);
+	vkBindImageMemory(vk->device, tex->image, tex->allocation.memory, tex->allocation.offset);
 
 	// Create image view
 	VkImageViewCreateInfo viewInfo = {0};
@@ -273,7 +390,7 @@ int nvgvk_create_texture(void* userPtr, int type, int w, int h,
 
 	if (vkCreateImageView(vk->device, &viewInfo, NULL, &tex->imageView) != VK_SUCCESS) {
 		fprintf(stderr, "NanoVG Vulkan: Failed to create image view\n");
-		vkFreeMemory(vk->device, tex->memory, NULL);
+		nvgvk_memory_free(vk, &tex->allocation);
 		vkDestroyImage(vk->device, tex->image, NULL);
 		tex->image = VK_NULL_HANDLE;
 		return -1;
@@ -282,7 +399,7 @@ int nvgvk_create_texture(void* userPtr, int type, int w, int h,
 	// Create sampler
 	if (!nvgvk__create_sampler(vk, tex, imageFlags)) {
 		vkDestroyImageView(vk->device, tex->imageView, NULL);
-		vkFreeMemory(vk->device, tex->memory, NULL);
+		nvgvk_memory_free(vk, &tex->allocation);
 		vkDestroyImage(vk->device, tex->image, NULL);
 		tex->image = VK_NULL_HANDLE;
 		return -1;
@@ -296,20 +413,20 @@ int nvgvk_create_texture(void* userPtr, int type, int w, int h,
 			return -1;
 		}
 	} else {
-		// Clear texture to prevent undefined/garbage content
-		printf("[nvgvk_create_texture] Clearing %dx%d atlas texture to zeros\n", w, h);
-		unsigned char* zeros = (unsigned char*)calloc(w * h * bytesPerPixel, 1);
-		if (zeros) {
-			nvgvk_update_texture(userPtr, id + 1, 0, 0, w, h, zeros);
-			free(zeros);
+		// Clear texture to prevent undefined/garbage content (no staging memory needed)
+		if (!nvgvk_upload_clear(vk, id)) {
+			nvgvk_delete_texture(userPtr, id + 1);
+			return -1;
 		}
 	}
 
-	// Allocate and initialize descriptor set for this texture
-	if (!nvgvk__allocate_texture_descriptor_set(vk, tex)) {
+	// Allocate and initialize descriptor set for this texture (bindless: written into
+	// each frame's table at its next flush)
+	if (!vk->bindless && !nvgvk__allocate_texture_descriptor_set(vk, tex)) {
 		nvgvk_delete_texture(userPtr, id + 1);
 		return -1;
 	}
+	tex->serial = ++vk->textureSerial;
 
 	// NanoVG uses 1-based texture IDs (0 = failure)
 	return id + 1;
@@ -329,25 +446,11 @@ void nvgvk_delete_texture(void* userPtr, int image)
 		return;
 	}
 
-	vkDeviceWaitIdle(vk->device);
-
-	// Note: descriptor sets are automatically freed when pool is destroyed or reset
-	// No need to explicitly free individual descriptor sets
+	// Pending transfers must not touch the destroyed image
+	nvgvk_upload_discard_texture(vk, id);
 
-	if (tex->sampler) {
-		vkDestroySampler(vk->device, tex->sampler, NULL);
-	}
-	if (tex->imageView) {
-		vkDestroyImageView(vk->device, tex->imageView, NULL);
-	}
-	if (tex->memory) {
-		vkFreeMemory(vk->device, tex->memory, NULL);
-	}
-	if (tex->image) {
-		vkDestroyImage(vk->device, tex->image, NULL);
-	}
-
-	memset(tex, 0, sizeof(NVGVkTexture));
+	// Frames in flight may still sample the image; it is destroyed once they complete
+	nvgvk_release_texture(vk, tex);
 	vk->textureCount--;
 }
 
@@ -369,164 +472,10 @@ int nvgvk_update_texture(void* userPtr, int image, int x, int y,
 	int bytesPerPixel = (tex->type == NVG_TEXTURE_RGBA || tex->type == NVG_TEXTURE_MSDF || tex->type == NVG_TEXTURE_LCD_SUBPIXEL) ? 4 : 1;
 	VkDeviceSize dataSize = w * h * bytesPerPixel;
 
-	// Create staging buffer
-	NVGVkBuffer stagingBuffer;
-	if (!nvgvk_buffer_create(vk, &stagingBuffer, dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT)) {
-		return 0;
-	}
-
-	// Copy data to staging buffer
-	memcpy(stagingBuffer.mapped, data, dataSize);
-
-	// If we're in a render pass, end it temporarily and flush
-	int wasInRenderPass = vk->inRenderPass;
-	VkRenderPass savedRenderPass = VK_NULL_HANDLE;
-	VkFramebuffer savedFramebuffer = VK_NULL_HANDLE;
-
-	if (wasInRenderPass) {
-		savedRenderPass = vk->activeRenderPass;
-		savedFramebuffer = vk->activeFramebuffer;
-		vkCmdEndRenderPass(vk->commandBuffer);
-		vkEndCommandBuffer(vk->commandBuffer);
-
-		// Submit rendering commands and wait for completion
-		VkSubmitInfo submitInfo = {0};
-		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-		submitInfo.commandBufferCount = 1;
-		submitInfo.pCommandBuffers = &vk->commandBuffer;
-
-		// Submit without fence and use QueueWaitIdle to avoid fence state conflicts
-		vkQueueSubmit(vk->queue, 1, &submitInfo, VK_NULL_HANDLE);
-		vkQueueWaitIdle(vk->queue);
-
-		vk->inRenderPass = 0;
-	}
-
-	// Allocate temporary command buffer for upload
-	VkCommandBuffer uploadCmd;
-	VkCommandBufferAllocateInfo allocInfo = {0};
-	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-	allocInfo.commandPool = vk->commandPool;
-	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-	allocInfo.commandBufferCount = 1;
-
-	if (vkAllocateCommandBuffers(vk->device, &allocInfo, &uploadCmd) != VK_SUCCESS) {
-		nvgvk_buffer_destroy(vk, &stagingBuffer);
-		return 0;
-	}
-
-	// Record commands for image upload
-	VkCommandBufferBeginInfo beginInfo = {0};
-	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-	vkBeginCommandBuffer(uploadCmd, &beginInfo);
-
-	// Transition to transfer dst
-	VkImageMemoryBarrier barrier = {0};
-	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	// If texture was already used, it's in SHADER_READ_ONLY_OPTIMAL, otherwise UNDEFINED
-	barrier.oldLayout = (tex->flags & 0x8000) ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
-	printf("[LAYOUT] Texture %d transition: %s -> TRANSFER_DST\n",
-		id, (tex->flags & 0x8000) ? "SHADER_READ" : "UNDEFINED");
-	barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier.image = tex->image;
-	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	barrier.subresourceRange.levelCount = 1;
-	barrier.subresourceRange.layerCount = 1;
-	// Synchronize previous shader reads before starting transfer write
-	barrier.srcAccessMask = (tex->flags & 0x8000) ? VK_ACCESS_SHADER_READ_BIT : 0;
-	barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-	vkCmdPipelineBarrier(uploadCmd,
-	                     (tex->flags & 0x8000) ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-	                     VK_PIPELINE_STAGE_TRANSFER_BIT,
-	                     0, 0, NULL, 0, NULL, 1, &barrier);
-
-	// Copy buffer to image
-	VkBufferImageCopy region = {0};
-	region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	region.imageSubresource.layerCount = 1;
-	region.imageOffset.x = x;
-	region.imageOffset.y = y;
-	region.imageExtent.width = w;
-	region.imageExtent.height = h;
-	region.imageExtent.depth = 1;
-
-	vkCmdCopyBufferToImage(uploadCmd, stagingBuffer.buffer, tex->image,
-	                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-	// Transition to shader read
-	barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-	barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-	printf("[LAYOUT] Texture %d transition: TRANSFER_DST -> SHADER_READ\n", id);
-
-	vkCmdPipelineBarrier(uploadCmd,
-	                     VK_PIPELINE_STAGE_TRANSFER_BIT,
-	                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-	                     0, 0, NULL, 0, NULL, 1, &barrier);
-
-	vkEndCommandBuffer(uploadCmd);
-
-	// Mark texture as initialized
-	tex->flags |= 0x8000;
-
-	// Submit upload commands with fence for synchronization
-	VkSubmitInfo submitInfo = {0};
-	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-	submitInfo.commandBufferCount = 1;
-	submitInfo.pCommandBuffers = &uploadCmd;
-
-	// Reset fence before submitting (fence was signaled by render submit above)
-	vkResetFences(vk->device, 1, &vk->uploadFence);
-	vkQueueSubmit(vk->queue, 1, &submitInfo, vk->uploadFence);
-
-	// Wait for upload to complete before cleanup
-	vkWaitForFences(vk->device, 1, &vk->uploadFence, VK_TRUE, UINT64_MAX);
-
-	// Cleanup
-	vkFreeCommandBuffers(vk->device, vk->commandPool, 1, &uploadCmd);
-	nvgvk_buffer_destroy(vk, &stagingBuffer);
-
-	// If we were in a render pass, restart the command buffer and render pass
-	if (wasInRenderPass) {
-		static int restart_count = 0;
-		printf("[RENDER PASS RESTART #%d]\n", ++restart_count);
-
-		VkCommandBufferBeginInfo restartBegin = {0};
-		restartBegin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		restartBegin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-		vkBeginCommandBuffer(vk->commandBuffer, &restartBegin);
-
-		// Restart render pass with saved info
-		VkRenderPassBeginInfo rpBeginInfo = {0};
-		rpBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		rpBeginInfo.renderPass = savedRenderPass;
-		rpBeginInfo.framebuffer = savedFramebuffer;
-		rpBeginInfo.renderArea = vk->renderArea;
-		rpBeginInfo.clearValueCount = vk->clearValueCount;
-		rpBeginInfo.pClearValues = vk->clearValues;
-
-		vkCmdBeginRenderPass(vk->commandBuffer, &rpBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-		vk->inRenderPass = 1;
-
-		// Restore viewport and scissor state
-		vkCmdSetViewport(vk->commandBuffer, 0, 1, &vk->viewport);
-		vkCmdSetScissor(vk->commandBuffer, 0, 1, &vk->scissor);
-
-		// DO NOT rebind vertex buffer here - it will be bound in flush after vertices are uploaded
-		printf("[RESTART] Skipping vertex buffer rebind (%d vertices accumulated so far)\n",
-		       vk->vertexCount);
-
-		// Invalidate pipeline state - command buffer was restarted so bindings are lost
-		vk->currentPipeline = -1;
-	}
-
-	return 1;
+	// Stage into this frame's ring slot. The copy and its barriers are recorded
+	// with the rest of the frame's transfers at flush, before the render pass
+	// work that samples the texture, so the open render pass is left untouched.
+	return nvgvk_upload_image(vk, id, x, y, w, h, data, dataSize);
 }
 
 int nvgvk_get_texture_size(void* userPtr, int image, int* w, int* h)
@@ -568,172 +517,6 @@ int nvgvk_copy_texture(void* userPtr, int srcImage, int dstImage,
 		return 0;
 	}
 
-	// Save render pass state if active
-	int wasInRenderPass = vk->inRenderPass;
-	VkRenderPass savedRenderPass = VK_NULL_HANDLE;
-	VkFramebuffer savedFramebuffer = VK_NULL_HANDLE;
-
-	if (wasInRenderPass) {
-		savedRenderPass = vk->activeRenderPass;
-		savedFramebuffer = vk->activeFramebuffer;
-
-		// End render pass
-		vkCmdEndRenderPass(vk->commandBuffer);
-		vkEndCommandBuffer(vk->commandBuffer);
-
-		// Submit and wait
-		VkSubmitInfo submitInfo = {0};
-		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-		submitInfo.commandBufferCount = 1;
-		submitInfo.pCommandBuffers = &vk->commandBuffer;
-
-		vkQueueSubmit(vk->queue, 1, &submitInfo, VK_NULL_HANDLE);
-		vkQueueWaitIdle(vk->queue);
-
-		vk->inRenderPass = 0;
-	}
-
-	// Allocate temporary command buffer for copy
-	VkCommandBuffer copyCmd;
-	VkCommandBufferAllocateInfo allocInfo = {0};
-	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-	allocInfo.commandPool = vk->commandPool;
-	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-	allocInfo.commandBufferCount = 1;
-
-	if (vkAllocateCommandBuffers(vk->device, &allocInfo, &copyCmd) != VK_SUCCESS) {
-		return 0;
-	}
-
-	// Begin command buffer
-	VkCommandBufferBeginInfo beginInfo = {0};
-	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-	vkBeginCommandBuffer(copyCmd, &beginInfo);
-
-	// Transition source to transfer src
-	VkImageMemoryBarrier srcBarrier = {0};
-	srcBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	srcBarrier.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	srcBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-	srcBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	srcBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	srcBarrier.image = srcTex->image;
-	srcBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	srcBarrier.subresourceRange.levelCount = 1;
-	srcBarrier.subresourceRange.layerCount = 1;
-	srcBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-	srcBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-
-	vkCmdPipelineBarrier(copyCmd,
-	                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-	                     VK_PIPELINE_STAGE_TRANSFER_BIT,
-	                     0, 0, NULL, 0, NULL, 1, &srcBarrier);
-
-	// Transition dest to transfer dst
-	VkImageMemoryBarrier dstBarrier = {0};
-	dstBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	dstBarrier.oldLayout = (dstTex->flags & 0x8000) ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
-	dstBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-	dstBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	dstBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	dstBarrier.image = dstTex->image;
-	dstBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	dstBarrier.subresourceRange.levelCount = 1;
-	dstBarrier.subresourceRange.layerCount = 1;
-	dstBarrier.srcAccessMask = (dstTex->flags & 0x8000) ? VK_ACCESS_SHADER_READ_BIT : 0;
-	dstBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-	vkCmdPipelineBarrier(copyCmd,
-	                     (dstTex->flags & 0x8000) ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-	                     VK_PIPELINE_STAGE_TRANSFER_BIT,
-	                     0, 0, NULL, 0, NULL, 1, &dstBarrier);
-
-	// Copy image region
-	VkImageCopy region = {0};
-	region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	region.srcSubresource.layerCount = 1;
-	region.srcOffset.x = srcX;
-	region.srcOffset.y = srcY;
-	region.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	region.dstSubresource.layerCount = 1;
-	region.dstOffset.x = dstX;
-	region.dstOffset.y = dstY;
-	region.extent.width = w;
-	region.extent.height = h;
-	region.extent.depth = 1;
-
-	vkCmdCopyImage(copyCmd,
-	               srcTex->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-	               dstTex->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	               1, &region);
-
-	// Transition source back to shader read
-	srcBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-	srcBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	srcBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-	srcBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-	vkCmdPipelineBarrier(copyCmd,
-	                     VK_PIPELINE_STAGE_TRANSFER_BIT,
-	                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-	                     0, 0, NULL, 0, NULL, 1, &srcBarrier);
-
-	// Transition dest to shader read
-	dstBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-	dstBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	dstBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-	dstBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-	vkCmdPipelineBarrier(copyCmd,
-	                     VK_PIPELINE_STAGE_TRANSFER_BIT,
-	                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-	                     0, 0, NULL, 0, NULL, 1, &dstBarrier);
-
-	vkEndCommandBuffer(copyCmd);
-
-	// Mark dest texture as initialized
-	dstTex->flags |= 0x8000;
-
-	// Submit copy commands
-	VkSubmitInfo submitInfo = {0};
-	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-	submitInfo.commandBufferCount = 1;
-	submitInfo.pCommandBuffers = &copyCmd;
-
-	vkResetFences(vk->device, 1, &vk->uploadFence);
-	vkQueueSubmit(vk->queue, 1, &submitInfo, vk->uploadFence);
-
-	// Wait for copy to complete
-	vkWaitForFences(vk->device, 1, &vk->uploadFence, VK_TRUE, UINT64_MAX);
-
-	// Free temporary command buffer
-	vkFreeCommandBuffers(vk->device, vk->commandPool, 1, &copyCmd);
-
-	// Restart render pass if needed
-	if (wasInRenderPass) {
-		VkCommandBufferBeginInfo restartBegin = {0};
-		restartBegin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		restartBegin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-		vkBeginCommandBuffer(vk->commandBuffer, &restartBegin);
-
-		VkRenderPassBeginInfo rpBeginInfo = {0};
-		rpBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		rpBeginInfo.renderPass = savedRenderPass;
-		rpBeginInfo.framebuffer = savedFramebuffer;
-		rpBeginInfo.renderArea = vk->renderArea;
-		rpBeginInfo.clearValueCount = vk->clearValueCount;
-		rpBeginInfo.pClearValues = vk->clearValues;
-
-		vkCmdBeginRenderPass(vk->commandBuffer, &rpBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-		vk->inRenderPass = 1;
-
-		vkCmdSetViewport(vk->commandBuffer, 0, 1, &vk->viewport);
-		vkCmdSetScissor(vk->commandBuffer, 0, 1, &vk->scissor);
-
-		vk->currentPipeline = -1;
-	}
-
-	return 1;
+	// Queued behind any pending uploads to the source, recorded at flush
+	return nvgvk_upload_copy_image(vk, srcId, dstId, srcX, srcY, dstX, dstY, w, h);
 }
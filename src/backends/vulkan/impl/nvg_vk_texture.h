@@ -25,4 +25,12 @@ int nvgvk__init_texture_descriptors(NVGVkContext* vk);
 void nvgvk__destroy_texture_descriptors(NVGVkContext* vk);
 int nvgvk__allocate_texture_descriptor_set(NVGVkContext* vk, NVGVkTexture* tex);
 
+// Bindless texture table (vk->bindless): one array of NVGVK_MAX_TEXTURES combined
+// image samplers per frame in flight, bound as set 3 and indexed by the call's
+// image slot in the fragment uniforms. Created by nvgvk__init_texture_descriptors.
+int nvgvk__init_texture_table(NVGVkContext* vk);
+// Write the slots whose texture changed since the frame's set was last written.
+// Call after nvgvk_frame_acquire, before recording.
+int nvgvk_texture_table_update(NVGVkContext* vk, NVGVkFrame* frame);
+
 #endif // NVG_VK_TEXTURE_H
@@ -21,18 +21,61 @@ typedef struct NVGVkShaderSet NVGVkShaderSet;
 
 // Maximum limits
 #define NVGVK_MAX_TEXTURES 256
-#define NVGVK_MAX_CALLS 1024
-#define NVGVK_INITIAL_VERTEX_COUNT 4096
+#define NVGVK_INITIAL_CALL_COUNT 256
+#define NVGVK_VERTEX_CHUNK_SIZE 65536  // Vertices per GPU vertex chunk
+#define NVGVK_DIRECT_VERTEX_SLACK 6     // Room for the fill cover quad after a direct block
 #define NVGVK_INITIAL_INDEX_COUNT 8192
-#define NVGVK_PIPELINE_COUNT 10
+#define NVGVK_PIPELINE_COUNT 15
+#define NVGVK_PIPELINE_BUCKETS 64       // Hash buckets of the pipeline variant cache
+#define NVGVK_DEFAULT_FRAMES_IN_FLIGHT 3
+#define NVGVK_MAX_FRAMES_IN_FLIGHT 8
+#define NVGVK_STAGING_INITIAL_SIZE (256 * 1024)
+#define NVGVK_STAGING_ALIGNMENT 16
+#define NVGVK_INDIRECT_INITIAL_SIZE (64 * 1024)  // 4096 VkDrawIndirectCommands
+#define NVGVK_GLYPH_INITIAL_COUNT 4096       // Glyph instances per frame before the buffer grows
+#define NVGVK_MEMORY_BLOCK_ORDER 25          // log2 of a sub-allocated memory block (32 MB)
+#define NVGVK_MEMORY_MIN_ORDER 12            // log2 of the smallest buddy range (4 KB)
+#define NVGVK_MEMORY_DEDICATED_SIZE (8 * 1024 * 1024)  // Larger requests get their own VkDeviceMemory
+
+// Range of device memory handed out by the sub-allocator (see nvg_vk_memory.h)
+typedef struct NVGVkAllocation {
+	VkDeviceMemory memory;
+	VkDeviceSize offset;
+	VkDeviceSize size;        // Buddy range size (>= requested size)
+	void* mapped;             // Host pointer to offset, NULL unless host-visible
+	int block;                // Index into vk->memory.blocks, -1 = dedicated allocation
+} NVGVkAllocation;
+
+// Large VkDeviceMemory block split with a buddy tree
+typedef struct NVGVkMemoryBlock {
+	VkDeviceMemory memory;    // VK_NULL_HANDLE = free slot
+	void* mapped;             // Persistent mapping of host-visible blocks
+	unsigned char* tree;      // Per node: 1 + log2 of the largest free range below it, 0 = full
+	VkDeviceSize used;
+	uint32_t memoryType;
+	int linear;               // Buffers and optimal images are kept apart (bufferImageGranularity)
+	int allocationCount;
+} NVGVkMemoryBlock;
+
+typedef struct NVGVkMemory {
+	NVGVkMemoryBlock* blocks;
+	int blockCount;
+	int blockCapacity;
+	int allocationCount;      // Live sub-allocations
+	int dedicatedCount;
+	VkDeviceSize dedicatedBytes;
+	VkDeviceSize bufferImageGranularity;
+	VkPhysicalDeviceMemoryProperties properties;
+} NVGVkMemory;
 
 // Texture structure
 struct NVGVkTexture {
 	VkImage image;
 	VkImageView imageView;
-	VkDeviceMemory memory;
+	NVGVkAllocation allocation;
 	VkSampler sampler;
-	VkDescriptorSet descriptorSet;  // Per-texture descriptor set
+	VkDescriptorSet descriptorSet;  // Per-texture descriptor set (not used with the bindless table)
+	uint32_t serial;                // Nonzero while live, unique per texture created in the slot
 	int width;
 	int height;
 	int type;
@@ -42,7 +85,7 @@ struct NVGVkTexture {
 // Buffer structure
 struct NVGVkBuffer {
 	VkBuffer buffer;
-	VkDeviceMemory memory;
+	NVGVkAllocation allocation;
 	void* mapped;
 	VkDeviceSize size;
 	VkDeviceSize capacity;
@@ -65,7 +108,12 @@ struct NVGVkUniforms {
 	float strokeThr;
 	int texType;
 	int type;
-	int _padding[2];  // Explicit padding for alignment
+	int image;        // Texture slot (0-based) indexed in the bindless texture table
+	int shapeType;    // NVGshapeType of NVGVK_SHAPE calls
+	int shapeAntiAlias;
+	int _padding;     // Explicit padding for alignment
+	float xform[8];   // Glyph transform of instanced text, inverse shape transform of NVGVK_SHAPE (a, b, c, d, e, f, -, -)
+	float shape[4];   // NVGVK_SHAPE: half extent, corner radius, stroke half width (0 = fill), all in shape space
 };
 
 // Call type enum
@@ -74,9 +122,29 @@ typedef enum NVGVkCallType {
 	NVGVK_FILL,
 	NVGVK_CONVEXFILL,
 	NVGVK_STROKE,
-	NVGVK_TRIANGLES
+	NVGVK_TRIANGLES,
+	NVGVK_GLYPHS,
+	NVGVK_SHAPE
 } NVGVkCallType;
 
+// NVGVkCall::vertexChunk of glyph calls: their instances live in the frame's glyph buffer
+#define NVGVK_GLYPH_BUFFER (-1)
+
+// Glyph instance of instanced text, one per quad (matches shaders/text_instanced.vert)
+typedef struct NVGVkGlyph {
+	float x, y, w, h;         // Quad in text space, transformed by the call's xform
+	float s0, t0, s1, t1;     // Atlas UV rect
+	uint32_t uniformIndex;    // Call whose NVGVkFragUniforms (and xform) apply
+} NVGVkGlyph;
+
+// Blend factors of a call (converted from NVGcompositeOperationState)
+typedef struct NVGVkBlend {
+	VkBlendFactor srcColor;
+	VkBlendFactor dstColor;
+	VkBlendFactor srcAlpha;
+	VkBlendFactor dstAlpha;
+} NVGVkBlend;
+
 // Render call structure
 struct NVGVkCall {
 	NVGVkCallType type;
@@ -85,8 +153,11 @@ struct NVGVkCall {
 	int pathCount;
 	int triangleOffset;
 	int triangleCount;
+	int glyphOffset;  // First instance in the frame's glyph buffer (NVGVK_GLYPHS)
+	int glyphCount;
 	int uniformOffset;
-	int blendFunc;
+	NVGVkBlend blend;
+	int vertexChunk;  // Index into the frame's vertex chunks, or NVGVK_GLYPH_BUFFER
 };
 
 // Shader set (vertex + fragment)
@@ -95,15 +166,44 @@ struct NVGVkShaderSet {
 	VkShaderModule fragShader;
 };
 
-// Pipeline structure
+// Per pipeline type state; the VkPipelines themselves are variants (see below)
 struct NVGVkPipeline {
-	VkPipeline pipeline;
 	VkPipelineLayout layout;
 	VkDescriptorSetLayout descriptorSetLayout;
 	VkDescriptorPool descriptorPool;
 	VkDescriptorSet descriptorSet;
+	// Bindings last written into descriptorSet (rewritten only when they change)
+	VkBuffer writtenBuffer;
+	VkImageView writtenImageView;
+	VkSampler writtenSampler;
 };
 
+// Command and descriptor counters of one flush (see nvgVkGetRenderStats)
+typedef struct NVGVkCounters {
+	int calls;                    // NanoVG render calls
+	int draws;                    // vkCmdDraw / vkCmdDrawIndirect recorded
+	int pipelineBinds;
+	int pipelineBindsSkipped;     // Requested pipeline was already bound
+	int descriptorBinds;
+	int descriptorBindsSkipped;   // Requested set was already bound
+	int descriptorWrites;         // vkUpdateDescriptorSets calls
+	int vertexBufferBinds;
+} NVGVkCounters;
+
+// Everything a graphics pipeline is specialised on
+typedef struct NVGVkPipelineKey {
+	int type;                   // NVGVkPipelineType: shaders, stencil mode and topology
+	NVGVkBlend blend;
+	VkRenderPass renderPass;    // Fixes color format and sample count
+} NVGVkPipelineKey;
+
+// Pipeline created on first use for one key
+typedef struct NVGVkPipelineVariant {
+	NVGVkPipelineKey key;
+	VkPipeline pipeline;
+	int next;                   // Next variant in the hash bucket, 1-based (0 = end)
+} NVGVkPipelineVariant;
+
 // Path structure
 typedef struct NVGVkPath {
 	int fillOffset;
@@ -112,7 +212,8 @@ typedef struct NVGVkPath {
 	int strokeCount;
 } NVGVkPath;
 
-// Fragment uniform structure (for push constants or UBO)
+// Fragment uniform structure, one entry per call in the frame's uniform storage
+// buffer (std430, matches shaders/frag_uniforms.glsl)
 typedef struct NVGVkFragUniforms {
 	float scissorMat[12];
 	float paintMat[12];
@@ -127,8 +228,67 @@ typedef struct NVGVkFragUniforms {
 	float strokeThr;
 	int texType;
 	int type;
+	int image;
+	int shapeType;
+	int shapeAntiAlias;
+	int _padding;
+	float xform[8];
+	float shape[4];
 } NVGVkFragUniforms;
 
+// Pending transfer operation type
+typedef enum NVGVkUploadType {
+	NVGVK_UPLOAD_BUFFER_TO_IMAGE = 0,
+	NVGVK_UPLOAD_IMAGE_TO_IMAGE,
+	NVGVK_UPLOAD_CLEAR
+} NVGVkUploadType;
+
+// Pending transfer operation (recorded before the render pass, in issue order)
+typedef struct NVGVkUpload {
+	NVGVkUploadType type;
+	int dstTexture;             // 0-based texture index
+	int srcTexture;             // IMAGE_TO_IMAGE only
+	VkDeviceSize bufferOffset;  // BUFFER_TO_IMAGE only, offset into staging buffer
+	int srcX, srcY;
+	int x, y, w, h;
+} NVGVkUpload;
+
+// Per-frame resources (one ring slot per frame in flight)
+typedef struct NVGVkFrame {
+	NVGVkBuffer* vertexChunks;            // Vertex data, chunks kept at high-water count. Each
+	                                      // buffer holds capacity bytes of vertices followed by
+	                                      // one uint32_t uniform index per vertex
+	int vertexChunkCount;
+	int vertexChunkCapacity;
+	int vertexChunk;                      // Chunk currently being filled
+	NVGVkBuffer stagingBuffer;            // Texture upload staging, grows to high-water mark
+	VkCommandBuffer uploadCommandBuffer;  // Transfer commands submitted ahead of the frame
+	VkFence fence;                        // Signaled when all work of this frame has completed
+	VkDeviceSize uniformOffset;           // Dynamic offset of this frame's region in uniformBuffer
+	NVGVkBuffer indirectBuffer;           // VkDrawIndirectCommand batches, grows to high-water mark
+	NVGVkBuffer glyphBuffer;              // NVGVkGlyph instances, grows to high-water mark
+	NVGVkBuffer uniformStorage;           // NVGVkFragUniforms of every call (set 2)
+	VkDescriptorSet uniformStorageSet;
+	VkBuffer uniformStorageBound;         // Buffer uniformStorageSet currently points at
+	VkDescriptorSet textureTableSet;      // Bindless texture table (set 3), allocated on first use
+	uint32_t textureTableSerials[NVGVK_MAX_TEXTURES];  // Texture serial written per slot (0 = none)
+	int uploadsSubmitted;                 // Upload command buffer is in flight
+	int pending;                          // Frame flushed, fence not submitted yet
+	int submitted;                        // Fence submitted, wait on it before reuse
+	uint64_t serial;                      // Serial of the frame last recorded into this slot
+} NVGVkFrame;
+
+// Released resource waiting for the frames that may still use it (see nvg_vk_frame.h)
+typedef struct NVGVkGarbage {
+	uint64_t serial;                      // Last frame serial that may reference the resource
+	VkImage image;
+	VkImageView imageView;
+	VkSampler sampler;
+	VkDescriptorSet descriptorSet;        // Freed back to textureDescriptorPool
+	VkBuffer buffer;
+	NVGVkAllocation allocation;
+} NVGVkGarbage;
+
 // Color space conversion uniform buffer (shared across all draws)
 typedef struct NVGVkColorSpaceUniforms {
 	NVGVkMat3 gamutMatrix;		// 36 bytes (3x3 float matrix)
@@ -149,8 +309,8 @@ struct NVGVkContext {
 	VkCommandPool commandPool;
 
 	// Owned resources
-	VkCommandBuffer commandBuffer;
-	VkFence uploadFence;  // Fence for texture upload synchronization
+	VkCommandBuffer commandBuffer;          // Command buffer draws are recorded into
+	VkCommandBuffer ownedCommandBuffer;     // Default commandBuffer, replaced by nvgVkSetCommandBuffer
 
 	// Render pass state (not owned, just tracked)
 	VkRenderPass activeRenderPass;
@@ -167,32 +327,91 @@ struct NVGVkContext {
 
 	// Pipelines
 	NVGVkPipeline pipelines[NVGVK_PIPELINE_COUNT];
-	int currentPipeline;
+	VkPipeline currentPipeline;             // Last pipeline bound in commandBuffer
+	VkDescriptorSet currentDescriptorSet;   // Last set 0 bound in commandBuffer
+	int currentPipelineStrip;               // Bound pipeline draws triangle strips
+	VkRenderPass renderPass;                // Render pass the pipelines are compatible with
+
+	// Draws batched under the bound state (see nvgvk_draw)
+	VkDrawIndirectCommand* draws;
+	int drawCount;
+	int drawCapacity;
+	int multiDrawIndirect;                  // Submit batches with one vkCmdDrawIndirect
+	uint32_t maxDrawIndirectCount;
+	int bindless;                           // Textures are indexed in the bindless table (set 3)
 
-	// Buffers
-	NVGVkBuffer vertexBuffer;
+	// Counters of the flush being recorded (including descriptor writes since the
+	// previous flush) and of the last completed flush
+	NVGVkCounters counters;
+	NVGVkCounters flushCounters;
+
+	// Fragment uniform storage (set 2, one descriptor set per frame)
+	VkDescriptorSetLayout uniformStorageLayout;
+	VkDescriptorPool uniformStoragePool;
+
+	// Pipeline variant cache (created lazily, see nvg_vk_pipeline.h)
+	NVGVkPipelineVariant* pipelineVariants;
+	int pipelineVariantCount;
+	int pipelineVariantCapacity;
+	int pipelineBuckets[NVGVK_PIPELINE_BUCKETS];  // First variant per bucket, 1-based (0 = empty)
+	VkPipelineCache pipelineCache;          // Seeded from a previous run, see nvg_vk_pipeline.h
+	char* pipelineCachePath;                // Written back on delete (NULL = not persisted)
+
+	// Device memory blocks shared by buffers and textures
+	NVGVkMemory memory;
+
+	// Frames in flight (vertex/uniform/staging regions guarded by per-frame fences)
+	NVGVkFrame frames[NVGVK_MAX_FRAMES_IN_FLIGHT];
+	int frameCount;
+	int frameIndex;
+	uint64_t frameSerial;                   // Serial of the frame being recorded (starts at 1)
+	uint64_t completedSerial;               // All frames up to this serial have completed
+
+	// Deferred destruction queue, in release (serial) order
+	NVGVkGarbage* garbage;
+	int garbageCount;
+	int garbageCapacity;
+
+	// Uniform buffer (viewSize), one aligned region per frame in flight
 	NVGVkBuffer uniformBuffer;
+	VkDeviceSize uniformStride;
 
 	// Texture descriptor resources
 	VkDescriptorSetLayout textureDescriptorSetLayout;
 	VkDescriptorPool textureDescriptorPool;
+	VkDescriptorSetLayout textureTableLayout;   // Bindless table, one set per frame in flight
+	VkDescriptorPool textureTablePool;
+	uint32_t textureSerial;                     // Last NVGVkTexture::serial handed out
 
 	// Textures
 	NVGVkTexture textures[NVGVK_MAX_TEXTURES];
 	int textureCount;
 
-	// Render state
-	NVGVkCall calls[NVGVK_MAX_CALLS];
+	// Pending texture transfers (batched per frame)
+	NVGVkUpload* uploads;
+	int uploadCount;
+	int uploadCapacity;
+
+	// Render state (per-frame arena, see nvg_vk_arena.h)
+	NVGVkCall* calls;
 	int callCount;
-	NVGVkPath paths[NVGVK_MAX_CALLS];
+	int callCapacity;
+	NVGVkPath* paths;
 	int pathCount;
-	NVGVkUniforms uniforms[NVGVK_MAX_CALLS];
+	int pathCapacity;
+	NVGVkUniforms* uniforms;
 	int uniformCount;
+	int uniformCapacity;
 
-	// Vertex data
-	float* vertices;
+	// Vertices recorded this frame (stored in the frame's vertex chunks)
 	int vertexCount;
-	int vertexCapacity;
+
+	// Last block handed to the front end for zero-copy vertex output
+	NVGvertex* directVerts;
+	int directChunk;
+	int directOffset;
+	int directCount;  // Reserved vertices (including NVGVK_DIRECT_VERTEX_SLACK)
+	int directUsed;   // End of the highest vertex referenced by a render call
 
 	// View state
 	float viewWidth;
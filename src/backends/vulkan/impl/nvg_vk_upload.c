@@ -0,0 +1,361 @@
+#include "nvg_vk_upload.h"
+#include "nvg_vk_buffer.h"
+#include "nvg_vk_frame.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Per-texture layout tracking while recording a batch
+typedef struct NVGVkUploadTrack {
+	int texId;
+	VkImageLayout layout;
+	VkAccessFlags access;
+	int x0, y0, x1, y1;  // Union of regions written since the last barrier
+} NVGVkUploadTrack;
+
+void nvgvk_upload_destroy(NVGVkContext* vk)
+{
+	if (vk->uploads) {
+		free(vk->uploads);
+		vk->uploads = NULL;
+	}
+	vk->uploadCount = 0;
+	vk->uploadCapacity = 0;
+}
+
+// Helper: Append a pending operation
+static NVGVkUpload* nvgvk__alloc_upload(NVGVkContext* vk)
+{
+	if (vk->uploadCount + 1 > vk->uploadCapacity) {
+		int capacity = vk->uploadCapacity > 0 ? vk->uploadCapacity * 2 : 64;
+		NVGVkUpload* uploads = (NVGVkUpload*)realloc(vk->uploads, sizeof(NVGVkUpload) * capacity);
+		if (!uploads) {
+			fprintf(stderr, "NanoVG Vulkan: Failed to grow upload queue\n");
+			return NULL;
+		}
+		vk->uploads = uploads;
+		vk->uploadCapacity = capacity;
+	}
+
+	NVGVkUpload* upload = &vk->uploads[vk->uploadCount++];
+	memset(upload, 0, sizeof(NVGVkUpload));
+	return upload;
+}
+
+int nvgvk_upload_image(NVGVkContext* vk, int texId, int x, int y, int w, int h,
+                       const unsigned char* data, VkDeviceSize dataSize)
+{
+	NVGVkFrame* frame = nvgvk_frame_acquire(vk);
+
+	// Offsets must be a multiple of the texel size and of 4 for vkCmdCopyBufferToImage
+	VkDeviceSize offset = (frame->stagingBuffer.size + NVGVK_STAGING_ALIGNMENT - 1) & ~(VkDeviceSize)(NVGVK_STAGING_ALIGNMENT - 1);
+
+	// Growing replaces the buffer; the old one is released behind this frame's fence
+	if (!nvgvk_buffer_reserve(vk, &frame->stagingBuffer, offset + dataSize)) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to grow staging buffer\n");
+		return 0;
+	}
+
+	memcpy((unsigned char*)frame->stagingBuffer.mapped + offset, data, dataSize);
+	frame->stagingBuffer.size = offset + dataSize;
+
+	NVGVkUpload* upload = nvgvk__alloc_upload(vk);
+	if (!upload) {
+		return 0;
+	}
+	upload->type = NVGVK_UPLOAD_BUFFER_TO_IMAGE;
+	upload->dstTexture = texId;
+	upload->srcTexture = -1;
+	upload->bufferOffset = offset;
+	upload->x = x;
+	upload->y = y;
+	upload->w = w;
+	upload->h = h;
+
+	return 1;
+}
+
+int nvgvk_upload_clear(NVGVkContext* vk, int texId)
+{
+	NVGVkUpload* upload = nvgvk__alloc_upload(vk);
+	if (!upload) {
+		return 0;
+	}
+	upload->type = NVGVK_UPLOAD_CLEAR;
+	upload->dstTexture = texId;
+	upload->srcTexture = -1;
+	upload->w = vk->textures[texId].width;
+	upload->h = vk->textures[texId].height;
+
+	return 1;
+}
+
+int nvgvk_upload_copy_image(NVGVkContext* vk, int srcTexId, int dstTexId,
+                            int srcX, int srcY, int dstX, int dstY, int w, int h)
+{
+	NVGVkUpload* upload = nvgvk__alloc_upload(vk);
+	if (!upload) {
+		return 0;
+	}
+	upload->type = NVGVK_UPLOAD_IMAGE_TO_IMAGE;
+	upload->dstTexture = dstTexId;
+	upload->srcTexture = srcTexId;
+	upload->srcX = srcX;
+	upload->srcY = srcY;
+	upload->x = dstX;
+	upload->y = dstY;
+	upload->w = w;
+	upload->h = h;
+
+	return 1;
+}
+
+void nvgvk_upload_discard_texture(NVGVkContext* vk, int texId)
+{
+	int n = 0;
+	for (int i = 0; i < vk->uploadCount; i++) {
+		NVGVkUpload* upload = &vk->uploads[i];
+		if (upload->dstTexture == texId || upload->srcTexture == texId) {
+			continue;
+		}
+		vk->uploads[n++] = *upload;
+	}
+	vk->uploadCount = n;
+}
+
+// Helper: Find or add tracking state for a texture
+static NVGVkUploadTrack* nvgvk__track(NVGVkContext* vk, NVGVkUploadTrack* tracks, int* ntracks, int texId)
+{
+	for (int i = 0; i < *ntracks; i++) {
+		if (tracks[i].texId == texId) {
+			return &tracks[i];
+		}
+	}
+
+	NVGVkUploadTrack* track = &tracks[(*ntracks)++];
+	memset(track, 0, sizeof(NVGVkUploadTrack));
+	track->texId = texId;
+	// 0x8000 marks textures that are already in SHADER_READ_ONLY_OPTIMAL
+	if (vk->textures[texId].flags & 0x8000) {
+		track->layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		track->access = VK_ACCESS_SHADER_READ_BIT;
+	} else {
+		track->layout = VK_IMAGE_LAYOUT_UNDEFINED;
+		track->access = 0;
+	}
+	return track;
+}
+
+// Helper: Fill a layout transition barrier for a tracked texture
+static void nvgvk__fill_barrier(NVGVkContext* vk, VkImageMemoryBarrier* barrier, NVGVkUploadTrack* track,
+                                VkImageLayout newLayout, VkAccessFlags newAccess)
+{
+	memset(barrier, 0, sizeof(VkImageMemoryBarrier));
+	barrier->sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier->oldLayout = track->layout;
+	barrier->newLayout = newLayout;
+	barrier->srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier->image = vk->textures[track->texId].image;
+	barrier->subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	barrier->subresourceRange.levelCount = 1;
+	barrier->subresourceRange.layerCount = 1;
+	barrier->srcAccessMask = track->access;
+	barrier->dstAccessMask = newAccess;
+
+	track->layout = newLayout;
+	track->access = newAccess;
+	track->x0 = track->y0 = track->x1 = track->y1 = 0;
+}
+
+// Helper: Make sure a tracked texture is in the layout a transfer needs.
+// Also orders back-to-back writes to overlapping regions of the same image.
+static void nvgvk__require_layout(NVGVkContext* vk, VkCommandBuffer cmd, NVGVkUploadTrack* track,
+                                  VkImageLayout layout, VkAccessFlags access,
+                                  int x, int y, int w, int h)
+{
+	int overlaps = track->layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL &&
+	               layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL &&
+	               x < track->x1 && track->x0 < x + w && y < track->y1 && track->y0 < y + h;
+
+	if (track->layout != layout || overlaps) {
+		VkImageMemoryBarrier barrier;
+		nvgvk__fill_barrier(vk, &barrier, track, layout, access);
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		                     0, 0, NULL, 0, NULL, 1, &barrier);
+	}
+
+	if (layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
+		if (track->x1 == track->x0 || track->y1 == track->y0) {
+			track->x0 = x; track->y0 = y;
+			track->x1 = x + w; track->y1 = y + h;
+		} else {
+			if (x < track->x0) track->x0 = x;
+			if (y < track->y0) track->y0 = y;
+			if (x + w > track->x1) track->x1 = x + w;
+			if (y + h > track->y1) track->y1 = y + h;
+		}
+	}
+}
+
+void nvgvk_upload_record(NVGVkContext* vk, VkCommandBuffer cmd)
+{
+	if (!vk || vk->uploadCount == 0) {
+		return;
+	}
+
+	NVGVkFrame* frame = &vk->frames[vk->frameIndex];
+	NVGVkUploadTrack tracks[NVGVK_MAX_TEXTURES];
+	VkImageMemoryBarrier barriers[NVGVK_MAX_TEXTURES];
+	int ntracks = 0;
+	int nbarriers = 0;
+
+	// Pass 1: move every touched texture into the layout of its first use with one barrier batch
+	VkPipelineStageFlags srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+	for (int i = 0; i < vk->uploadCount; i++) {
+		NVGVkUpload* upload = &vk->uploads[i];
+		int ids[2] = { upload->srcTexture, upload->dstTexture };
+		for (int j = 0; j < 2; j++) {
+			if (ids[j] < 0) continue;
+			int known = ntracks;
+			NVGVkUploadTrack* track = nvgvk__track(vk, tracks, &ntracks, ids[j]);
+			if (ntracks == known) continue;
+
+			if (track->layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
+				srcStages |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			}
+			if (j == 0) {
+				nvgvk__fill_barrier(vk, &barriers[nbarriers++], track,
+				                    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_TRANSFER_READ_BIT);
+			} else {
+				nvgvk__fill_barrier(vk, &barriers[nbarriers++], track,
+				                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT);
+			}
+		}
+	}
+
+	vkCmdPipelineBarrier(cmd, srcStages, VK_PIPELINE_STAGE_TRANSFER_BIT,
+	                     0, 0, NULL, 0, NULL, nbarriers, barriers);
+
+	// Pass 2: record transfers in issue order
+	for (int i = 0; i < vk->uploadCount; i++) {
+		NVGVkUpload* upload = &vk->uploads[i];
+		NVGVkTexture* dstTex = &vk->textures[upload->dstTexture];
+
+		if (upload->type == NVGVK_UPLOAD_IMAGE_TO_IMAGE) {
+			NVGVkUploadTrack* srcTrack = nvgvk__track(vk, tracks, &ntracks, upload->srcTexture);
+			nvgvk__require_layout(vk, cmd, srcTrack, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			                      VK_ACCESS_TRANSFER_READ_BIT, 0, 0, 0, 0);
+		}
+
+		NVGVkUploadTrack* dstTrack = nvgvk__track(vk, tracks, &ntracks, upload->dstTexture);
+		nvgvk__require_layout(vk, cmd, dstTrack, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		                      VK_ACCESS_TRANSFER_WRITE_BIT, upload->x, upload->y, upload->w, upload->h);
+
+		switch (upload->type) {
+			case NVGVK_UPLOAD_BUFFER_TO_IMAGE: {
+				VkBufferImageCopy region = {0};
+				region.bufferOffset = upload->bufferOffset;
+				region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				region.imageSubresource.layerCount = 1;
+				region.imageOffset.x = upload->x;
+				region.imageOffset.y = upload->y;
+				region.imageExtent.width = upload->w;
+				region.imageExtent.height = upload->h;
+				region.imageExtent.depth = 1;
+
+				vkCmdCopyBufferToImage(cmd, frame->stagingBuffer.buffer, dstTex->image,
+				                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+				break;
+			}
+			case NVGVK_UPLOAD_IMAGE_TO_IMAGE: {
+				VkImageCopy region = {0};
+				region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				region.srcSubresource.layerCount = 1;
+				region.srcOffset.x = upload->srcX;
+				region.srcOffset.y = upload->srcY;
+				region.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				region.dstSubresource.layerCount = 1;
+				region.dstOffset.x = upload->x;
+				region.dstOffset.y = upload->y;
+				region.extent.width = upload->w;
+				region.extent.height = upload->h;
+				region.extent.depth = 1;
+
+				vkCmdCopyImage(cmd,
+				               vk->textures[upload->srcTexture].image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+				               dstTex->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				               1, &region);
+				break;
+			}
+			case NVGVK_UPLOAD_CLEAR: {
+				VkClearColorValue clearColor = {{0.0f, 0.0f, 0.0f, 0.0f}};
+				VkImageSubresourceRange range = {0};
+				range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				range.levelCount = 1;
+				range.layerCount = 1;
+
+				vkCmdClearColorImage(cmd, dstTex->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				                     &clearColor, 1, &range);
+				break;
+			}
+		}
+	}
+
+	// Pass 3: hand everything back to the fragment shader with one barrier batch
+	nbarriers = 0;
+	for (int i = 0; i < ntracks; i++) {
+		nvgvk__fill_barrier(vk, &barriers[nbarriers++], &tracks[i],
+		                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_SHADER_READ_BIT);
+		// Mark texture as initialized
+		vk->textures[tracks[i].texId].flags |= 0x8000;
+	}
+
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+	                     0, 0, NULL, 0, NULL, nbarriers, barriers);
+
+	vk->uploadCount = 0;
+}
+
+int nvgvk_upload_submit(NVGVkContext* vk)
+{
+	if (!vk || vk->uploadCount == 0) {
+		return 1;
+	}
+
+	NVGVkFrame* frame = nvgvk_frame_acquire(vk);
+
+	// Normally one submit per frame at flush. Extra submits (atlas dumps) must
+	// not re-record a command buffer that may still be executing.
+	if (frame->uploadsSubmitted) {
+		vkQueueWaitIdle(vk->queue);
+	}
+
+	VkCommandBufferBeginInfo beginInfo = {0};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	if (vkBeginCommandBuffer(frame->uploadCommandBuffer, &beginInfo) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to begin upload command buffer\n");
+		return 0;
+	}
+
+	nvgvk_upload_record(vk, frame->uploadCommandBuffer);
+	vkEndCommandBuffer(frame->uploadCommandBuffer);
+
+	// Submitted ahead of the frame command buffer on the same queue: the
+	// barriers recorded above order these transfers before any later draw.
+	// Completion is tracked by the frame fence, submitted after the frame.
+	VkSubmitInfo submitInfo = {0};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &frame->uploadCommandBuffer;
+
+	if (vkQueueSubmit(vk->queue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to submit texture uploads\n");
+		return 0;
+	}
+
+	frame->uploadsSubmitted = 1;
+	return 1;
+}
@@ -0,0 +1,28 @@
+#ifndef NVG_VK_UPLOAD_H
+#define NVG_VK_UPLOAD_H
+
+#include "nvg_vk_types.h"
+
+// Free the pending operation queue (staging memory belongs to the frame ring)
+void nvgvk_upload_destroy(NVGVkContext* vk);
+
+// Queue transfer operations (texId is 0-based). Nothing is recorded until
+// nvgvk_upload_record / nvgvk_upload_submit, so these are safe to call while
+// the frame's render pass is open.
+int nvgvk_upload_image(NVGVkContext* vk, int texId, int x, int y, int w, int h,
+                       const unsigned char* data, VkDeviceSize dataSize);
+int nvgvk_upload_clear(NVGVkContext* vk, int texId);
+int nvgvk_upload_copy_image(NVGVkContext* vk, int srcTexId, int dstTexId,
+                            int srcX, int srcY, int dstX, int dstY, int w, int h);
+
+// Drop pending operations that reference a texture about to be destroyed
+void nvgvk_upload_discard_texture(NVGVkContext* vk, int texId);
+
+// Record all pending operations into cmd (must be outside a render pass)
+void nvgvk_upload_record(NVGVkContext* vk, VkCommandBuffer cmd);
+
+// Record pending operations into the current frame's upload command buffer and
+// submit it ahead of the frame command buffer. Never waits on the queue.
+int nvgvk_upload_submit(NVGVkContext* vk);
+
+#endif // NVG_VK_UPLOAD_H
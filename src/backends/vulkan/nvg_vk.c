@@ -21,6 +21,10 @@
 #include "impl/nvg_vk_context.h"
 #include "impl/nvg_vk_texture.h"
 #include "impl/nvg_vk_buffer.h"
+#include "impl/nvg_vk_upload.h"
+#include "impl/nvg_vk_frame.h"
+#include "impl/nvg_vk_arena.h"
+#include "impl/nvg_vk_memory.h"
 #include "impl/nvg_vk_pipeline.h"
 #include "impl/nvg_vk_render.h"
 #include "impl/nvg_vk_types.h"
@@ -41,6 +45,8 @@ typedef struct NVGVkBackend {
 	uint32_t framebufferHeight;
 	int pipelinesCreated;
 	int colorSpaceUBOCreated;
+	NVGVkGlyphReadyCallback glyphReadyCallback;
+	void* glyphReadyUserdata;
 } NVGVkBackend;
 
 // Forward declarations of callback functions
@@ -57,6 +63,9 @@ static void nvgvk__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperation
 static void nvgvk__renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, float strokeWidth, const NVGpath* paths, int npaths);
 static void nvgvk__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const NVGvertex* verts, int nverts, float fringe);
 static void nvgvk__renderDelete(void* uptr);
+static NVGvertex* nvgvk__renderAllocVerts(void* uptr, int nverts);
+static void nvgvk__renderGlyphs(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const float* xform, const NVGglyphInstance* glyphs, int nglyphs, float fringe);
+static int nvgvk__renderShape(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, const NVGshape* shape, float strokeWidth);
 static void nvgvk__renderFontSystemCreated(void* uptr, void* fontSystem);
 
 NVGcontext* nvgCreateVk(VkDevice device, VkPhysicalDevice physicalDevice,
@@ -82,6 +91,7 @@ NVGcontext* nvgCreateVk(VkDevice device, VkPhysicalDevice physicalDevice,
 	createInfo.queue = queue;
 	createInfo.commandPool = commandPool;
 	createInfo.flags = flags;
+	createInfo.framesInFlight = 0;  // NVGVK_DEFAULT_FRAMES_IN_FLIGHT
 
 	if (!nvgvk_create(&backend->vk, &createInfo)) {
 		goto error;
@@ -102,9 +112,19 @@ NVGcontext* nvgCreateVk(VkDevice device, VkPhysicalDevice physicalDevice,
 	params.renderStroke = nvgvk__renderStroke;
 	params.renderTriangles = nvgvk__renderTriangles;
 	params.renderDelete = nvgvk__renderDelete;
+	if (flags & NVG_ZERO_COPY_VERTICES) {
+		params.renderAllocVerts = nvgvk__renderAllocVerts;
+	}
+	if (flags & NVG_INSTANCED_TEXT) {
+		params.renderGlyphs = nvgvk__renderGlyphs;
+	}
+	if (flags & NVG_SDF_SHAPES) {
+		params.renderShape = nvgvk__renderShape;
+	}
 	params.renderFontSystemCreated = nvgvk__renderFontSystemCreated;
 	params.userPtr = backend;
 	params.edgeAntiAlias = flags & NVG_ANTIALIAS ? 1 : 0;
+	params.geometryCache = flags & NVG_GEOMETRY_CACHE ? 1 : 0;
 	params.msdfText = flags & (1 << 13) ? 1 : 0;  // NVG_MSDF_TEXT flag
 	// Pass swapchain color space for text rendering (will be set after color space initialization)
 	params.colorSpace = 0;  // Will be updated in renderCreate callback
@@ -159,6 +179,54 @@ void nvgVkSetShaderPath(NVGcontext* ctx, const char* path)
 	}
 }
 
+int nvgVkLoadPipelineCache(NVGcontext* ctx, const void* data, size_t size)
+{
+	if (!ctx || !data) {
+		return 0;
+	}
+
+	NVGparams* params = nvgInternalParams(ctx);
+	NVGVkBackend* backend = (NVGVkBackend*)params->userPtr;
+	return nvgvk_pipeline_cache_load(&backend->vk, data, size);
+}
+
+int nvgVkSetPipelineCacheFile(NVGcontext* ctx, const char* path)
+{
+	if (!ctx) {
+		return 0;
+	}
+
+	NVGparams* params = nvgInternalParams(ctx);
+	NVGVkBackend* backend = (NVGVkBackend*)params->userPtr;
+	NVGVkContext* vk = &backend->vk;
+
+	free(vk->pipelineCachePath);
+	vk->pipelineCachePath = NULL;
+
+	if (!path) {
+		return 0;
+	}
+
+	size_t len = strlen(path);
+	vk->pipelineCachePath = (char*)malloc(len + 1);
+	if (vk->pipelineCachePath) {
+		memcpy(vk->pipelineCachePath, path, len + 1);
+	}
+
+	return nvgvk_pipeline_cache_load_file(vk, path);
+}
+
+int nvgVkGetPipelineCacheData(NVGcontext* ctx, void* data, size_t* size)
+{
+	if (!ctx || !size) {
+		return 0;
+	}
+
+	NVGparams* params = nvgInternalParams(ctx);
+	NVGVkBackend* backend = (NVGVkBackend*)params->userPtr;
+	return nvgvk_pipeline_cache_data(&backend->vk, data, size);
+}
+
 VkCommandBuffer nvgVkGetCommandBuffer(NVGcontext* ctx)
 {
 	NVGparams* params = nvgInternalParams(ctx);
@@ -166,6 +234,64 @@ VkCommandBuffer nvgVkGetCommandBuffer(NVGcontext* ctx)
 	return backend->vk.commandBuffer;
 }
 
+void nvgVkSetCommandBuffer(NVGcontext* ctx, VkCommandBuffer commandBuffer)
+{
+	NVGparams* params = nvgInternalParams(ctx);
+	NVGVkBackend* backend = (NVGVkBackend*)params->userPtr;
+	NVGVkContext* vk = &backend->vk;
+
+	vk->commandBuffer = commandBuffer != VK_NULL_HANDLE ? commandBuffer : vk->ownedCommandBuffer;
+}
+
+int nvgVkSetFramesInFlight(NVGcontext* ctx, int count)
+{
+	NVGparams* params = nvgInternalParams(ctx);
+	NVGVkBackend* backend = (NVGVkBackend*)params->userPtr;
+	NVGVkContext* vk = &backend->vk;
+
+	// Pending transfers live in the current frame's staging buffer
+	nvgvk_upload_submit(vk);
+	vkDeviceWaitIdle(vk->device);
+	nvgvk_collect_garbage(vk, 1);
+
+	nvgvk_frames_destroy(vk);
+	if (!nvgvk_frames_init(vk, count)) {
+		fprintf(stderr, "NanoVG Vulkan: Failed to resize frame ring, falling back to default\n");
+		return nvgvk_frames_init(vk, NVGVK_DEFAULT_FRAMES_IN_FLIGHT);
+	}
+	return 1;
+}
+
+void nvgVkGetMemoryStats(NVGcontext* ctx, NVGVkMemoryStats* stats)
+{
+	if (!ctx || !stats) {
+		return;
+	}
+
+	NVGparams* params = nvgInternalParams(ctx);
+	NVGVkBackend* backend = (NVGVkBackend*)params->userPtr;
+	nvgvk_memory_stats(&backend->vk, stats);
+}
+
+void nvgVkGetRenderStats(NVGcontext* ctx, NVGVkRenderStats* stats)
+{
+	if (!ctx || !stats) {
+		return;
+	}
+
+	NVGparams* params = nvgInternalParams(ctx);
+	NVGVkBackend* backend = (NVGVkBackend*)params->userPtr;
+	const NVGVkCounters* counters = &backend->vk.flushCounters;
+	stats->calls = counters->calls;
+	stats->draws = counters->draws;
+	stats->pipelineBinds = counters->pipelineBinds;
+	stats->pipelineBindsSkipped = counters->pipelineBindsSkipped;
+	stats->descriptorBinds = counters->descriptorBinds;
+	stats->descriptorBindsSkipped = counters->descriptorBindsSkipped;
+	stats->descriptorWrites = counters->descriptorWrites;
+	stats->vertexBufferBinds = counters->vertexBufferBinds;
+}
+
 void nvgVkSetFramebuffer(NVGcontext* ctx, VkFramebuffer framebuffer, uint32_t width, uint32_t height)
 {
 	NVGparams* params = nvgInternalParams(ctx);
@@ -338,6 +464,7 @@ static void nvgvk__convertPaint(NVGVkBackend* backend, NVGVkUniforms* frag, NVGp
 		// OpenGL encoding: 0=RGBA premult, 1=RGBA non-premult, 2=ALPHA
 		int texId = paint->image - 1;
 		if (texId >= 0 && texId < NVGVK_MAX_TEXTURES) {
+			frag->image = texId;  // Bindless table slot
 			NVGVkTexture* tex = &backend->vk.textures[texId];
 			printf("[nvg_vk] texId=%d, tex->type=%d (RGBA=%d, ALPHA=%d, MSDF=%d)\n",
 				texId, tex->type, NVG_TEXTURE_RGBA, NVG_TEXTURE_ALPHA, NVG_TEXTURE_MSDF);
@@ -358,83 +485,146 @@ static void nvgvk__convertPaint(NVGVkBackend* backend, NVGVkUniforms* frag, NVGp
 	}
 }
 
-static void nvgvk__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation,
-                              NVGscissor* scissor, float fringe, const float* bounds, const NVGpath* paths, int npaths)
+// Helper: Count vertices a fill/stroke call will need
+static int nvgvk__maxVertCount(const NVGpath* paths, int npaths)
 {
-	NVGVkBackend* backend = (NVGVkBackend*)uptr;
-	NVGVkContext* vk = &backend->vk;
-
-	// Convert paths to internal format
+	int count = 0;
 	for (int i = 0; i < npaths; i++) {
-		if (vk->pathCount >= NVGVK_MAX_CALLS) break;
+		count += paths[i].nfill;
+		count += paths[i].nstroke;
+	}
+	return count;
+}
 
-		NVGVkPath* dstPath = &vk->paths[vk->pathCount++];
+// Helper: Reference paths expanded in place by the front end (zero-copy).
+// Returns 0 if any path lies outside the current direct block.
+static int nvgvk__directPaths(NVGVkContext* vk, const NVGpath* paths, int npaths, int pathOffset, int* chunk)
+{
+	*chunk = vk->directChunk;
+
+	for (int i = 0; i < npaths; i++) {
+		NVGVkPath* dstPath = &vk->paths[pathOffset + i];
 		const NVGpath* srcPath = &paths[i];
 
-		dstPath->fillOffset = vk->vertexCount;
+		dstPath->fillOffset = 0;
 		dstPath->fillCount = srcPath->nfill;
+		if (srcPath->nfill > 0) {
+			dstPath->fillOffset = nvgvk_direct_offset(vk, srcPath->fill, srcPath->nfill, chunk);
+			if (dstPath->fillOffset < 0) return 0;
+		}
 
-		// Copy fill vertices
-		for (int j = 0; j < srcPath->nfill && vk->vertexCount < vk->vertexCapacity; j++) {
-			NVGvertex* dstVert = (NVGvertex*)&vk->vertices[vk->vertexCount * 4];
-			*dstVert = srcPath->fill[j];
-			vk->vertexCount++;
+		dstPath->strokeOffset = 0;
+		dstPath->strokeCount = srcPath->nstroke;
+		if (srcPath->nstroke > 0) {
+			dstPath->strokeOffset = nvgvk_direct_offset(vk, srcPath->stroke, srcPath->nstroke, chunk);
+			if (dstPath->strokeOffset < 0) return 0;
 		}
+	}
+
+	return 1;
+}
+
+// Helper: Copy path vertices into verts (starting at chunk offset) and return the end offset
+static int nvgvk__copyPaths(NVGVkContext* vk, const NVGpath* paths, int npaths, int pathOffset,
+                            NVGvertex* verts, int offset)
+{
+	for (int i = 0; i < npaths; i++) {
+		NVGVkPath* dstPath = &vk->paths[pathOffset + i];
+		const NVGpath* srcPath = &paths[i];
+
+		// Copy fill vertices
+		dstPath->fillOffset = offset;
+		dstPath->fillCount = srcPath->nfill;
+		memcpy(verts, srcPath->fill, sizeof(NVGvertex) * srcPath->nfill);
+		verts += srcPath->nfill;
+		offset += srcPath->nfill;
 
-		// Copy fringe vertices (for AA)
-		dstPath->strokeOffset = vk->vertexCount;
+		// Copy fringe/stroke vertices
+		dstPath->strokeOffset = offset;
 		dstPath->strokeCount = srcPath->nstroke;
-		for (int j = 0; j < srcPath->nstroke && vk->vertexCount < vk->vertexCapacity; j++) {
-			NVGvertex* dstVert = (NVGvertex*)&vk->vertices[vk->vertexCount * 4];
-			*dstVert = srcPath->stroke[j];
-			vk->vertexCount++;
+		memcpy(verts, srcPath->stroke, sizeof(NVGvertex) * srcPath->nstroke);
+		verts += srcPath->nstroke;
+		offset += srcPath->nstroke;
+	}
+
+	return offset;
+}
+
+static void nvgvk__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation,
+                              NVGscissor* scissor, float fringe, const float* bounds, const NVGpath* paths, int npaths)
+{
+	NVGVkBackend* backend = (NVGVkBackend*)uptr;
+	NVGVkContext* vk = &backend->vk;
+
+	int pathOffset = nvgvk_alloc_paths(vk, npaths);
+	int uniformOffset = nvgvk_alloc_uniforms(vk, 1);
+	if (pathOffset < 0 || uniformOffset < 0) {
+		return;
+	}
+
+	// All vertices of a call share one vertex chunk (paths + bounding quad)
+	int chunk = 0;
+	int quadOffset = 0;
+	int quadCount = bounds ? 6 : 0;
+	NVGvertex* quad = NULL;
+
+	if (nvgvk__directPaths(vk, paths, npaths, pathOffset, &chunk)) {
+		// Expanded in place: only the cover quad is written, right after the paths
+		quad = nvgvk_direct_append(vk, quadCount, &quadOffset);
+	}
+	if (!quad) {
+		int offset;
+		NVGvertex* verts = nvgvk_alloc_vertices(vk, nvgvk__maxVertCount(paths, npaths) + quadCount, &chunk, &offset);
+		if (!verts) {
+			return;
 		}
+		quadOffset = nvgvk__copyPaths(vk, paths, npaths, pathOffset, verts, offset);
+		quad = verts + (quadOffset - offset);
 	}
 
 	// Create bounding quad for cover pass (bounds = [minx, miny, maxx, maxy])
-	int quadOffset = vk->vertexCount;
-	if (vk->vertexCount + 6 <= vk->vertexCapacity && bounds) {
+	if (bounds) {
 		float minx = bounds[0], miny = bounds[1];
 		float maxx = bounds[2], maxy = bounds[3];
 
 		// Triangle 1: top-left, top-right, bottom-left
-		NVGvertex* v0 = (NVGvertex*)&vk->vertices[vk->vertexCount++ * 4];
+		NVGvertex* v0 = quad++;
 		v0->x = minx; v0->y = miny; v0->u = 0.5f; v0->v = 1.0f;
 
-		NVGvertex* v1 = (NVGvertex*)&vk->vertices[vk->vertexCount++ * 4];
+		NVGvertex* v1 = quad++;
 		v1->x = maxx; v1->y = miny; v1->u = 0.5f; v1->v = 1.0f;
 
-		NVGvertex* v2 = (NVGvertex*)&vk->vertices[vk->vertexCount++ * 4];
+		NVGvertex* v2 = quad++;
 		v2->x = minx; v2->y = maxy; v2->u = 0.5f; v2->v = 1.0f;
 
 		// Triangle 2: top-right, bottom-right, bottom-left
-		NVGvertex* v3 = (NVGvertex*)&vk->vertices[vk->vertexCount++ * 4];
+		NVGvertex* v3 = quad++;
 		v3->x = maxx; v3->y = miny; v3->u = 0.5f; v3->v = 1.0f;
 
-		NVGvertex* v4 = (NVGvertex*)&vk->vertices[vk->vertexCount++ * 4];
+		NVGvertex* v4 = quad++;
 		v4->x = maxx; v4->y = maxy; v4->u = 0.5f; v4->v = 1.0f;
 
-		NVGvertex* v5 = (NVGvertex*)&vk->vertices[vk->vertexCount++ * 4];
+		NVGvertex* v5 = quad++;
 		v5->x = minx; v5->y = maxy; v5->u = 0.5f; v5->v = 1.0f;
 	}
 
 	// Add render call
-	if (vk->callCount >= NVGVK_MAX_CALLS) return;
-	NVGVkCall* call = &vk->calls[vk->callCount++];
+	NVGVkCall* call = nvgvk_alloc_call(vk);
+	if (!call) return;
 
 	call->type = NVGVK_FILL;
 	call->image = paint->image;
-	call->pathOffset = vk->pathCount - npaths;
+	call->pathOffset = pathOffset;
 	call->pathCount = npaths;
 	call->triangleOffset = quadOffset;
-	call->triangleCount = 6;  // Two triangles for bounding quad
-	call->uniformOffset = vk->uniformCount;
-	call->blendFunc = compositeOperation.srcRGB; // Simplified
+	call->triangleCount = quadCount;  // Two triangles for bounding quad
+	call->uniformOffset = uniformOffset;
+	nvgvk_get_blend_factors(compositeOperation.srcRGB, compositeOperation.dstRGB,
+	                        compositeOperation.srcAlpha, compositeOperation.dstAlpha, &call->blend);
+	call->vertexChunk = chunk;
 
 	// Setup uniforms
-	if (vk->uniformCount < NVGVK_MAX_CALLS) {
-		nvgvk__convertPaint(backend, &vk->uniforms[vk->uniformCount++], paint, scissor, fringe, 0.0f);
-	}
+	nvgvk__convertPaint(backend, &vk->uniforms[uniformOffset], paint, scissor, fringe, 0.0f);
 }
 
 static void nvgvk__renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation,
@@ -443,44 +633,40 @@ static void nvgvk__renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperati
 	NVGVkBackend* backend = (NVGVkBackend*)uptr;
 	NVGVkContext* vk = &backend->vk;
 
-	// Convert paths to internal format
-	for (int i = 0; i < npaths; i++) {
-		if (vk->pathCount >= NVGVK_MAX_CALLS) break;
-
-		NVGVkPath* dstPath = &vk->paths[vk->pathCount++];
-		const NVGpath* srcPath = &paths[i];
-
-		dstPath->strokeOffset = vk->vertexCount;
-		dstPath->strokeCount = srcPath->nstroke;
+	int pathOffset = nvgvk_alloc_paths(vk, npaths);
+	int uniformOffset = nvgvk_alloc_uniforms(vk, 1);
+	if (pathOffset < 0 || uniformOffset < 0) {
+		return;
+	}
 
-		// Copy stroke vertices
-		for (int j = 0; j < srcPath->nstroke && vk->vertexCount < vk->vertexCapacity; j++) {
-			NVGvertex* dstVert = (NVGvertex*)&vk->vertices[vk->vertexCount * 4];
-			*dstVert = srcPath->stroke[j];
-			vk->vertexCount++;
+	// Stroke paths carry no fill vertices, so copying only moves stroke geometry
+	int chunk = 0;
+	if (!nvgvk__directPaths(vk, paths, npaths, pathOffset, &chunk)) {
+		int offset;
+		NVGvertex* verts = nvgvk_alloc_vertices(vk, nvgvk__maxVertCount(paths, npaths), &chunk, &offset);
+		if (!verts) {
+			return;
 		}
-
-		dstPath->fillOffset = 0;
-		dstPath->fillCount = 0;
+		nvgvk__copyPaths(vk, paths, npaths, pathOffset, verts, offset);
 	}
 
 	// Add render call
-	if (vk->callCount >= NVGVK_MAX_CALLS) return;
-	NVGVkCall* call = &vk->calls[vk->callCount++];
+	NVGVkCall* call = nvgvk_alloc_call(vk);
+	if (!call) return;
 
 	call->type = NVGVK_STROKE;
 	call->image = paint->image;
-	call->pathOffset = vk->pathCount - npaths;
+	call->pathOffset = pathOffset;
 	call->pathCount = npaths;
 	call->triangleOffset = 0;
 	call->triangleCount = 0;
-	call->uniformOffset = vk->uniformCount;
-	call->blendFunc = compositeOperation.srcRGB;
+	call->uniformOffset = uniformOffset;
+	nvgvk_get_blend_factors(compositeOperation.srcRGB, compositeOperation.dstRGB,
+	                        compositeOperation.srcAlpha, compositeOperation.dstAlpha, &call->blend);
+	call->vertexChunk = chunk;
 
 	// Setup uniforms
-	if (vk->uniformCount < NVGVK_MAX_CALLS) {
-		nvgvk__convertPaint(backend, &vk->uniforms[vk->uniformCount++], paint, scissor, strokeWidth, -1.0f);
-	}
+	nvgvk__convertPaint(backend, &vk->uniforms[uniformOffset], paint, scissor, strokeWidth, -1.0f);
 }
 
 static void nvgvk__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation,
@@ -489,17 +675,25 @@ static void nvgvk__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOper
 	NVGVkBackend* backend = (NVGVkBackend*)uptr;
 	NVGVkContext* vk = &backend->vk;
 
-	// Copy triangle vertices
-	int triangleOffset = vk->vertexCount;
-	for (int i = 0; i < nverts && vk->vertexCount < vk->vertexCapacity; i++) {
-		NVGvertex* dstVert = (NVGvertex*)&vk->vertices[vk->vertexCount * 4];
-		*dstVert = verts[i];
-		vk->vertexCount++;
+	int uniformOffset = nvgvk_alloc_uniforms(vk, 1);
+	if (uniformOffset < 0) {
+		return;
+	}
+
+	// Text quads are usually written in place; otherwise copy triangle vertices
+	int chunk = 0;
+	int triangleOffset = nvgvk_direct_offset(vk, verts, nverts, &chunk);
+	if (triangleOffset < 0) {
+		NVGvertex* dstVerts = nvgvk_alloc_vertices(vk, nverts, &chunk, &triangleOffset);
+		if (!dstVerts) {
+			return;
+		}
+		memcpy(dstVerts, verts, sizeof(NVGvertex) * nverts);
 	}
 
 	// Add render call
-	if (vk->callCount >= NVGVK_MAX_CALLS) return;
-	NVGVkCall* call = &vk->calls[vk->callCount++];
+	NVGVkCall* call = nvgvk_alloc_call(vk);
+	if (!call) return;
 
 	call->type = NVGVK_TRIANGLES;
 	call->image = paint->image;
@@ -507,15 +701,155 @@ static void nvgvk__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOper
 	call->pathCount = 0;
 	call->triangleOffset = triangleOffset;
 	call->triangleCount = nverts;
-	call->uniformOffset = vk->uniformCount;
-	call->blendFunc = compositeOperation.srcRGB;
+	call->uniformOffset = uniformOffset;
+	nvgvk_get_blend_factors(compositeOperation.srcRGB, compositeOperation.dstRGB,
+	                        compositeOperation.srcAlpha, compositeOperation.dstAlpha, &call->blend);
+	call->vertexChunk = chunk;
 
 	// Setup uniforms
-	if (vk->uniformCount < NVGVK_MAX_CALLS) {
-		nvgvk__convertPaint(backend, &vk->uniforms[vk->uniformCount++], paint, scissor, fringe, -1.0f);
+	nvgvk__convertPaint(backend, &vk->uniforms[uniformOffset], paint, scissor, fringe, -1.0f);
+}
+
+static void nvgvk__vset(NVGvertex* vtx, float x, float y)
+{
+	vtx->x = x;
+	vtx->y = y;
+	vtx->u = 0.5f;
+	vtx->v = 1.0f;
+}
+
+static int nvgvk__renderShape(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation,
+                              NVGscissor* scissor, float fringe, const NVGshape* shape, float strokeWidth)
+{
+	NVGVkBackend* backend = (NVGVkBackend*)uptr;
+	NVGVkContext* vk = &backend->vk;
+
+	// Image paints keep the textured fill path
+	if (paint->image > 0) {
+		return 0;
+	}
+
+	float inv[6];
+	if (!nvgTransformInverse(inv, shape->xform)) {
+		return 0;
+	}
+
+	// Returning 0 makes the core tessellate the shape instead, so a failed
+	// allocation hands back the records taken before it
+	NVGVkCall* call = nvgvk_alloc_call(vk);
+	if (!call) return 0;
+	int uniformOffset = nvgvk_alloc_uniforms(vk, 1);
+	if (uniformOffset < 0) {
+		vk->callCount--;
+		return 0;
+	}
+
+	// Screen aligned quad around the transformed shape, the stroke and one pixel of AA
+	float hw = strokeWidth * 0.5f;
+	float ex = shape->extent[0] + hw;
+	float ey = shape->extent[1] + hw;
+	float pad = fringe > 0.0f ? fringe : 1.0f;
+	float rx = fabsf(shape->xform[0]) * ex + fabsf(shape->xform[2]) * ey + pad;
+	float ry = fabsf(shape->xform[1]) * ex + fabsf(shape->xform[3]) * ey + pad;
+	float cx = shape->xform[4];
+	float cy = shape->xform[5];
+
+	int chunk = 0;
+	int triangleOffset = 0;
+	NVGvertex* quad = nvgvk_alloc_vertices(vk, 6, &chunk, &triangleOffset);
+	if (!quad) {
+		vk->uniformCount--;
+		vk->callCount--;
+		return 0;
+	}
+	nvgvk__vset(&quad[0], cx - rx, cy - ry);
+	nvgvk__vset(&quad[1], cx + rx, cy - ry);
+	nvgvk__vset(&quad[2], cx - rx, cy + ry);
+	nvgvk__vset(&quad[3], cx + rx, cy - ry);
+	nvgvk__vset(&quad[4], cx + rx, cy + ry);
+	nvgvk__vset(&quad[5], cx - rx, cy + ry);
+
+	call->type = NVGVK_SHAPE;
+	call->image = 0;
+	call->pathOffset = 0;
+	call->pathCount = 0;
+	call->triangleOffset = triangleOffset;
+	call->triangleCount = 6;
+	call->uniformOffset = uniformOffset;
+	nvgvk_get_blend_factors(compositeOperation.srcRGB, compositeOperation.dstRGB,
+	                        compositeOperation.srcAlpha, compositeOperation.dstAlpha, &call->blend);
+	call->vertexChunk = chunk;
+
+	NVGVkUniforms* frag = &vk->uniforms[uniformOffset];
+	nvgvk__convertPaint(backend, frag, paint, scissor, fringe, -1.0f);
+	frag->shapeType = shape->type;
+	frag->shapeAntiAlias = fringe > 0.0f;
+	memcpy(frag->xform, inv, sizeof(inv));
+	frag->shape[0] = shape->extent[0];
+	frag->shape[1] = shape->extent[1];
+	frag->shape[2] = shape->radius;
+	frag->shape[3] = hw;
+	return 1;
+}
+
+static void nvgvk__renderGlyphs(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation,
+                                NVGscissor* scissor, const float* xform, const NVGglyphInstance* glyphs, int nglyphs,
+                                float fringe)
+{
+	NVGVkBackend* backend = (NVGVkBackend*)uptr;
+	NVGVkContext* vk = &backend->vk;
+
+	int uniformOffset = nvgvk_alloc_uniforms(vk, 1);
+	if (uniformOffset < 0) {
+		return;
+	}
+
+	// One instance per glyph, tagged with the run's uniforms (which hold its transform)
+	int glyphOffset = 0;
+	NVGVkGlyph* dst = nvgvk_alloc_glyphs(vk, nglyphs, &glyphOffset);
+	if (!dst) {
+		return;
+	}
+	for (int i = 0; i < nglyphs; i++) {
+		const NVGglyphInstance* src = &glyphs[i];
+		dst[i].x = src->x;
+		dst[i].y = src->y;
+		dst[i].w = src->w;
+		dst[i].h = src->h;
+		dst[i].s0 = src->s0;
+		dst[i].t0 = src->t0;
+		dst[i].s1 = src->s1;
+		dst[i].t1 = src->t1;
+		dst[i].uniformIndex = (uint32_t)uniformOffset;
+	}
+
+	// Add render call
+	NVGVkCall* call = nvgvk_alloc_call(vk);
+	if (!call) return;
+
+	call->type = NVGVK_GLYPHS;
+	call->image = paint->image;
+	call->glyphOffset = glyphOffset;
+	call->glyphCount = nglyphs;
+	call->uniformOffset = uniformOffset;
+	nvgvk_get_blend_factors(compositeOperation.srcRGB, compositeOperation.dstRGB,
+	                        compositeOperation.srcAlpha, compositeOperation.dstAlpha, &call->blend);
+	call->vertexChunk = NVGVK_GLYPH_BUFFER;
+
+	// Setup uniforms
+	NVGVkUniforms* frag = &vk->uniforms[uniformOffset];
+	nvgvk__convertPaint(backend, frag, paint, scissor, fringe, -1.0f);
+	for (int i = 0; i < 6; i++) {
+		frag->xform[i] = xform[i];
 	}
 }
 
+static NVGvertex* nvgvk__renderAllocVerts(void* uptr, int nverts)
+{
+	NVGVkBackend* backend = (NVGVkBackend*)uptr;
+	return nvgvk_alloc_direct_vertices(&backend->vk, nverts);
+}
+
 static void nvgvk__renderDelete(void* uptr)
 {
 	NVGVkBackend* backend = (NVGVkBackend*)uptr;
@@ -552,6 +886,27 @@ void nvgVkEndRenderPass(NVGcontext* ctx)
 	nvgvk_end_render_pass(&backend->vk);
 }
 
+// Helper: Forward font system glyph notifications to the backend callback
+static void nvgvk__glyphReady(void* uptr, int font, unsigned int codepoint, float size)
+{
+	NVGVkBackend* backend = (NVGVkBackend*)uptr;
+	if (backend->glyphReadyCallback) {
+		backend->glyphReadyCallback(backend->glyphReadyUserdata, (uint32_t)font, codepoint, (uint32_t)(size + 0.5f));
+	}
+}
+
+void nvgVkSetGlyphReadyCallback(NVGcontext* ctx, NVGVkGlyphReadyCallback callback, void* userdata)
+{
+	NVGVkBackend* backend = (NVGVkBackend*)nvgInternalParams(ctx)->userPtr;
+	if (!backend) return;
+
+	backend->glyphReadyCallback = callback;
+	backend->glyphReadyUserdata = userdata;
+
+	// The callback switches glyph streaming (virtual atlas) on and off
+	nvgGlyphReadyCallback(ctx, callback ? nvgvk__glyphReady : NULL, backend);
+	nvgGlyphStreaming(ctx, callback != NULL, 0.0f);
+}
 
 void nvgVkSetHDRScale(NVGcontext* ctx, float scale)
 {
@@ -623,6 +978,9 @@ void nvgVkDumpAtlasTextureByIndex(NVGcontext* ctx, int textureIndex, const char*
 		return;
 	}
 
+	// Make sure queued atlas uploads land before reading the texture back
+	nvgvk_upload_submit(vk);
+
 	int width = tex->width;
 	int height = tex->height;
 	int isRGBA = (tex->type == NVG_TEXTURE_RGBA);
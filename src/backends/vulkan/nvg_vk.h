@@ -34,6 +34,31 @@ enum NVGcreateFlags {
 	NVG_STENCIL_STROKES	= 1<<1,
 	// Flag indicating that additional debug checks are done.
 	NVG_DEBUG = 1<<2,
+	// Flag indicating that paths and text are expanded directly into mapped per-frame GPU vertex
+	// memory instead of the path cache, removing the intermediate vertex copy.
+	NVG_ZERO_COPY_VERTICES = 1<<3,
+	// Flag indicating that the device was created with the multiDrawIndirect feature enabled.
+	// Batches of path draws (per-path stencil fills, fringe strips) are then submitted with a
+	// single vkCmdDrawIndirect. Ignored if the physical device does not support the feature.
+	NVG_MULTI_DRAW_INDIRECT = 1<<4,
+	// Flag indicating that the device was created with the descriptor indexing features
+	// shaderSampledImageArrayNonUniformIndexing and descriptorBindingPartiallyBound enabled
+	// (Vulkan 1.2 or VK_EXT_descriptor_indexing). All textures are then sampled from one
+	// descriptor array indexed per call, so draws are no longer split by texture switches.
+	// Ignored (per-texture descriptor sets are used) if the device does not support it.
+	NVG_BINDLESS_TEXTURES = 1<<5,
+	// Flag indicating that text is drawn as one instance per glyph (position, size, UV rect and
+	// run index) instead of six expanded vertices. The text transform is applied in the vertex
+	// shader and each batch of glyphs is recorded with a single vkCmdDraw(4, glyphCount).
+	NVG_INSTANCED_TEXT = 1<<6,
+	// Flag indicating that nvgFill/nvgStroke memoize path tessellation in a bounded LRU keyed by the
+	// path commands and stroke state, so paths redrawn unchanged skip flattening and expansion.
+	// See nvgGetGeometryCacheStats() for the hit rate.
+	NVG_GEOMETRY_CACHE = 1<<7,
+	// Flag indicating that paths made of a single nvgRect, nvgRoundedRect, nvgCircle or nvgEllipse
+	// are drawn as one quad whose fragment shader evaluates the shape's signed distance, for both
+	// fill and stroke, instead of being flattened into stencil fills and fringe strips.
+	NVG_SDF_SHAPES = 1<<8,
 };
 
 // Creates NanoVG context with Vulkan backend.
@@ -51,26 +76,85 @@ NVGcontext* nvgCreateVk(VkDevice device, VkPhysicalDevice physicalDevice,
 // Deletes NanoVG context and frees all resources.
 void nvgDeleteVk(NVGcontext* ctx);
 
-// Sets the base path for shader files.
+// Loads shaders from .spv files instead of the SPIR-V embedded at build time (development
+// override, e.g. to iterate on shaders without relinking).
 // Must be called before creating any pipelines (i.e., before nvgBeginFrame()).
 // Parameters:
 //   ctx - NanoVG context
-//   path - Base directory path for shader files (e.g., "/path/to/nanovg/src/shaders")
-//          If NULL, defaults to "src/shaders" (legacy behavior)
+//   path - Base directory path for shader files (e.g., "/path/to/nanovg/build/shaders",
+//          where the build compiles them)
+//          If NULL, the embedded shaders are used again ("src/shaders" in builds
+//          without NVGVK_EMBEDDED_SHADERS)
 // Note: The path string is copied internally and can be freed after this call returns.
 void nvgVkSetShaderPath(NVGcontext* ctx, const char* path);
 
+// Seeds the pipeline cache with data from nvgVkGetPipelineCacheData of a previous run.
+// Pipelines are compiled at the first flush, so call this right after nvgCreateVk().
+// Data from another driver, device or cache UUID is ignored. Returns 1 if the data was used.
+int nvgVkLoadPipelineCache(NVGcontext* ctx, const void* data, size_t size);
+
+// Like nvgVkLoadPipelineCache, reading the file at path (a missing file is not an error
+// beyond returning 0). The cache is written back to path by nvgDeleteVk().
+int nvgVkSetPipelineCacheFile(NVGcontext* ctx, const char* path);
+
+// Serializes the pipeline cache. With data NULL, stores the required size in *size.
+// Returns 1 on success.
+int nvgVkGetPipelineCacheData(NVGcontext* ctx, void* data, size_t* size);
+
 // Returns the Vulkan command buffer that contains the rendering commands.
 // This should be called after nvgEndFrame() to get the command buffer for submission.
 VkCommandBuffer nvgVkGetCommandBuffer(NVGcontext* ctx);
 
+// Sets the command buffer that rendering commands are recorded into, e.g. one per swapchain frame
+// so the CPU can record a frame while previous ones execute. Pass VK_NULL_HANDLE to restore the
+// internal command buffer. Must be called before nvgBeginFrame().
+void nvgVkSetCommandBuffer(NVGcontext* ctx, VkCommandBuffer commandBuffer);
+
+// Sets how many frames NanoVG may have in flight (default 3, clamped to [1, 8]).
+// Vertex, uniform and staging memory is replicated per frame and reused once that frame's fence
+// signals. Waits for the device to be idle. Returns 1 on success.
+int nvgVkSetFramesInFlight(NVGcontext* ctx, int count);
+
+// Device memory statistics. Buffers and textures are sub-allocated from large
+// VkDeviceMemory blocks; fragmentation is 1 - largestFreeBytes / free block bytes.
+typedef struct NVGVkMemoryStats {
+	int blockCount;             // Shared VkDeviceMemory blocks
+	int allocationCount;        // Live sub-allocations
+	int dedicatedCount;         // Allocations too large for a block
+	uint64_t blockBytes;        // Bytes held by blocks
+	uint64_t usedBytes;         // Bytes handed out from blocks (rounded to buddy ranges)
+	uint64_t dedicatedBytes;    // Bytes held by dedicated allocations
+	uint64_t largestFreeBytes;  // Largest range a block can still hand out
+	float fragmentation;        // 0 = all free block memory is one range
+} NVGVkMemoryStats;
+
+// Fills stats with the current device memory usage of the backend.
+void nvgVkGetMemoryStats(NVGcontext* ctx, NVGVkMemoryStats* stats);
+
+// Command statistics of the last flush. Pipeline and descriptor set binds that match
+// the bound state are skipped; descriptor sets are rewritten only when their bindings change.
+typedef struct NVGVkRenderStats {
+	int calls;                    // NanoVG render calls
+	int draws;                    // vkCmdDraw / vkCmdDrawIndirect recorded
+	int pipelineBinds;            // vkCmdBindPipeline recorded
+	int pipelineBindsSkipped;     // Requested pipeline was already bound
+	int descriptorBinds;          // vkCmdBindDescriptorSets recorded for set 0
+	int descriptorBindsSkipped;   // Requested set was already bound
+	int descriptorWrites;         // vkUpdateDescriptorSets since the previous flush
+	int vertexBufferBinds;        // vkCmdBindVertexBuffers recorded
+} NVGVkRenderStats;
+
+// Fills stats with the counters of the last flush.
+void nvgVkGetRenderStats(NVGcontext* ctx, NVGVkRenderStats* stats);
+
 // Sets the current framebuffer for rendering.
 // This must be called before nvgBeginFrame().
 void nvgVkSetFramebuffer(NVGcontext* ctx, VkFramebuffer framebuffer, uint32_t width, uint32_t height);
 
 // Notifies NanoVG that a render pass has started.
 // Call this after vkCmdBeginRenderPass() and vkCmdSetViewport/vkCmdSetScissor to allow NanoVG to track render pass state.
-// The renderPassInfo, viewport, and scissor are stored so the render pass can be restarted if needed (e.g., for texture uploads).
+// The renderPassInfo, viewport, and scissor are stored for state tracking. Texture uploads never restart the render pass:
+// they are batched and submitted ahead of the frame command buffer when nvgEndFrame() flushes.
 void nvgVkBeginRenderPass(NVGcontext* ctx, const VkRenderPassBeginInfo* renderPassInfo,
                           VkViewport viewport, VkRect2D scissor);
 
@@ -79,11 +163,12 @@ void nvgVkBeginRenderPass(NVGcontext* ctx, const VkRenderPassBeginInfo* renderPa
 void nvgVkEndRenderPass(NVGcontext* ctx);
 
 // Glyph ready callback type for virtual atlas
-// Called from background thread when a glyph finishes rasterizing
+// Called from nvgBeginFrame once a glyph rasterized in the background is in the atlas
 typedef void (*NVGVkGlyphReadyCallback)(void* userdata, uint32_t fontID, uint32_t codepoint, uint32_t size);
 
-// Set callback to be notified when MSDF glyphs finish loading
-// Callback is fired from background thread when glyph is rasterized and ready for rendering
+// Enable the virtual atlas and set its glyph ready callback (NULL disables it).
+// Missing glyphs are rasterized on worker threads and drawn blank until ready;
+// see nvgGlyphStreaming to change the per-frame budget.
 void nvgVkSetGlyphReadyCallback(NVGcontext* ctx, NVGVkGlyphReadyCallback callback, void* userdata);
 
 // Color space and HDR control functions
@@ -6,8 +6,7 @@
 // Font system lifecycle
 NVGFontSystem* nvgFontCreate(int atlasWidth, int atlasHeight);
 void nvgFontDestroy(NVGFontSystem* fs);
-void nvgFontSetTextureCallback(NVGFontSystem* fs, void (*callback)(void* uptr, int x, int y, int w, int h, const unsigned char* data, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode), void* userdata);
-void nvgFontSetAtlasGrowCallback(NVGFontSystem* fs, int (*callback)(void* uptr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int* newWidth, int* newHeight), void* userdata);
+void nvgFontSetTextureCallback(NVGFontSystem* fs, void (*callback)(void* uptr, int x, int y, int w, int h, const unsigned char* data, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page), void* userdata);
 
 // Color space configuration
 void nvgFontSetColorSpace(NVGFontSystem* fs, NVGcolorSpace colorSpace);
@@ -58,9 +57,9 @@ void nvgFontSetKerning(NVGFontSystem* fs, int enabled);
 void nvgFontSetTextDirection(NVGFontSystem* fs, int direction);
 void nvgFontSetSubpixelMode(NVGFontSystem* fs, int mode);  // NVGSubpixelMode
 
-// Atlas management
-int nvgFontGetAtlasTexture(NVGFontSystem* fs, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode);
-void nvgFontSetAtlasTexture(NVGFontSystem* fs, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int textureId);
+// Atlas management. Each atlas format is a list of pages with one texture each.
+int nvgFontGetAtlasTexture(NVGFontSystem* fs, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page);
+void nvgFontSetAtlasTexture(NVGFontSystem* fs, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page, int textureId);
 
 // Font information
 const char* nvgFont__GetFamilyName(NVGFontSystem* fs, int fontId);
@@ -77,5 +76,20 @@ int nvgFontGetGlyphMetrics(NVGFontSystem* fs, int fontId, unsigned int codepoint
 float nvgFontGetKerning(NVGFontSystem* fs, int fontId, unsigned int left_glyph, unsigned int right_glyph);
 int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index, unsigned int codepoint,
                        float x, float y, NVGCachedGlyph* quad);
+void nvgFontGetGlyphCacheStats(NVGFontSystem* fs, NVGGlyphCacheStats* stats);
+
+// Batched glyph rasterization. Prepare collects every glyph of the shaped
+// text that is not cached yet, rasterizes them on the worker pool and adds
+// them to the atlas in text order before iteration starts.
+void nvgFontPrepareShapedText(NVGFontSystem* fs, const NVGTextIter* iter);
+void nvgFontSetRasterThreads(NVGFontSystem* fs, int count);  // 0 = rasterize on the calling thread
+
+// Glyph streaming. Missing glyphs are handed to the workers instead of being
+// rasterized while drawing, and are left blank until they arrive. BeginFrame
+// adds finished glyphs to the atlas, spending at most budgetMs, and reports
+// each one through the ready callback.
+void nvgFontSetStreaming(NVGFontSystem* fs, int enabled, float budgetMs);
+void nvgFontSetGlyphReadyCallback(NVGFontSystem* fs, NVGGlyphReadyFunc callback, void* uptr);
+void nvgFontBeginFrame(NVGFontSystem* fs);
 
 #endif // NVG_FONT_H
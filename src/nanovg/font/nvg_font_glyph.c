@@ -1,19 +1,15 @@
 #include "nvg_font.h"
 #include "nvg_font_internal.h"
 #include "nvg_font_colr.h"
+#include "nvg_font_raster.h"
 #include "../../util/vknvg_msdf.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
 #include <freetype/ftoutln.h>
 #include <freetype/ftlcdfil.h>
 
-// Forward declarations from nvg_font_system.c
-int nvgAtlasAlloc(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int w, int h, int* x, int* y);
-void nvgAtlasUpdate(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int x, int y, int w, int h, const unsigned char* data);
-int nvgAtlasGrow(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int* newWidth, int* newHeight);
-NVGAtlas* nvg__getAtlas(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode);
-
 // Internal helpers
 // Skyline-based atlas packing (adapted from fontstash.h)
 
@@ -101,11 +97,103 @@ static int nvg__atlasRectFits(NVGAtlas* atlas, int i, int w, int h)
 	return y;
 }
 
+static int nvg__atlasAddFreeRect(NVGAtlas* atlas, int x, int y, int w, int h)
+{
+	int i;
+
+	if (w <= 0 || h <= 0)
+		return 1;
+
+	// Merge with a neighbour sharing a full edge, repeatedly, so released
+	// glyph rects and guillotine strips coalesce instead of fragmenting
+	for (i = 0; i < atlas->nfreeRects; i++) {
+		NVGAtlasRect* rect = &atlas->freeRects[i];
+		if (rect->x == x && rect->width == w && (rect->y + rect->height == y || y + h == rect->y)) {
+			if (rect->y < y) y = rect->y;
+			h += rect->height;
+		} else if (rect->y == y && rect->height == h && (rect->x + rect->width == x || x + w == rect->x)) {
+			if (rect->x < x) x = rect->x;
+			w += rect->width;
+		} else {
+			continue;
+		}
+		atlas->freeRects[i] = atlas->freeRects[--atlas->nfreeRects];
+		i = -1;
+	}
+
+	// Past the cap the smallest region is dropped until the atlas is cleared
+	if (atlas->nfreeRects >= NVG_FONT_ATLAS_MAX_FREE_RECTS) {
+		int smallest = 0;
+		for (i = 1; i < atlas->nfreeRects; i++) {
+			if (atlas->freeRects[i].width * atlas->freeRects[i].height <
+				atlas->freeRects[smallest].width * atlas->freeRects[smallest].height)
+				smallest = i;
+		}
+		if (atlas->freeRects[smallest].width * atlas->freeRects[smallest].height >= w * h)
+			return 1;
+		atlas->freeRects[smallest] = atlas->freeRects[--atlas->nfreeRects];
+	}
+
+	if (atlas->nfreeRects + 1 > atlas->cfreeRects) {
+		int cfreeRects = atlas->cfreeRects == 0 ? 8 : atlas->cfreeRects * 2;
+		NVGAtlasRect* rects = (NVGAtlasRect*)realloc(atlas->freeRects, sizeof(NVGAtlasRect) * cfreeRects);
+		if (rects == NULL)
+			return 0;
+		atlas->freeRects = rects;
+		atlas->cfreeRects = cfreeRects;
+	}
+	NVGAtlasRect* rect = &atlas->freeRects[atlas->nfreeRects++];
+	rect->x = (short)x;
+	rect->y = (short)y;
+	rect->width = (short)w;
+	rect->height = (short)h;
+	return 1;
+}
+
+static int nvg__atlasAllocFreeRect(NVGAtlas* atlas, int w, int h, int* x, int* y)
+{
+	int besti = -1, bestArea = 0, i;
+
+	// Best area fit among regions released by evicted glyphs
+	for (i = 0; i < atlas->nfreeRects; i++) {
+		NVGAtlasRect* rect = &atlas->freeRects[i];
+		if (rect->width >= w && rect->height >= h) {
+			int area = rect->width * rect->height;
+			if (besti == -1 || area < bestArea) {
+				besti = i;
+				bestArea = area;
+			}
+		}
+	}
+
+	if (besti == -1)
+		return 0;
+
+	NVGAtlasRect rect = atlas->freeRects[besti];
+	atlas->freeRects[besti] = atlas->freeRects[--atlas->nfreeRects];
+
+	// Guillotine split: keep the strip to the right and the strip below
+	nvg__atlasAddFreeRect(atlas, rect.x + w, rect.y, rect.width - w, h);
+	nvg__atlasAddFreeRect(atlas, rect.x, rect.y + h, rect.width, rect.height - h);
+
+	*x = rect.x;
+	*y = rect.y;
+	return 1;
+}
+
+void nvg__resetAtlasFreeRects(NVGAtlas* atlas)
+{
+	atlas->nfreeRects = 0;
+}
+
 int nvg__allocAtlasNode(NVGAtlas* atlas, int w, int h, int* x, int* y)
 {
 	int besth = atlas->height, bestw = atlas->width, besti = -1;
 	int bestx = -1, besty = -1, i;
 
+	if (nvg__atlasAllocFreeRect(atlas, w, h, x, y))
+		return 1;
+
 	// Bottom left fit heuristic
 	for (i = 0; i < atlas->nnodes; i++) {
 		int y_fit = nvg__atlasRectFits(atlas, i, w, h);
@@ -133,35 +221,277 @@ int nvg__allocAtlasNode(NVGAtlas* atlas, int w, int h, int* x, int* y)
 	return 1;
 }
 
-static NVGGlyphCacheEntry* nvg__findGlyph(NVGGlyphCache* cache, unsigned int glyphIndex, int fontId, float size, unsigned int varStateId, int hinting, int subpixelMode) {
-	for (int i = 0; i < cache->count; i++) {
-		NVGGlyphCacheEntry* entry = &cache->entries[i];
-		if (entry->valid && entry->glyphIndex == glyphIndex &&
-			entry->fontId == fontId && fabsf(entry->size - size) < 0.01f &&
+// Glyph cache (open-addressing hash + LRU)
+
+static int nvg__glyphSizeKey(float size) {
+	return (int)(size * 64.0f + 0.5f);
+}
+
+static unsigned int nvg__glyphHash(unsigned int glyphIndex, int fontId, int sizeKey, unsigned int varStateId, int hinting, int subpixelMode) {
+	unsigned int h = glyphIndex * 0x9E3779B1u;
+	h ^= (unsigned int)fontId * 0x85EBCA77u;
+	h ^= (unsigned int)sizeKey * 0xC2B2AE3Du;
+	h ^= varStateId * 0x27D4EB2Fu;
+	h ^= (((unsigned int)hinting << 4) | (unsigned int)subpixelMode) * 0x165667B1u;
+	h ^= h >> 15;
+	h *= 0x2C1B3C6Du;
+	h ^= h >> 13;
+	return h;
+}
+
+static void nvg__glyphLruUnlink(NVGGlyphCache* cache, int idx) {
+	NVGGlyphCacheEntry* entry = &cache->entries[idx];
+	if (entry->lruPrev != -1)
+		cache->entries[entry->lruPrev].lruNext = entry->lruNext;
+	else
+		cache->lruHead = entry->lruNext;
+	if (entry->lruNext != -1)
+		cache->entries[entry->lruNext].lruPrev = entry->lruPrev;
+	else
+		cache->lruTail = entry->lruPrev;
+	entry->lruPrev = -1;
+	entry->lruNext = -1;
+}
+
+static void nvg__glyphLruPushFront(NVGGlyphCache* cache, int idx) {
+	NVGGlyphCacheEntry* entry = &cache->entries[idx];
+	entry->lruPrev = -1;
+	entry->lruNext = cache->lruHead;
+	if (cache->lruHead != -1)
+		cache->entries[cache->lruHead].lruPrev = idx;
+	else
+		cache->lruTail = idx;
+	cache->lruHead = idx;
+}
+
+static void nvg__glyphHashRemove(NVGGlyphCache* cache, int idx) {
+	unsigned int mask = (unsigned int)cache->hashSize - 1;
+	unsigned int i = cache->entries[idx].hash & mask;
+	while (cache->slots[i] != idx + 1)
+		i = (i + 1) & mask;
+
+	// Backward-shift deletion: pull later cluster members into the hole so
+	// probes never stop early and no tombstones are needed
+	unsigned int j = i;
+	for (;;) {
+		j = (j + 1) & mask;
+		if (cache->slots[j] == 0)
+			break;
+		unsigned int home = cache->entries[cache->slots[j] - 1].hash & mask;
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			cache->slots[i] = cache->slots[j];
+			i = j;
+		}
+	}
+	cache->slots[i] = 0;
+}
+
+NVGGlyphCache* nvg__createGlyphCache(void) {
+	NVGGlyphCache* cache = (NVGGlyphCache*)calloc(1, sizeof(NVGGlyphCache));
+	if (!cache) return NULL;
+
+	cache->capacity = NVG_FONT_GLYPH_CACHE_SIZE;
+	cache->hashSize = NVG_FONT_GLYPH_CACHE_SIZE * 2;
+	cache->entries = (NVGGlyphCacheEntry*)malloc(sizeof(NVGGlyphCacheEntry) * cache->capacity);
+	cache->slots = (int*)malloc(sizeof(int) * cache->hashSize);
+	if (!cache->entries || !cache->slots) {
+		nvg__destroyGlyphCache(cache);
+		return NULL;
+	}
+	nvg__resetGlyphCache(cache);
+	return cache;
+}
+
+void nvg__destroyGlyphCache(NVGGlyphCache* cache) {
+	if (!cache) return;
+	free(cache->entries);
+	free(cache->slots);
+	free(cache);
+}
+
+void nvg__resetGlyphCache(NVGGlyphCache* cache) {
+	memset(cache->entries, 0, sizeof(NVGGlyphCacheEntry) * cache->capacity);
+	memset(cache->slots, 0, sizeof(int) * cache->hashSize);
+	cache->count = 0;
+	cache->liveCount = 0;
+	cache->lruHead = -1;
+	cache->lruTail = -1;
+	cache->freeList = -1;
+	cache->generation++;
+}
+
+static int nvg__lookupGlyph(NVGGlyphCache* cache, unsigned int glyphIndex, int fontId, float size, unsigned int varStateId, int hinting, int subpixelMode) {
+	int sizeKey = nvg__glyphSizeKey(size);
+	unsigned int hash = nvg__glyphHash(glyphIndex, fontId, sizeKey, varStateId, hinting, subpixelMode);
+	unsigned int mask = (unsigned int)cache->hashSize - 1;
+
+	for (unsigned int i = hash & mask; cache->slots[i] != 0; i = (i + 1) & mask) {
+		int idx = cache->slots[i] - 1;
+		NVGGlyphCacheEntry* entry = &cache->entries[idx];
+		if (entry->hash == hash && entry->glyphIndex == glyphIndex &&
+			entry->fontId == fontId && entry->sizeKey == sizeKey &&
 			entry->varStateId == varStateId && entry->hinting == hinting &&
 			entry->subpixelMode == subpixelMode) {
-			return entry;
+			return idx;
+		}
+	}
+	return -1;
+}
+
+static NVGGlyphCacheEntry* nvg__findGlyph(NVGGlyphCache* cache, unsigned int glyphIndex, int fontId, float size, unsigned int varStateId, int hinting, int subpixelMode) {
+	int idx = nvg__lookupGlyph(cache, glyphIndex, fontId, size, varStateId, hinting, subpixelMode);
+	if (idx == -1) {
+		cache->misses++;
+		return NULL;
+	}
+
+	if (cache->lruHead != idx) {
+		nvg__glyphLruUnlink(cache, idx);
+		nvg__glyphLruPushFront(cache, idx);
+	}
+	cache->entries[idx].lastFrame = cache->frame;
+	cache->hits++;
+	return &cache->entries[idx];
+}
+
+// Lookup without touching the LRU order or the hit/miss counters
+static int nvg__peekGlyph(NVGGlyphCache* cache, unsigned int glyphIndex, int fontId, float size, unsigned int varStateId, int hinting, int subpixelMode) {
+	return nvg__lookupGlyph(cache, glyphIndex, fontId, size, varStateId, hinting, subpixelMode) != -1;
+}
+
+// Unlink an entry and put it on the free list (its atlas rect is not touched)
+static void nvg__removeGlyph(NVGGlyphCache* cache, int idx) {
+	NVGGlyphCacheEntry* entry = &cache->entries[idx];
+	nvg__glyphHashRemove(cache, idx);
+	nvg__glyphLruUnlink(cache, idx);
+
+	entry->valid = 0;
+	entry->pending = 0;
+	entry->lruNext = cache->freeList;
+	cache->freeList = idx;
+	cache->liveCount--;
+}
+
+// Evict the least recently used glyph and give its atlas rect back
+static void nvg__evictGlyph(NVGFontSystem* fs) {
+	NVGGlyphCache* cache = fs->glyphCache;
+	int idx = cache->lruTail;
+	if (idx == -1) return;
+
+	// Streaming placeholders own no atlas space
+	NVGGlyphCacheEntry* entry = &cache->entries[idx];
+	if (!entry->pending) {
+		NVGAtlas* atlas = nvg__getAtlas(fs->atlasManager, entry->srcColorSpace, entry->dstColorSpace, entry->format, entry->subpixelMode, entry->page);
+		if (atlas) {
+			nvg__atlasAddFreeRect(atlas, (int)entry->x - 1, (int)entry->y - 1, (int)entry->w + 2, (int)entry->h + 2);
 		}
 	}
-	return NULL;
+
+	nvg__removeGlyph(cache, idx);
+	cache->evictions++;
 }
 
-static NVGGlyphCacheEntry* nvg__allocGlyph(NVGGlyphCache* cache) {
-	if (cache->count >= NVG_FONT_GLYPH_CACHE_SIZE) {
-		// Evict all entries and increment generation
-		for (int i = 0; i < cache->count; i++) {
-			cache->entries[i].valid = 0;
+void nvg__dropPendingGlyphs(NVGFontSystem* fs) {
+	NVGGlyphCache* cache = fs->glyphCache;
+	for (int i = 0; i < cache->count; i++) {
+		if (cache->entries[i].valid && cache->entries[i].pending) {
+			nvg__removeGlyph(cache, i);
 		}
-		cache->count = 0;
-		cache->generation++;
 	}
-	NVGGlyphCacheEntry* entry = &cache->entries[cache->count++];
+}
+
+static void nvg__glyphHashInsert(NVGGlyphCache* cache, int idx) {
+	unsigned int mask = (unsigned int)cache->hashSize - 1;
+	unsigned int i = cache->entries[idx].hash & mask;
+	while (cache->slots[i] != 0)
+		i = (i + 1) & mask;
+	cache->slots[i] = idx + 1;
+}
+
+// Double the entry pool and rehash. Entry indices (and the LRU and free
+// list links) stay valid, entry pointers do not.
+static int nvg__growGlyphCache(NVGGlyphCache* cache) {
+	int capacity = cache->capacity * 2;
+	NVGGlyphCacheEntry* entries = (NVGGlyphCacheEntry*)realloc(cache->entries, sizeof(NVGGlyphCacheEntry) * capacity);
+	if (!entries) return 0;
+	cache->entries = entries;
+	int* slots = (int*)calloc(capacity * 2, sizeof(int));
+	if (!slots) return 0;
+
+	free(cache->slots);
+	cache->slots = slots;
+	cache->capacity = capacity;
+	cache->hashSize = capacity * 2;
+	for (int i = 0; i < cache->count; i++) {
+		if (cache->entries[i].valid)
+			nvg__glyphHashInsert(cache, i);
+	}
+	return 1;
+}
+
+// Make sure an entry is available before allocating atlas space, so the
+// evicted glyph's rect can be reused by the glyph about to be rendered.
+// The LRU tail is the oldest glyph: if even it was drawn this frame, its
+// atlas rect is still referenced by queued quads (uploads land before
+// draws), so the pool grows instead. Returns 0 if no entry is available.
+static int nvg__reserveGlyph(NVGFontSystem* fs) {
+	NVGGlyphCache* cache = fs->glyphCache;
+	if (cache->freeList != -1 || cache->count < cache->capacity) return 1;
+
+	NVGGlyphCacheEntry* tail = &cache->entries[cache->lruTail];
+	if (tail->lastFrame != cache->frame || tail->pending) {
+		nvg__evictGlyph(fs);
+		return 1;
+	}
+	return nvg__growGlyphCache(cache);
+}
+
+static NVGGlyphCacheEntry* nvg__allocGlyph(NVGFontSystem* fs, unsigned int glyphIndex, int fontId, float size, unsigned int varStateId, int hinting, int subpixelMode) {
+	NVGGlyphCache* cache = fs->glyphCache;
+	int idx;
+
+	if (!nvg__reserveGlyph(fs)) return NULL;
+	if (cache->freeList != -1) {
+		idx = cache->freeList;
+		cache->freeList = cache->entries[idx].lruNext;
+	} else {
+		idx = cache->count++;
+	}
+
+	NVGGlyphCacheEntry* entry = &cache->entries[idx];
 	memset(entry, 0, sizeof(NVGGlyphCacheEntry));
+	entry->glyphIndex = glyphIndex;
+	entry->fontId = fontId;
+	entry->size = size;
+	entry->sizeKey = nvg__glyphSizeKey(size);
+	entry->varStateId = varStateId;
+	entry->hinting = hinting;
+	entry->subpixelMode = subpixelMode;
+	entry->hash = nvg__glyphHash(glyphIndex, fontId, entry->sizeKey, varStateId, hinting, subpixelMode);
 	entry->valid = 1;
 	entry->generation = cache->generation;
+	entry->lastFrame = cache->frame;
+
+	nvg__glyphHashInsert(cache, idx);
+	nvg__glyphLruPushFront(cache, idx);
+	cache->liveCount++;
+
 	return entry;
 }
 
+void nvgFontGetGlyphCacheStats(NVGFontSystem* fs, NVGGlyphCacheStats* stats) {
+	if (!stats) return;
+	memset(stats, 0, sizeof(NVGGlyphCacheStats));
+	if (!fs || !fs->glyphCache) return;
+
+	NVGGlyphCache* cache = fs->glyphCache;
+	stats->hits = cache->hits;
+	stats->misses = cache->misses;
+	stats->evictions = cache->evictions;
+	stats->count = cache->liveCount;
+	stats->capacity = cache->capacity;
+}
+
 // Glyph-level API
 
 int nvgFontGetGlyphCount(NVGFontSystem* fs, int fontId) {
@@ -177,7 +507,7 @@ int nvgFontGetGlyphMetrics(NVGFontSystem* fs, int fontId, unsigned int codepoint
 	if (glyph_index == 0) return 0;
 
 	// Set size
-	FT_Set_Pixel_Sizes(face, 0, (FT_UInt)fs->state.size);
+	if (!nvg__acquireFontSize(fs, fontId, fs->state.size)) return 0;
 
 	// Load glyph to get metrics
 	FT_Int32 load_flags = FT_LOAD_DEFAULT;
@@ -229,92 +559,43 @@ static int nvg__hasColorLayers(NVGFontSystem* fs, int fontId, FT_Face face, unsi
 	return 1;
 }
 
-int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index, unsigned int codepoint,
-                       float x, float y, NVGCachedGlyph* quad) {
-	static int total_calls = 0;
-	total_calls++;
-	printf("[RENDER_CALL #%d] glyph %u, subpixel=%d\n", total_calls, glyph_index, fs ? fs->state.subpixelMode : -1);
-
-	if (!fs || fontId < 0 || fontId >= fs->nfonts || !quad) return 0;
+static void nvg__fillGlyphQuad(const NVGGlyphCacheEntry* entry, unsigned int codepoint, float x, float y, NVGCachedGlyph* quad) {
+	quad->codepoint = codepoint;
+	quad->x0 = x + entry->bearingX;
+	quad->y0 = y - entry->bearingY;
+	quad->x1 = quad->x0 + entry->w;
+	quad->y1 = quad->y0 + entry->h;
+	quad->s0 = entry->s0;
+	quad->t0 = entry->t0;
+	quad->s1 = entry->s1;
+	quad->t1 = entry->t1;
+	quad->advanceX = entry->advanceX;
+	quad->bearingX = entry->bearingX;
+	quad->bearingY = entry->bearingY;
+	quad->srcColorSpace = entry->srcColorSpace;
+	quad->dstColorSpace = entry->dstColorSpace;
+	quad->format = entry->format;
+	quad->subpixelMode = entry->subpixelMode;
+	quad->page = entry->page;
+	quad->generation = entry->generation;
+}
 
-	// Check cache first (use glyph_index, hinting, and subpixel mode as the key)
-	unsigned int varStateId = fs->fonts[fontId].varStateId;
-	NVGGlyphCacheEntry* entry = nvg__findGlyph(fs->glyphCache, glyph_index, fontId, fs->state.size, varStateId, fs->state.hinting, fs->state.subpixelMode);
-	if (entry) {
-		static int cache_hit_debug = 0;
-		if (cache_hit_debug++ < 20) {
-			printf("[Cache HIT #%d] glyph %u: UVs (%.4f,%.4f)-(%.4f,%.4f)\n",
-				cache_hit_debug, glyph_index, entry->s0, entry->t0, entry->s1, entry->t1);
-		}
-		quad->codepoint = codepoint;
-		quad->x0 = x + entry->bearingX;
-		quad->y0 = y - entry->bearingY;
-		quad->x1 = quad->x0 + entry->w;
-		quad->y1 = quad->y0 + entry->h;
-		quad->s0 = entry->s0;
-		quad->t0 = entry->t0;
-		quad->s1 = entry->s1;
-		quad->t1 = entry->t1;
-		quad->advanceX = entry->advanceX;
-		quad->bearingX = entry->bearingX;
-		quad->bearingY = entry->bearingY;
-		quad->srcColorSpace = entry->srcColorSpace;
-		quad->dstColorSpace = entry->dstColorSpace;
-		quad->format = entry->format;
-		quad->subpixelMode = entry->subpixelMode;
-		quad->generation = entry->generation;
-		return 1;
-	} else {
-		static int cache_miss_debug = 0;
-		if (cache_miss_debug++ < 20) {
-			printf("[Cache MISS #%d] glyph %u will be rendered\n", cache_miss_debug, glyph_index);
-		}
-	}
+// Rasterize a glyph into a padded bitmap. Only job, face and library are
+// written (fs is read for font flags), so jobs on different faces can run on
+// different threads. COLR glyphs use the shared Cairo surface and are left to
+// the main thread unless allowColor is set. The face must already be sized.
+int nvg__rasterizeGlyph(NVGFontSystem* fs, FT_Library library, FT_Face face, NVGGlyphJob* job, int allowColor) {
+	unsigned int glyph_index = job->glyphIndex;
+	int fontId = job->fontId;
+	int subpixelMode = job->subpixelMode;
 
-	// Render glyph (glyph_index is already a FreeType glyph index from HarfBuzz)
-	FT_Face face = fs->fonts[fontId].face;
+	job->data = NULL;
+	job->status = NVG_GLYPH_JOB_FAILED;
 
-	// If glyph_index is 0 (.notdef), try fallback fonts
-	if (glyph_index == 0 && codepoint != 0 && fs->fonts[fontId].nfallbacks > 0) {
-		// Find which fallback font has this codepoint
-		int fallbackFontId = nvg__findFontForCodepoint(fs, fontId, codepoint);
-		if (fallbackFontId != fontId) {
-			// Found a fallback font with this glyph
-			FT_Face fallback_face = fs->fonts[fallbackFontId].face;
-			unsigned int fallback_glyph_index = FT_Get_Char_Index(fallback_face, codepoint);
-			if (fallback_glyph_index != 0) {
-				// Recursively render with fallback font
-				return nvgFontRenderGlyph(fs, fallbackFontId, fallback_glyph_index,
-				                          codepoint, x, y, quad);
-			}
-		}
-	}
-
-	if (glyph_index == 0) return 0;
-
-	// IMPORTANT: Check for COLR data BEFORE setting size!
-	// FT_Set_Char_Size and FT_Set_Pixel_Sizes both break FT_Get_Color_Glyph_Paint
 	int isCOLREmoji = nvg__hasColorLayers(fs, fontId, face, glyph_index);
-
-	// Now set size for rendering
-	FT_Set_Pixel_Sizes(face, 0, (FT_UInt)fs->state.size);
-
-	// Re-apply variation coordinates after setting size (which may reset them)
-	if (fs->fonts[fontId].varCoordsCount > 0) {
-		FT_Fixed* ft_coords = (FT_Fixed*)malloc(sizeof(FT_Fixed) * fs->fonts[fontId].varCoordsCount);
-		if (ft_coords) {
-			for (unsigned int i = 0; i < fs->fonts[fontId].varCoordsCount; i++) {
-				ft_coords[i] = (FT_Fixed)(fs->fonts[fontId].varCoords[i] * 65536.0f);
-			}
-			FT_Set_Var_Design_Coordinates(face, fs->fonts[fontId].varCoordsCount, ft_coords);
-			free(ft_coords);
-		}
-	}
-
-	static int color_check_count = 0;
-	if (color_check_count++ < 10 || glyph_index >= 2340) {
-		printf("[nvgFontRenderGlyph] glyph %u: FT_HAS_COLOR(face)=%d, nvg__hasColorLayers returned %d\n",
-		       glyph_index, FT_HAS_COLOR(face) ? 1 : 0, isCOLREmoji);
+	if (isCOLREmoji && !allowColor) {
+		job->status = NVG_GLYPH_JOB_MAIN_THREAD;
+		return job->status;
 	}
 
 	int gw, gh;
@@ -328,7 +609,7 @@ int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index,
 		// Render COLR glyph using Cairo
 		// Load glyph to get advance
 		if (FT_Load_Glyph(face, glyph_index, FT_LOAD_DEFAULT | FT_LOAD_NO_SVG)) {
-			return 0;
+			return job->status;
 		}
 
 		FT_GlyphSlot slot = face->glyph;
@@ -377,42 +658,41 @@ int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index,
 	}
 
 	// Check if MSDF mode is enabled for this font
-	int useMSDF = (fs->fonts[fontId].msdfMode > 0);
+	int msdfMode = job->msdfMode;
+	int useMSDF = (msdfMode > 0);
 
 	if (!isCOLREmoji) {
 		// Check if we should generate MSDF/SDF
 		if (useMSDF) {
 			// Load glyph outline for distance field generation
 			FT_Int32 load_flags = FT_LOAD_NO_BITMAP;
-			if (!fs->state.hinting) {
+			if (!job->hinting) {
 				load_flags |= FT_LOAD_NO_HINTING;
 			}
 			if (FT_Load_Glyph(face, glyph_index, load_flags)) {
-				return 0;
+				return job->status;
 			}
 
 			FT_GlyphSlot slot = face->glyph;
 			if (slot->format != FT_GLYPH_FORMAT_OUTLINE) {
-				return 0;
+				return job->status;
 			}
 
-			// Calculate MSDF dimensions (larger than glyph for distance field range)
 			// Use 64x64 as base size with distance field range
-			int msdfRange = 16;  // pixels
 			gw = 64;
 			gh = 64;
 		} else {
 			// Regular grayscale or LCD subpixel rendering
 			FT_Int32 load_flags = FT_LOAD_RENDER;
-			if (!fs->state.hinting) {
+			if (!job->hinting) {
 				load_flags |= FT_LOAD_NO_HINTING;
 			}
 
 			// Set LCD filter and target for subpixel rendering
-			if (fs->state.subpixelMode != NVG_SUBPIXEL_NONE) {
-				FT_Library_SetLcdFilter(fs->ftLibrary, FT_LCD_FILTER_DEFAULT);
+			if (subpixelMode != NVG_SUBPIXEL_NONE) {
+				FT_Library_SetLcdFilter(library, FT_LCD_FILTER_DEFAULT);
 
-				switch (fs->state.subpixelMode) {
+				switch (subpixelMode) {
 					case NVG_SUBPIXEL_RGB:
 					case NVG_SUBPIXEL_BGR:
 						load_flags |= FT_LOAD_TARGET_LCD;
@@ -427,31 +707,28 @@ int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index,
 			}
 
 			if (FT_Load_Glyph(face, glyph_index, load_flags)) {
-				return 0;
+				return job->status;
 			}
 
 			FT_GlyphSlot slot = face->glyph;
 			if (slot->format != FT_GLYPH_FORMAT_BITMAP) {
-				return 0;
+				return job->status;
 			}
 
-			// Allocate space in atlas
 			// For LCD rendering, bitmap width is 3x wider (RGB subpixels)
 			gw = (int)slot->bitmap.width;
 			gh = (int)slot->bitmap.rows;
 
 			// For horizontal LCD, width is already 3x, divide by 3 for logical width
 			// For vertical LCD, height is 3x
-			if (fs->state.subpixelMode == NVG_SUBPIXEL_RGB || fs->state.subpixelMode == NVG_SUBPIXEL_BGR) {
+			if (subpixelMode == NVG_SUBPIXEL_RGB || subpixelMode == NVG_SUBPIXEL_BGR) {
 				// Horizontal LCD - width is 3x
 				gw = gw / 3;
-			} else if (fs->state.subpixelMode == NVG_SUBPIXEL_VRGB || fs->state.subpixelMode == NVG_SUBPIXEL_VBGR) {
+			} else if (subpixelMode == NVG_SUBPIXEL_VRGB || subpixelMode == NVG_SUBPIXEL_VBGR) {
 				// Vertical LCD - height is 3x
 				gh = gh / 3;
 			}
 		}
-	} else {
-		// For COLR, we already have gw/gh from metrics
 	}
 
 	FT_GlyphSlot slot = face->glyph;
@@ -462,19 +739,17 @@ int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index,
 	// - LCD subpixel: No color space (linear RGB subpixels, not sRGB)
 	// - MSDF: No color space (distance field)
 	// - Grayscale: No color space (single channel alpha)
-	int useSubpixel = (fs->state.subpixelMode != NVG_SUBPIXEL_NONE && !isCOLREmoji && !useMSDF);
+	int useSubpixel = (subpixelMode != NVG_SUBPIXEL_NONE && !isCOLREmoji && !useMSDF);
 
-	NVGcolorSpace srcColorSpace;
-	NVGcolorSpace dstColorSpace;
 	if (isCOLREmoji) {
 		// COLR emoji uses sRGB (Cairo outputs sRGB)
-		srcColorSpace = NVG_COLOR_SPACE_SRGB_NONLINEAR;
-		dstColorSpace = fs->targetColorSpace;
+		job->srcColorSpace = NVG_COLOR_SPACE_SRGB_NONLINEAR;
+		job->dstColorSpace = fs->targetColorSpace;
 	} else {
 		// LCD, MSDF, and grayscale: intensity/coverage values, no color space conversion
 		// Use (NVGcolorSpace)-1 as sentinel to indicate "no color space"
-		srcColorSpace = (NVGcolorSpace)-1;
-		dstColorSpace = (NVGcolorSpace)-1;
+		job->srcColorSpace = (NVGcolorSpace)-1;
+		job->dstColorSpace = (NVGcolorSpace)-1;
 	}
 
 	// Determine format based on rendering mode:
@@ -482,127 +757,29 @@ int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index,
 	// - MSDF: RGBA (4 channels for multi-channel distance field)
 	// - LCD subpixel: RGBA (3 RGB channels + alpha, stored as RGBA)
 	// - Grayscale: ALPHA (1 channel)
-	NVGtextureFormat format = isCOLREmoji ? NVG_TEXTURE_FORMAT_R8G8B8A8_UNORM :
-	                  (useMSDF ? NVG_TEXTURE_FORMAT_R8G8B8A8_UNORM :
-	                  (useSubpixel ? NVG_TEXTURE_FORMAT_R8G8B8A8_UNORM : NVG_TEXTURE_FORMAT_R8_UNORM));
-
-	static int alloc_debug = 0;
-	if (alloc_debug++ < 20) {
-		printf("[Glyph %u] gw=%d, gh=%d, srcCS=%u, dstCS=%u, fmt=%u\n",
-			glyph_index, gw, gh, srcColorSpace, dstColorSpace, format);
-	}
-
-	int ax, ay;
-	int subpixelMode = fs->state.subpixelMode;
-	if (!nvgAtlasAlloc(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, gw + 2, gh + 2, &ax, &ay)) {
-		// Atlas full - try to grow atlas
-		printf("[nvgFontRenderGlyph] Atlas alloc failed for glyph %u (%dx%d), srcCS=%u, dstCS=%u, fmt=%u, subpixel=%d - trying to grow\n",
-			glyph_index, gw + 2, gh + 2, srcColorSpace, dstColorSpace, format, subpixelMode);
-		int newWidth = 0, newHeight = 0;
-		if (nvgAtlasGrow(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, &newWidth, &newHeight)) {
-			// Atlas was grown, try allocation again
-			if (!nvgAtlasAlloc(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, gw + 2, gh + 2, &ax, &ay)) {
-				// Still failed after growth
-				printf("[nvgFontRenderGlyph] ERROR: Atlas alloc still failed after growth!\n");
-				return 0;
-			}
-		} else {
-			// Growth failed
-			printf("[nvgFontRenderGlyph] ERROR: Atlas grow failed!\n");
-			return 0;
-		}
-	}
-
-	// Get atlas for dimensions (use format-aware lookup to distinguish ALPHA vs RGBA with same color spaces)
-	NVGAtlas* atlas = nvg__getAtlas(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode);
-	if (!atlas) {
-		printf("[nvgFontRenderGlyph] ERROR: nvg__getAtlas returned NULL after allocation! srcCS=%u, dstCS=%u, fmt=%u\n",
-			srcColorSpace, dstColorSpace, format);
-		return 0;
-	}
-
-	// Create cache entry
-	entry = nvg__allocGlyph(fs->glyphCache);
-	entry->glyphIndex = glyph_index;
-	entry->fontId = fontId;
-	entry->size = fs->state.size;
-	entry->hinting = fs->state.hinting;
-	entry->subpixelMode = fs->state.subpixelMode;
-	entry->varStateId = varStateId;
-
-	static int entry_debug = 0;
-	if (entry_debug++ < 10) {
-		printf("[Cache entry created #%d] glyph %u, subpixelMode=%d\n",
-			entry_debug, glyph_index, entry->subpixelMode);
-	}
-	entry->srcColorSpace = srcColorSpace;
-	entry->dstColorSpace = dstColorSpace;
-	entry->format = format;
-	entry->subpixelMode = subpixelMode;
-
-	entry->x = (float)(ax + 1);
-	entry->y = (float)(ay + 1);
-	entry->w = (float)gw;
-	entry->h = (float)gh;
-	entry->s0 = entry->x / (float)atlas->width;
-	entry->t0 = entry->y / (float)atlas->height;
-	entry->s1 = (entry->x + entry->w) / (float)atlas->width;
-	entry->t1 = (entry->y + entry->h) / (float)atlas->height;
+	job->format = isCOLREmoji ? NVG_TEXTURE_FORMAT_R8G8B8A8_UNORM :
+	              (useMSDF ? NVG_TEXTURE_FORMAT_R8G8B8A8_UNORM :
+	              (useSubpixel ? NVG_TEXTURE_FORMAT_R8G8B8A8_UNORM : NVG_TEXTURE_FORMAT_R8_UNORM));
 
-	static int coord_debug = 0;
-	if (coord_debug++ < 35) {
-		printf("[Tex coord calc #%d] glyph %u, entry (%.1f,%.1f) size (%.1f,%.1f), atlas dim (%d,%d) @ %p -> coords (%.4f,%.4f)-(%.4f,%.4f)\n",
-			coord_debug, glyph_index,
-			entry->x, entry->y, entry->w, entry->h,
-			atlas->width, atlas->height, (void*)atlas,
-			entry->s0, entry->t0, entry->s1, entry->t1);
-	}
-	entry->advanceX = (float)slot->advance.x / 64.0f;
+	job->gw = gw;
+	job->gh = gh;
+	job->advanceX = (float)slot->advance.x / 64.0f;
 	// For COLR glyphs, use metrics-based bearings; for bitmap glyphs, use bitmap_left/top
 	if (isCOLREmoji) {
-		entry->bearingX = colr_bearingX;
-		entry->bearingY = colr_bearingY;
+		job->bearingX = colr_bearingX;
+		job->bearingY = colr_bearingY;
 	} else {
-		entry->bearingX = (float)slot->bitmap_left;
-		entry->bearingY = (float)slot->bitmap_top;
+		job->bearingX = (float)slot->bitmap_left;
+		job->bearingY = (float)slot->bitmap_top;
 	}
 
-	// Apply UV inset to prevent linear filtering from sampling adjacent glyphs
-	// With linear filtering, sampling at edges blends with neighboring texels
-	// Inset by 0.5 pixels to stay within glyph bounds
-	float uvInsetX = 0.5f / (float)atlas->width;
-	float uvInsetY = 0.5f / (float)atlas->height;
-	entry->s0 += uvInsetX;
-	entry->t0 += uvInsetY;
-	entry->s1 -= uvInsetX;
-	entry->t1 -= uvInsetY;
-
-	// Fill quad
-	quad->codepoint = codepoint;
-	quad->x0 = x + entry->bearingX;
-	quad->y0 = y - entry->bearingY;
-	quad->x1 = quad->x0 + entry->w;
-	quad->y1 = quad->y0 + entry->h;
-	quad->s0 = entry->s0;
-	quad->t0 = entry->t0;
-	quad->s1 = entry->s1;
-	quad->t1 = entry->t1;
-	quad->advanceX = entry->advanceX;
-	quad->bearingX = entry->bearingX;
-	quad->bearingY = entry->bearingY;
-	quad->srcColorSpace = srcColorSpace;
-	quad->dstColorSpace = dstColorSpace;
-	quad->format = format;
-	quad->subpixelMode = subpixelMode;
-	quad->generation = entry->generation;
-
-	// Upload bitmap data to atlas
+	// Build the padded bitmap (1px border of zeros around the glyph)
 	if (gw > 0 && gh > 0) {
 		int padded_w = gw + 2;
 		int padded_h = gh + 2;
 
 		if (isCOLREmoji && rgba_data) {
-			// Upload RGBA color emoji
+			// RGBA color emoji
 			int bytes_per_pixel = 4;
 			unsigned char* data = (unsigned char*)calloc(padded_w * padded_h * bytes_per_pixel, 1);
 			if (data) {
@@ -612,19 +789,11 @@ int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index,
 					       rgba_data + y * gw * bytes_per_pixel,
 					       gw * bytes_per_pixel);
 				}
-
-				static int upload_debug_color = 0;
-				if (upload_debug_color++ < 10) {
-					printf("[Atlas RGBA upload #%d] glyph %u to (%d,%d) size %dx%d (glyph %dx%d + 2px padding)\n",
-						upload_debug_color, glyph_index, ax, ay, padded_w, padded_h, gw, gh);
-				}
-				nvgAtlasUpdate(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, (int)ax, (int)ay, padded_w, padded_h, data);
-				free(data);
+				job->data = data;
 			}
-			free(rgba_data);
 		} else if (useMSDF) {
-			// Generate and upload MSDF
-			int bytes_per_pixel = (fs->fonts[fontId].msdfMode == 2) ? 4 : 1;  // MSDF=RGB(4), SDF=ALPHA(1)
+			// Generate MSDF
+			int bytes_per_pixel = (msdfMode == 2) ? 4 : 1;  // MSDF=RGB(4), SDF=ALPHA(1)
 			unsigned char* msdf_data = (unsigned char*)calloc(gw * gh * bytes_per_pixel, 1);
 
 			if (msdf_data) {
@@ -639,7 +808,7 @@ int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index,
 				params.offsetY = 0;
 
 				// Generate MSDF or SDF
-				if (fs->fonts[fontId].msdfMode == 2) {
+				if (msdfMode == 2) {
 					vknvg__generateMSDF(slot, msdf_data, &params);
 				} else {
 					vknvg__generateSDF(slot, msdf_data, &params);
@@ -654,57 +823,31 @@ int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index,
 						       msdf_data + y * gw * bytes_per_pixel,
 						       gw * bytes_per_pixel);
 					}
-
-					nvgAtlasUpdate(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, (int)ax, (int)ay, padded_w, padded_h, data);
-					free(data);
+					job->data = data;
 				}
 				free(msdf_data);
 			}
-		} else if (fs->state.subpixelMode != NVG_SUBPIXEL_NONE) {
-			// Upload LCD subpixel bitmap (3 bytes per pixel RGB -> 4 bytes RGBA)
+		} else if (subpixelMode != NVG_SUBPIXEL_NONE) {
+			// LCD subpixel bitmap (3 bytes per pixel RGB -> 4 bytes RGBA)
 			int pitch = abs(slot->bitmap.pitch);
 			unsigned char* data = (unsigned char*)calloc(padded_w * padded_h * 4, 1);
 			if (data) {
-				// DEBUG: Print bitmap info and sample bytes from middle of glyph
-			printf("[LCD] glyph %u: pixel_mode=%d, width=%d, rows=%d, pitch=%d\n",
-				glyph_index, slot->bitmap.pixel_mode, slot->bitmap.width, slot->bitmap.rows, pitch);
-			if (slot->bitmap.buffer && slot->bitmap.rows > 5) {
-				int mid_row = slot->bitmap.rows / 2;
-				int mid_col = slot->bitmap.width / 2;
-				if (mid_col >= 3) {
-					mid_col = (mid_col / 3) * 3;  // Align to pixel boundary
-					printf("[LCD] Mid glyph (row=%d, col=%d): bytes %d %d %d\n",
-						mid_row, mid_col,
-						slot->bitmap.buffer[mid_row*pitch+mid_col],
-						slot->bitmap.buffer[mid_row*pitch+mid_col+1],
-						slot->bitmap.buffer[mid_row*pitch+mid_col+2]);
-				}
-			}
-
-			// Copy LCD RGB data to center of padded buffer as RGBA (leaving 1px border)
+				// Copy LCD RGB data to center of padded buffer as RGBA (leaving 1px border)
 				for (int y = 0; y < gh; y++) {
 					unsigned char* src = slot->bitmap.buffer + y * pitch;
 					unsigned char* dst = data + ((y + 1) * padded_w + 1) * 4;
 
 					for (int x = 0; x < gw; x++) {
-						// For horizontal LCD, bitmap has 3x width in bytes
-						// For vertical LCD, bitmap has 3x height
-						int src_offset;
-						if (fs->state.subpixelMode == NVG_SUBPIXEL_RGB || fs->state.subpixelMode == NVG_SUBPIXEL_BGR) {
-							// Horizontal LCD: each pixel has 3 subpixels side-by-side
-							src_offset = x * 3;
-						} else {
-							// Vertical LCD: subpixels are stacked vertically
-							// Each logical pixel still has RGB components in sequence
-							src_offset = x * 3;
-						}
+						// Horizontal LCD: 3 subpixels side-by-side per pixel.
+						// Vertical LCD: each logical pixel still has RGB components in sequence.
+						int src_offset = x * 3;
 
 						unsigned char r = src[src_offset + 0];
 						unsigned char g = src[src_offset + 1];
 						unsigned char b = src[src_offset + 2];
 
 						// Handle BGR vs RGB ordering
-						if (fs->state.subpixelMode == NVG_SUBPIXEL_BGR || fs->state.subpixelMode == NVG_SUBPIXEL_VBGR) {
+						if (subpixelMode == NVG_SUBPIXEL_BGR || subpixelMode == NVG_SUBPIXEL_VBGR) {
 							// BGR modes - swap red and blue
 							unsigned char tmp = r;
 							r = b;
@@ -717,20 +860,10 @@ int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index,
 						dst[x * 4 + 3] = 255;  // Full opacity
 					}
 				}
-
-				static int lcd_debug = 0;
-				if (lcd_debug++ < 3) {
-					printf("[Atlas LCD upload #%d] glyph %u to (%d,%d) size %dx%d (glyph %dx%d + 2px padding) subpixel=%d\n",
-						lcd_debug, glyph_index, ax, ay, padded_w, padded_h, gw, gh, fs->state.subpixelMode);
-					// Debug: print first few pixels
-					printf("[LCD DEBUG] First pixel RGB: (%d,%d,%d), bitmap.pixel_mode=%d, bitmap.width=%d\n",
-						data[4], data[5], data[6], slot->bitmap.pixel_mode, slot->bitmap.width);
-				}
-				nvgAtlasUpdate(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, (int)ax, (int)ay, padded_w, padded_h, data);
-				free(data);
+				job->data = data;
 			}
 		} else {
-			// Upload grayscale bitmap
+			// Grayscale bitmap
 			int pitch = abs(slot->bitmap.pitch);
 			unsigned char* data = (unsigned char*)calloc(padded_w * padded_h, 1);
 			if (data) {
@@ -740,41 +873,352 @@ int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index,
 					       slot->bitmap.buffer + y * pitch,
 					       gw);
 				}
-
-				static int upload_debug = 0;
-				if (upload_debug++ < 3) {
-					printf("[Atlas ALPHA upload #%d] glyph %u to (%d,%d) size %dx%d (glyph %dx%d + 2px padding)\n",
-						upload_debug, glyph_index, ax, ay, padded_w, padded_h, gw, gh);
-					if (gw > 5 && gh > 5) {
-						int mid_y = gh / 2 + 1;  // +1 for padding
-						int mid_x = gw / 2 + 1;  // +1 for padding
-						printf("[ALPHA DEBUG] Mid pixel [%d,%d]: %d, Corner [1,1]: %d, raw bitmap [%d,%d]: %d\n",
-							mid_y, mid_x, data[mid_y * padded_w + mid_x],
-							data[1 * padded_w + 1],
-							gh/2, gw/2, slot->bitmap.buffer[(gh/2)*pitch + (gw/2)]);
-						// Print a small section of the bitmap
-						printf("[BITMAP DUMP] First 5x5 pixels:\n");
-						for (int y = 0; y < 5 && y < gh; y++) {
-							for (int x = 0; x < 5 && x < gw; x++) {
-								printf("%3d ", slot->bitmap.buffer[y*pitch + x]);
-							}
-							printf("\n");
-						}
-					}
-				}
-				nvgAtlasUpdate(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, (int)ax, (int)ay, padded_w, padded_h, data);
-				free(data);
+				job->data = data;
 			}
 		}
 	}
+	free(rgba_data);
+
+	job->status = NVG_GLYPH_JOB_DONE;
+	return job->status;
+}
+
+// Allocate atlas space for a rasterized job, create its cache entry and
+// upload the bitmap. Frees job->data. Returns NULL if the atlas is full.
+NVGGlyphCacheEntry* nvg__commitGlyph(NVGFontSystem* fs, NVGGlyphJob* job) {
+	NVGcolorSpace srcColorSpace = job->srcColorSpace;
+	NVGcolorSpace dstColorSpace = job->dstColorSpace;
+	NVGtextureFormat format = job->format;
+	int subpixelMode = job->subpixelMode;
+	int gw = job->gw;
+	int gh = job->gh;
+	unsigned int glyph_index = job->glyphIndex;
+
+	// A full atlas gets a new page, so existing glyphs never move
+	int ax, ay, page;
+	if (!nvg__reserveGlyph(fs)) {
+		free(job->data);
+		job->data = NULL;
+		return NULL;
+	}
+	if (!nvgAtlasAlloc(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, gw + 2, gh + 2, &ax, &ay, &page)) {
+		printf("[nvgFontRenderGlyph] ERROR: Atlas alloc failed for glyph %u (%dx%d), srcCS=%u, dstCS=%u, fmt=%u, subpixel=%d\n",
+			glyph_index, gw + 2, gh + 2, srcColorSpace, dstColorSpace, format, subpixelMode);
+		free(job->data);
+		job->data = NULL;
+		return NULL;
+	}
+
+	// Get atlas for dimensions (use format-aware lookup to distinguish ALPHA vs RGBA with same color spaces)
+	NVGAtlas* atlas = nvg__getAtlas(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, page);
+	if (!atlas) {
+		printf("[nvgFontRenderGlyph] ERROR: nvg__getAtlas returned NULL after allocation! srcCS=%u, dstCS=%u, fmt=%u\n",
+			srcColorSpace, dstColorSpace, format);
+		free(job->data);
+		job->data = NULL;
+		return NULL;
+	}
+
+	// Create cache entry
+	NVGGlyphCacheEntry* entry = nvg__allocGlyph(fs, glyph_index, job->fontId, job->size, job->varStateId, job->hinting, subpixelMode);
+	if (!entry) {
+		free(job->data);
+		job->data = NULL;
+		return NULL;
+	}
+	entry->srcColorSpace = srcColorSpace;
+	entry->dstColorSpace = dstColorSpace;
+	entry->format = format;
+	entry->page = page;
+
+	entry->x = (float)(ax + 1);
+	entry->y = (float)(ay + 1);
+	entry->w = (float)gw;
+	entry->h = (float)gh;
+	entry->s0 = entry->x / (float)atlas->width;
+	entry->t0 = entry->y / (float)atlas->height;
+	entry->s1 = (entry->x + entry->w) / (float)atlas->width;
+	entry->t1 = (entry->y + entry->h) / (float)atlas->height;
+	entry->advanceX = job->advanceX;
+	entry->bearingX = job->bearingX;
+	entry->bearingY = job->bearingY;
+
+	// Apply UV inset to prevent linear filtering from sampling adjacent glyphs
+	// With linear filtering, sampling at edges blends with neighboring texels
+	// Inset by 0.5 pixels to stay within glyph bounds
+	float uvInsetX = 0.5f / (float)atlas->width;
+	float uvInsetY = 0.5f / (float)atlas->height;
+	entry->s0 += uvInsetX;
+	entry->t0 += uvInsetY;
+	entry->s1 -= uvInsetX;
+	entry->t1 -= uvInsetY;
+
+	// Upload bitmap data to atlas
+	if (job->data) {
+		nvgAtlasUpdate(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, page, ax, ay, gw + 2, gh + 2, job->data);
+		free(job->data);
+		job->data = NULL;
+	}
+
+	return entry;
+}
+
+// Resolve .notdef to a fallback font glyph, like nvgFontRenderGlyph does
+static void nvg__resolveFallbackGlyph(NVGFontSystem* fs, int* fontId, unsigned int* glyph_index, unsigned int codepoint) {
+	if (*glyph_index != 0 || codepoint == 0 || fs->fonts[*fontId].nfallbacks == 0) return;
+
+	int fallbackFontId = nvg__findFontForCodepoint(fs, *fontId, codepoint);
+	if (fallbackFontId != *fontId) {
+		unsigned int fallback_glyph_index = FT_Get_Char_Index(fs->fonts[fallbackFontId].face, codepoint);
+		if (fallback_glyph_index != 0) {
+			*fontId = fallbackFontId;
+			*glyph_index = fallback_glyph_index;
+		}
+	}
+}
+
+static void nvg__initGlyphJob(NVGFontSystem* fs, NVGGlyphJob* job, int fontId, unsigned int glyph_index, unsigned int codepoint) {
+	memset(job, 0, sizeof(NVGGlyphJob));
+	job->glyphIndex = glyph_index;
+	job->codepoint = codepoint;
+	job->fontId = fontId;
+	job->size = fs->state.size;
+	job->hinting = fs->state.hinting;
+	job->subpixelMode = fs->state.subpixelMode;
+	job->varStateId = fs->fonts[fontId].varStateId;
+	job->msdfMode = fs->fonts[fontId].msdfMode;
+	job->varCoordsCount = fs->fonts[fontId].varCoordsCount;
+	memcpy(job->varCoords, fs->fonts[fontId].varCoords, sizeof(float) * job->varCoordsCount);
+	job->status = NVG_GLYPH_JOB_PENDING;
+}
+
+// Rasterize a job on the calling thread with the font system's own faces
+static int nvg__rasterizeGlyphMain(NVGFontSystem* fs, NVGGlyphJob* job) {
+	// A streamed job may outlive the variation it was queued for
+	if (job->varStateId != fs->fonts[job->fontId].varStateId ||
+		!nvg__acquireFontSize(fs, job->fontId, job->size)) {
+		job->status = NVG_GLYPH_JOB_FAILED;
+		return job->status;
+	}
+	return nvg__rasterizeGlyph(fs, fs->ftLibrary, fs->fonts[job->fontId].face, job, 1);
+}
 
-	if (total_calls == 150) {
-		printf("[FINAL] Total nvgFontRenderGlyph calls: %d\n", total_calls);
+// Glyph streaming
+
+int nvg__streamingActive(NVGFontSystem* fs) {
+	if (!fs->streaming || fs->rasterThreads == 0) return 0;
+	if (!fs->rasterPool) {
+		fs->rasterPool = nvg__rasterPoolCreate(fs, fs->rasterThreads);
+	}
+	return fs->rasterPool != NULL;
+}
+
+// Submit a miss to the workers and cache a pending placeholder so it is only
+// requested once. Returns 0 if the queue is full (render it synchronously).
+static int nvg__streamGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index, unsigned int codepoint) {
+	if (fs->streamInFlight >= NVG_FONT_STREAM_QUEUE_SIZE) return 0;
+
+	NVGGlyphJob* job = (NVGGlyphJob*)malloc(sizeof(NVGGlyphJob));
+	if (!job) return 0;
+	nvg__initGlyphJob(fs, job, fontId, glyph_index, codepoint);
+	if (!nvg__rasterPoolSubmit(fs->rasterPool, job)) {
+		free(job);
+		return 0;
 	}
+	fs->streamInFlight++;
 
+	// Without a placeholder the glyph is simply requested again next frame
+	NVGGlyphCacheEntry* entry = nvg__allocGlyph(fs, glyph_index, fontId, job->size, job->varStateId, job->hinting, job->subpixelMode);
+	if (entry) entry->pending = 1;
 	return 1;
 }
 
+// Replace the placeholder of a finished streamed job with the real glyph.
+// Returns 1 if the glyph was added to the atlas.
+static int nvg__commitStreamedGlyph(NVGFontSystem* fs, NVGGlyphJob* job) {
+	NVGGlyphCache* cache = fs->glyphCache;
+	int idx = nvg__lookupGlyph(cache, job->glyphIndex, job->fontId, job->size, job->varStateId, job->hinting, job->subpixelMode);
+
+	// Already rendered synchronously after streaming was turned off
+	if (idx != -1 && !cache->entries[idx].pending) return 0;
+
+	if (job->status == NVG_GLYPH_JOB_MAIN_THREAD) {
+		nvg__rasterizeGlyphMain(fs, job);
+	}
+	// Failed glyphs keep their placeholder and stay blank instead of being requested every frame
+	if (job->status != NVG_GLYPH_JOB_DONE) return 0;
+
+	if (idx != -1) {
+		nvg__removeGlyph(cache, idx);
+	}
+	return nvg__commitGlyph(fs, job) != NULL;
+}
+
+static double nvg__streamClockMs(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
+void nvgFontBeginFrame(NVGFontSystem* fs) {
+	if (!fs) return;
+
+	// Glyphs drawn last frame may be evicted again
+	fs->glyphCache->frame++;
+	if (!fs->rasterPool || fs->streamInFlight == 0) return;
+
+	// At least one glyph per frame so a tiny budget still makes progress
+	double start = nvg__streamClockMs();
+	NVGGlyphJob* job;
+	while ((job = nvg__rasterPoolPoll(fs->rasterPool)) != NULL) {
+		fs->streamInFlight--;
+		if (nvg__commitStreamedGlyph(fs, job) && fs->glyphReadyCallback) {
+			fs->glyphReadyCallback(fs->glyphReadyUserdata, job->fontId, job->codepoint, job->size);
+		}
+		free(job->data);
+		free(job);
+
+		if (nvg__streamClockMs() - start >= fs->streamBudgetMs) break;
+	}
+}
+
+void nvgFontSetStreaming(NVGFontSystem* fs, int enabled, float budgetMs) {
+	if (!fs) return;
+	fs->streaming = enabled ? 1 : 0;
+	fs->streamBudgetMs = budgetMs > 0.0f ? budgetMs : NVG_FONT_STREAM_BUDGET_MS;
+}
+
+void nvgFontSetGlyphReadyCallback(NVGFontSystem* fs, NVGGlyphReadyFunc callback, void* uptr) {
+	if (!fs) return;
+	fs->glyphReadyCallback = callback;
+	fs->glyphReadyUserdata = uptr;
+}
+
+int nvgFontRenderGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index, unsigned int codepoint,
+                       float x, float y, NVGCachedGlyph* quad) {
+	if (!fs || fontId < 0 || fontId >= fs->nfonts || !quad) return 0;
+
+	// Check cache first (use glyph_index, hinting, and subpixel mode as the key)
+	unsigned int varStateId = fs->fonts[fontId].varStateId;
+	NVGGlyphCacheEntry* entry = nvg__findGlyph(fs->glyphCache, glyph_index, fontId, fs->state.size, varStateId, fs->state.hinting, fs->state.subpixelMode);
+	if (entry && entry->pending) {
+		// Still streaming: draw blank, or render now if streaming was turned off
+		if (nvg__streamingActive(fs)) return 0;
+		nvg__removeGlyph(fs->glyphCache, (int)(entry - fs->glyphCache->entries));
+		entry = NULL;
+	}
+	if (entry) {
+		nvg__fillGlyphQuad(entry, codepoint, x, y, quad);
+		return 1;
+	}
+
+	// If glyph_index is 0 (.notdef), try fallback fonts
+	int renderFontId = fontId;
+	nvg__resolveFallbackGlyph(fs, &renderFontId, &glyph_index, codepoint);
+	if (renderFontId != fontId) {
+		return nvgFontRenderGlyph(fs, renderFontId, glyph_index, codepoint, x, y, quad);
+	}
+
+	if (glyph_index == 0) return 0;
+
+	// Hand the miss to the workers and leave it blank for this frame
+	if (nvg__streamingActive(fs) && nvg__streamGlyph(fs, fontId, glyph_index, codepoint)) {
+		return 0;
+	}
+
+	// Render glyph (glyph_index is already a FreeType glyph index from HarfBuzz)
+	NVGGlyphJob job;
+	nvg__initGlyphJob(fs, &job, fontId, glyph_index, codepoint);
+	if (nvg__rasterizeGlyphMain(fs, &job) != NVG_GLYPH_JOB_DONE) {
+		return 0;
+	}
+
+	entry = nvg__commitGlyph(fs, &job);
+	if (!entry) {
+		return 0;
+	}
+
+	nvg__fillGlyphQuad(entry, codepoint, x, y, quad);
+	return 1;
+}
+
+// Batched rasterization
+
+void nvg__queueGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index, unsigned int codepoint) {
+	if (fontId < 0 || fontId >= fs->nfonts) return;
+
+	nvg__resolveFallbackGlyph(fs, &fontId, &glyph_index, codepoint);
+	if (glyph_index == 0) return;
+
+	if (nvg__peekGlyph(fs->glyphCache, glyph_index, fontId, fs->state.size, fs->fonts[fontId].varStateId, fs->state.hinting, fs->state.subpixelMode)) {
+		return;
+	}
+
+	// Size, hinting and subpixel mode are the same for the whole batch
+	for (int i = 0; i < fs->nglyphJobs; i++) {
+		if (fs->glyphJobs[i].glyphIndex == glyph_index && fs->glyphJobs[i].fontId == fontId) {
+			return;
+		}
+	}
+
+	if (fs->nglyphJobs + 1 > fs->cglyphJobs) {
+		int cglyphJobs = fs->cglyphJobs == 0 ? 64 : fs->cglyphJobs * 2;
+		NVGGlyphJob* jobs = (NVGGlyphJob*)realloc(fs->glyphJobs, sizeof(NVGGlyphJob) * cglyphJobs);
+		if (!jobs) return;
+		fs->glyphJobs = jobs;
+		fs->cglyphJobs = cglyphJobs;
+	}
+
+	nvg__initGlyphJob(fs, &fs->glyphJobs[fs->nglyphJobs++], fontId, glyph_index, codepoint);
+}
+
+void nvg__flushGlyphJobs(NVGFontSystem* fs) {
+	int count = fs->nglyphJobs;
+	if (count == 0) return;
+
+	// Rasterize in parallel when the batch is worth waking the workers
+	if (fs->rasterThreads > 0 && count >= NVG_FONT_RASTER_MIN_BATCH) {
+		if (!fs->rasterPool) {
+			fs->rasterPool = nvg__rasterPoolCreate(fs, fs->rasterThreads);
+		}
+		if (fs->rasterPool) {
+			nvg__rasterPoolRun(fs->rasterPool, fs->glyphJobs, count);
+		}
+	}
+
+	// Commit in queue order so atlas placement does not depend on thread timing
+	for (int i = 0; i < count; i++) {
+		NVGGlyphJob* job = &fs->glyphJobs[i];
+		if (job->status == NVG_GLYPH_JOB_PENDING || job->status == NVG_GLYPH_JOB_MAIN_THREAD) {
+			nvg__rasterizeGlyphMain(fs, job);
+		}
+		if (job->status == NVG_GLYPH_JOB_DONE) {
+			nvg__commitGlyph(fs, job);
+		}
+		free(job->data);
+		job->data = NULL;
+	}
+
+	fs->nglyphJobs = 0;
+}
+
+void nvgFontSetRasterThreads(NVGFontSystem* fs, int count) {
+	if (!fs) return;
+	if (count < 0) count = 0;
+	if (count > NVG_FONT_MAX_RASTER_THREADS) count = NVG_FONT_MAX_RASTER_THREADS;
+	if (count == fs->rasterThreads) return;
+
+	// Workers are (re)started lazily by the next large batch. Streamed jobs
+	// die with the pool, so their placeholders go too and get requested again.
+	if (fs->rasterPool) {
+		nvg__rasterPoolDestroy(fs->rasterPool);
+		fs->rasterPool = NULL;
+		fs->streamInFlight = 0;
+		nvg__dropPendingGlyphs(fs);
+	}
+	fs->rasterThreads = count;
+}
+
 // Font measurement
 
 void nvgFontVertMetrics(NVGFontSystem* fs, float* ascender, float* descender, float* lineh) {
@@ -786,7 +1230,6 @@ void nvgFontVertMetrics(NVGFontSystem* fs, float* ascender, float* descender, fl
 	}
 
 	FT_Face face = fs->fonts[fs->state.fontId].face;
-	FT_Set_Pixel_Sizes(face, 0, (FT_UInt)fs->state.size);
 
 	float scale = fs->state.size / (float)face->units_per_EM;
 	if (ascender) *ascender = (float)face->ascender * scale;
@@ -802,7 +1245,6 @@ float nvgFontLineBounds(NVGFontSystem* fs, float y, float* miny, float* maxy) {
 	}
 
 	FT_Face face = fs->fonts[fs->state.fontId].face;
-	FT_Set_Pixel_Sizes(face, 0, (FT_UInt)fs->state.size);
 
 	float scale = fs->state.size / (float)face->units_per_EM;
 	float ascender = (float)face->ascender * scale;
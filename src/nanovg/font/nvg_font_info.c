@@ -40,8 +40,9 @@ int nvgFont__SetVarDesignCoords(NVGFontSystem* fs, int fontId, const float* coor
 			fs->fonts[fontId].hb_font = hb_ft_font_create(face, NULL);
 		}
 
-		// Increment variation state ID - this invalidates cached glyphs for this font
+		// Increment variation state ID - this invalidates cached glyphs and pooled sizes for this font
 		fs->fonts[fontId].varStateId++;
+		nvg__releaseFontSizes(fs, fontId);
 		printf("[nvgFont__SetVarDesignCoords] Font %d varStateId -> %u\n",
 			fontId, fs->fonts[fontId].varStateId);
 	} else {
@@ -100,6 +101,26 @@ int nvgFont__SetNamedInstance(NVGFontSystem* fs, int fontId, unsigned int instan
 		fs->fonts[fontId].hb_font = hb_ft_font_create(face, NULL);
 	}
 
+	// A named instance is a variation change like any other. Record its
+	// coordinates so faces opened elsewhere can reproduce it.
+	if (err == 0) {
+		FT_Fixed ft_coords[NVG_FONT_MAX_VAR_AXES];
+		FT_MM_Var* mm_var = NULL;
+		fs->fonts[fontId].varCoordsCount = 0;
+		if (FT_Get_MM_Var(face, &mm_var) == 0) {
+			unsigned int num_axis = mm_var->num_axis < NVG_FONT_MAX_VAR_AXES ? mm_var->num_axis : NVG_FONT_MAX_VAR_AXES;
+			if (FT_Get_Var_Design_Coordinates(face, num_axis, ft_coords) == 0) {
+				for (unsigned int i = 0; i < num_axis; i++) {
+					fs->fonts[fontId].varCoords[i] = (float)ft_coords[i] / 65536.0f;
+				}
+				fs->fonts[fontId].varCoordsCount = num_axis;
+			}
+			FT_Done_MM_Var(fs->ftLibrary, mm_var);
+		}
+		fs->fonts[fontId].varStateId++;
+		nvg__releaseFontSizes(fs, fontId);
+	}
+
 	return err == 0 ? 1 : 0;
 }
 
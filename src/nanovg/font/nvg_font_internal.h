@@ -7,6 +7,7 @@
 #include FT_ADVANCES_H
 #include FT_MULTIPLE_MASTERS_H
 #include FT_COLOR_H
+#include FT_SIZES_H
 #include <hb.h>
 #include <hb-ft.h>
 #include <fribidi.h>
@@ -22,6 +23,7 @@ struct NVGFont {
 	char name[64];
 	FT_Face face;
 	hb_font_t* hb_font;
+	char* path;  // File the face was loaded from (NULL for memory fonts), used to open worker faces
 	unsigned char* data;
 	int dataSize;
 	int freeData;
@@ -34,17 +36,39 @@ struct NVGFont {
 	int hasCOLR;  // 1 if font has COLR color tables, 0 otherwise
 };
 
+// Scaled font instance: an FT_Size and the HarfBuzz font created while it was
+// active, keyed by (font, pixel size, variation state)
+typedef struct {
+	int fontId;
+	int pixelSize;
+	unsigned int varStateId;
+	FT_Size ftSize;
+	hb_font_t* hbFont;
+	unsigned int lastUsed;
+} NVGFontSize;
+
+// LRU pool of scaled font instances. Switching sizes activates a pooled
+// FT_Size instead of rescaling the face and rebuilding the hb_font.
+typedef struct {
+	NVGFontSize entries[NVG_FONT_SIZE_POOL_SIZE];
+	int count;
+	unsigned int clock;
+} NVGFontSizePool;
+
 // Glyph cache entry
 typedef struct {
 	unsigned int glyphIndex;  // FreeType glyph index (from HarfBuzz), NOT codepoint
 	int fontId;
 	float size;
+	int sizeKey;              // Size quantized to 1/64 px (hash key)
+	unsigned int hash;        // Hash of the key fields, locates the home slot
 	int hinting;              // Hinting mode
 	int subpixelMode;         // Subpixel rendering mode (critical for cache correctness)
 	unsigned int varStateId;  // Variation state ID (for variable fonts)
 	NVGcolorSpace srcColorSpace;  // Source color space
 	NVGcolorSpace dstColorSpace;  // Destination color space
 	NVGtextureFormat format;  // Texture format this glyph is stored in
+	int page;                 // Atlas page this glyph is stored in
 	float x, y, w, h;
 	float s0, t0, s1, t1;
 	float advanceX;
@@ -52,48 +76,110 @@ typedef struct {
 	float bearingY;
 	unsigned int generation;
 	int valid;
+	int lruPrev;              // Entry index towards most recently used, -1 at head
+	int lruNext;              // Entry index towards least recently used, -1 at tail (free list link when invalid)
+	int pending;              // Streamed glyph still being rasterized (no atlas rect yet)
+	unsigned int lastFrame;   // Frame the glyph was last drawn in, never evicted during it
 } NVGGlyphCacheEntry;
 
-// Glyph cache
+// Glyph cache: entry pool indexed by an open-addressing hash table (linear
+// probing, backward-shift deletion). Valid entries are kept on an LRU list;
+// when the pool is full the least recently used glyph is evicted and its
+// padded atlas rect is returned to the atlas for reuse. Glyphs drawn in the
+// current frame are never evicted, since their quads are already recorded:
+// the pool doubles instead.
 struct NVGGlyphCache {
-	NVGGlyphCacheEntry entries[NVG_FONT_GLYPH_CACHE_SIZE];
-	int count;
+	NVGGlyphCacheEntry* entries;
+	int* slots;               // Entry index + 1, 0 = empty
+	int capacity;             // Entries in the pool
+	int hashSize;             // Slots, power of two and 2x the capacity
+	int count;                // High-water mark of used entries
+	int liveCount;            // Valid entries
+	int lruHead;
+	int lruTail;
+	int freeList;             // Evicted entries awaiting reuse, -1 if none
 	unsigned int generation;
+	unsigned int frame;       // Advanced by nvgFontBeginFrame
+	unsigned int hits;
+	unsigned int misses;
+	unsigned int evictions;
 };
 
+// Glyph rasterization job status
+typedef enum {
+	NVG_GLYPH_JOB_PENDING = 0,
+	NVG_GLYPH_JOB_DONE,
+	NVG_GLYPH_JOB_FAILED,
+	NVG_GLYPH_JOB_MAIN_THREAD  // Needs main thread state (COLR via Cairo, unclonable face)
+} NVGGlyphJobStatus;
+
+// Glyph rasterization job: cache key in, padded bitmap out
+typedef struct {
+	unsigned int glyphIndex;
+	unsigned int codepoint;
+	int fontId;
+	float size;
+	int hinting;
+	int subpixelMode;
+	unsigned int varStateId;
+	int msdfMode;
+	unsigned int varCoordsCount;  // Variation snapshot, so workers never read live font state
+	float varCoords[NVG_FONT_MAX_VAR_AXES];
+	NVGGlyphJobStatus status;
+	int gw, gh;               // Glyph size without the 1px border
+	float advanceX;
+	float bearingX;
+	float bearingY;
+	NVGcolorSpace srcColorSpace;
+	NVGcolorSpace dstColorSpace;
+	NVGtextureFormat format;
+	unsigned char* data;      // (gw+2) x (gh+2) pixels, NULL for empty glyphs
+} NVGGlyphJob;
+
 // Atlas node for packing
 typedef struct NVGAtlasNode {
 	short x, y, width;
 } NVGAtlasNode;
 
-// Maximum number of atlas formats supported
-#define NVG_MAX_ATLAS_FORMATS 16
+// Region released by an evicted glyph, reused before the skyline grows
+typedef struct NVGAtlasRect {
+	short x, y, width, height;
+} NVGAtlasRect;
+
+// Maximum number of atlas pages across all formats
+#define NVG_MAX_ATLASES 128
 
-// Individual atlas storage
+// Individual atlas storage: one fixed-size page of an atlas format. A full
+// format gets another page (and texture) instead of being resized, so cached
+// texture coordinates never change.
 typedef struct NVGAtlas {
 	NVGcolorSpace srcColorSpace;
 	NVGcolorSpace dstColorSpace;
 	NVGtextureFormat format;
 	int subpixelMode;        // Subpixel rendering mode (part of composite key)
+	int page;                // Page index within the format, 0 = first
 	int width;
 	int height;
 	int textureId;           // GPU texture ID for this atlas
 	NVGAtlasNode* nodes;
 	int nnodes;
 	int cnodes;
+	NVGAtlasRect* freeRects;
+	int nfreeRects;
+	int cfreeRects;
 	int active;
 } NVGAtlas;
 
 // Atlas manager - service desk for multiple atlases indexed by color space
 struct NVGAtlasManager {
-	NVGAtlas atlases[NVG_MAX_ATLAS_FORMATS];
+	NVGAtlas atlases[NVG_MAX_ATLASES];
 	int atlasCount;
-	int defaultAtlasWidth;
+	int defaultAtlasWidth;   // First page of each format
 	int defaultAtlasHeight;
-	void (*textureCallback)(void* uptr, int x, int y, int w, int h, const unsigned char* data, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode);
+	int pageWidth;           // Pages added later
+	int pageHeight;
+	void (*textureCallback)(void* uptr, int x, int y, int w, int h, const unsigned char* data, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page);
 	void* textureUserdata;
-	int (*growCallback)(void* uptr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int* newWidth, int* newHeight);
-	void* growUserdata;
 };
 
 // Font run for segmented shaping
@@ -144,9 +230,53 @@ struct NVGFontSystem {
 	NVGCairoState cairoState;  // For COLR emoji rendering
 	NVGShapedTextCache* shapedTextCache;  // Shaped text cache (Phase 14.2)
 	NVGcolorSpace targetColorSpace;  // Target swapchain color space for rendering
+	NVGFontSizePool sizePool;  // FT_Size / hb_font pairs per (font, size, variation)
+	NVGGlyphJob* glyphJobs;    // Glyph misses queued for batched rasterization
+	int nglyphJobs;
+	int cglyphJobs;
+	int rasterThreads;         // Worker count for batched rasterization (0 = serial)
+	NVGRasterPool* rasterPool; // Started on the first large batch
+	int streaming;             // Rasterize misses in the background instead of while drawing
+	float streamBudgetMs;      // Main thread time per frame for committing streamed glyphs
+	int streamInFlight;        // Streamed jobs submitted and not yet committed
+	NVGGlyphReadyFunc glyphReadyCallback;
+	void* glyphReadyUserdata;
 };
 
-// Atlas helper functions (used by nanovg.c for atlas growth)
-NVGAtlas* nvg__getAtlas(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode);
+// Atlas manager (nvg_font_system.c). Atlases are keyed by color spaces,
+// format, subpixel mode and page.
+int nvgAtlasAlloc(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int w, int h, int* x, int* y, int* page);
+void nvgAtlasUpdate(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page, int x, int y, int w, int h, const unsigned char* data);
+void nvgAtlasGetSize(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page, int* w, int* h);
+void nvgAtlasReset(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int width, int height);
+
+// Atlas helper functions
+NVGAtlas* nvg__getAtlas(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page);
+
+// Font size pool (nvg_font_system.c). Acquire activates the FT_Size on the
+// font's face and returns it with its hb_font, or NULL on failure.
+NVGFontSize* nvg__acquireFontSize(NVGFontSystem* fs, int fontId, float size);
+void nvg__releaseFontSizes(NVGFontSystem* fs, int fontId);
+
+// Glyph cache helpers (nvg_font_glyph.c)
+NVGGlyphCache* nvg__createGlyphCache(void);
+void nvg__destroyGlyphCache(NVGGlyphCache* cache);
+void nvg__resetGlyphCache(NVGGlyphCache* cache);
+void nvg__resetAtlasFreeRects(NVGAtlas* atlas);
+
+// Glyph rasterization (nvg_font_glyph.c). nvg__rasterizeGlyph only writes the
+// job, face and library, so it may run on a worker thread with allowColor 0.
+int nvg__rasterizeGlyph(NVGFontSystem* fs, FT_Library library, FT_Face face, NVGGlyphJob* job, int allowColor);
+NVGGlyphCacheEntry* nvg__commitGlyph(NVGFontSystem* fs, NVGGlyphJob* job);
+
+// Queue a glyph miss for batched rasterization, then rasterize (in parallel
+// if enabled) and commit all queued glyphs in queue order
+void nvg__queueGlyph(NVGFontSystem* fs, int fontId, unsigned int glyph_index, unsigned int codepoint);
+void nvg__flushGlyphJobs(NVGFontSystem* fs);
+
+// Glyph streaming (nvg_font_glyph.c). Active when enabled and the worker pool
+// is running. Dropping placeholders makes discarded in-flight glyphs requestable again.
+int nvg__streamingActive(NVGFontSystem* fs);
+void nvg__dropPendingGlyphs(NVGFontSystem* fs);
 
 #endif // NVG_FONT_INTERNAL_H
@@ -0,0 +1,339 @@
+// Parallel glyph rasterization
+#include "nvg_font_raster.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef struct {
+	NVGRasterPool* pool;
+	pthread_t thread;
+	int started;
+	FT_Library library;
+	FT_Face faces[NVG_FONT_MAX_FONTS];
+	unsigned int faceVarState[NVG_FONT_MAX_FONTS];
+	int facePixelSize[NVG_FONT_MAX_FONTS];
+} NVGRasterWorker;
+
+// Bounded MPMC queue of job pointers (Vyukov). Each cell's sequence tells
+// producers and consumers whose turn it is, so no locks are taken.
+typedef struct {
+	atomic_uint sequence;
+	NVGGlyphJob* job;
+} NVGGlyphQueueCell;
+
+typedef struct {
+	NVGGlyphQueueCell cells[NVG_FONT_STREAM_QUEUE_SIZE];
+	atomic_uint head;  // Next position to push
+	atomic_uint tail;  // Next position to pop
+} NVGGlyphQueue;
+
+struct NVGRasterPool {
+	NVGFontSystem* fs;
+	NVGRasterWorker workers[NVG_FONT_MAX_RASTER_THREADS];
+	int workerCount;
+	pthread_mutex_t lock;
+	pthread_cond_t workReady;
+	pthread_cond_t workDone;
+	NVGGlyphJob* jobs;
+	int jobCount;
+	int nextJob;
+	int activeWorkers;
+	unsigned int batch;
+	int quit;
+	NVGGlyphQueue submitted;  // Main thread -> workers
+	NVGGlyphQueue completed;  // Workers -> main thread
+	atomic_int idleWorkers;   // Workers about to sleep, the submitter wakes them
+};
+
+static void nvg__glyphQueueInit(NVGGlyphQueue* q) {
+	for (unsigned int i = 0; i < NVG_FONT_STREAM_QUEUE_SIZE; i++) {
+		atomic_init(&q->cells[i].sequence, i);
+		q->cells[i].job = NULL;
+	}
+	atomic_init(&q->head, 0);
+	atomic_init(&q->tail, 0);
+}
+
+static int nvg__glyphQueuePush(NVGGlyphQueue* q, NVGGlyphJob* job) {
+	unsigned int mask = NVG_FONT_STREAM_QUEUE_SIZE - 1;
+	unsigned int pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+	NVGGlyphQueueCell* cell;
+
+	for (;;) {
+		cell = &q->cells[pos & mask];
+		unsigned int seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		int diff = (int)(seq - pos);
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&q->head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			return 0;  // Full
+		} else {
+			pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+		}
+	}
+
+	cell->job = job;
+	atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+	return 1;
+}
+
+static NVGGlyphJob* nvg__glyphQueuePop(NVGGlyphQueue* q) {
+	unsigned int mask = NVG_FONT_STREAM_QUEUE_SIZE - 1;
+	unsigned int pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+	NVGGlyphQueueCell* cell;
+
+	for (;;) {
+		cell = &q->cells[pos & mask];
+		unsigned int seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		int diff = (int)(seq - (pos + 1));
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			return NULL;  // Empty
+		} else {
+			pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+		}
+	}
+
+	NVGGlyphJob* job = cell->job;
+	atomic_store_explicit(&cell->sequence, pos + mask + 1, memory_order_release);
+	return job;
+}
+
+static int nvg__glyphQueueEmpty(NVGGlyphQueue* q) {
+	unsigned int pos = atomic_load(&q->tail);
+	unsigned int seq = atomic_load(&q->cells[pos & (NVG_FONT_STREAM_QUEUE_SIZE - 1)].sequence);
+	return seq != pos + 1;
+}
+
+// Helper: Get the worker's face for a job, opened and configured on demand.
+// Returns NULL if the job has to run on the main thread.
+static FT_Face nvg__rasterWorkerFace(NVGRasterWorker* worker, const NVGGlyphJob* job) {
+	// path and data never change after the font is added; variation state
+	// comes from the job's snapshot
+	NVGFont* font = &worker->pool->fs->fonts[job->fontId];
+	FT_Face face = worker->faces[job->fontId];
+
+	if (!face) {
+		FT_Error err;
+		if (font->path) {
+			err = FT_New_Face(worker->library, font->path, 0, &face);
+		} else if (font->data) {
+			err = FT_New_Memory_Face(worker->library, font->data, font->dataSize, 0, &face);
+		} else {
+			return NULL;
+		}
+		if (err) {
+			return NULL;
+		}
+		worker->faces[job->fontId] = face;
+		worker->faceVarState[job->fontId] = 0;
+		worker->facePixelSize[job->fontId] = 0;
+	}
+
+	// Bring the clone to the job's variation
+	if (worker->faceVarState[job->fontId] != job->varStateId) {
+		if (job->varCoordsCount == 0) {
+			return NULL;
+		}
+		FT_Fixed coords[NVG_FONT_MAX_VAR_AXES];
+		for (unsigned int i = 0; i < job->varCoordsCount; i++) {
+			coords[i] = (FT_Fixed)(job->varCoords[i] * 65536.0f);
+		}
+		if (FT_Set_Var_Design_Coordinates(face, job->varCoordsCount, coords)) {
+			return NULL;
+		}
+		worker->faceVarState[job->fontId] = job->varStateId;
+	}
+
+	int pixelSize = (int)job->size;
+	if (pixelSize < 1) pixelSize = 1;
+	if (worker->facePixelSize[job->fontId] != pixelSize) {
+		FT_Set_Pixel_Sizes(face, 0, (FT_UInt)pixelSize);
+		worker->facePixelSize[job->fontId] = pixelSize;
+	}
+
+	return face;
+}
+
+static void nvg__rasterWorkerRun(NVGRasterWorker* worker, NVGGlyphJob* job) {
+	FT_Face face = nvg__rasterWorkerFace(worker, job);
+	if (face) {
+		nvg__rasterizeGlyph(worker->pool->fs, worker->library, face, job, 0);
+	} else {
+		job->status = NVG_GLYPH_JOB_MAIN_THREAD;
+	}
+}
+
+static void* nvg__rasterWorkerMain(void* arg) {
+	NVGRasterWorker* worker = (NVGRasterWorker*)arg;
+	NVGRasterPool* pool = worker->pool;
+	unsigned int seenBatch = 0;
+
+	pthread_mutex_lock(&pool->lock);
+	for (;;) {
+		while (!pool->quit && pool->batch == seenBatch) {
+			// Announce the sleep before the last look at the stream queue;
+			// pairs with the fence in nvg__rasterPoolSubmit so a submit is
+			// either seen here or followed by a wakeup
+			atomic_fetch_add(&pool->idleWorkers, 1);
+			atomic_thread_fence(memory_order_seq_cst);
+			int empty = nvg__glyphQueueEmpty(&pool->submitted);
+			if (empty) {
+				pthread_cond_wait(&pool->workReady, &pool->lock);
+			}
+			atomic_fetch_sub(&pool->idleWorkers, 1);
+			if (!empty) {
+				break;
+			}
+		}
+		if (pool->quit) {
+			break;
+		}
+
+		if (pool->batch != seenBatch) {
+			seenBatch = pool->batch;
+
+			// Claim jobs one at a time until the batch is drained
+			while (pool->nextJob < pool->jobCount) {
+				NVGGlyphJob* job = &pool->jobs[pool->nextJob++];
+				pthread_mutex_unlock(&pool->lock);
+				nvg__rasterWorkerRun(worker, job);
+				pthread_mutex_lock(&pool->lock);
+			}
+
+			if (--pool->activeWorkers == 0) {
+				pthread_cond_signal(&pool->workDone);
+			}
+			continue;
+		}
+
+		// Streamed jobs. The main thread never submits more than the queue
+		// holds, so the completed queue cannot be full.
+		pthread_mutex_unlock(&pool->lock);
+		NVGGlyphJob* job;
+		while ((job = nvg__glyphQueuePop(&pool->submitted)) != NULL) {
+			nvg__rasterWorkerRun(worker, job);
+			nvg__glyphQueuePush(&pool->completed, job);
+		}
+		pthread_mutex_lock(&pool->lock);
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return NULL;
+}
+
+NVGRasterPool* nvg__rasterPoolCreate(NVGFontSystem* fs, int threadCount) {
+	if (!fs || threadCount <= 0) return NULL;
+	if (threadCount > NVG_FONT_MAX_RASTER_THREADS) threadCount = NVG_FONT_MAX_RASTER_THREADS;
+
+	NVGRasterPool* pool = (NVGRasterPool*)calloc(1, sizeof(NVGRasterPool));
+	if (!pool) return NULL;
+
+	pool->fs = fs;
+	nvg__glyphQueueInit(&pool->submitted);
+	nvg__glyphQueueInit(&pool->completed);
+	atomic_init(&pool->idleWorkers, 0);
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->workReady, NULL);
+	pthread_cond_init(&pool->workDone, NULL);
+
+	for (int i = 0; i < threadCount; i++) {
+		NVGRasterWorker* worker = &pool->workers[i];
+		worker->pool = pool;
+		if (FT_Init_FreeType(&worker->library)) {
+			break;
+		}
+		if (pthread_create(&worker->thread, NULL, nvg__rasterWorkerMain, worker) != 0) {
+			FT_Done_FreeType(worker->library);
+			worker->library = NULL;
+			break;
+		}
+		worker->started = 1;
+		pool->workerCount++;
+	}
+
+	if (pool->workerCount == 0) {
+		fprintf(stderr, "[nvg__rasterPoolCreate] Failed to start glyph rasterization workers, rasterizing serially\n");
+		nvg__rasterPoolDestroy(pool);
+		return NULL;
+	}
+
+	return pool;
+}
+
+void nvg__rasterPoolDestroy(NVGRasterPool* pool) {
+	if (!pool) return;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->quit = 1;
+	pthread_cond_broadcast(&pool->workReady);
+	pthread_mutex_unlock(&pool->lock);
+
+	for (int i = 0; i < NVG_FONT_MAX_RASTER_THREADS; i++) {
+		NVGRasterWorker* worker = &pool->workers[i];
+		if (worker->started) {
+			pthread_join(worker->thread, NULL);
+		}
+		if (worker->library) {
+			// Also closes the worker's faces
+			FT_Done_FreeType(worker->library);
+		}
+	}
+
+	// Streamed jobs nobody will collect
+	NVGGlyphJob* job;
+	while ((job = nvg__glyphQueuePop(&pool->submitted)) != NULL ||
+	       (job = nvg__glyphQueuePop(&pool->completed)) != NULL) {
+		free(job->data);
+		free(job);
+	}
+
+	pthread_cond_destroy(&pool->workDone);
+	pthread_cond_destroy(&pool->workReady);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool);
+}
+
+void nvg__rasterPoolRun(NVGRasterPool* pool, NVGGlyphJob* jobs, int count) {
+	if (!pool || !jobs || count <= 0) return;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->jobs = jobs;
+	pool->jobCount = count;
+	pool->nextJob = 0;
+	pool->activeWorkers = pool->workerCount;
+	pool->batch++;
+	pthread_cond_broadcast(&pool->workReady);
+
+	while (pool->activeWorkers > 0) {
+		pthread_cond_wait(&pool->workDone, &pool->lock);
+	}
+
+	pool->jobs = NULL;
+	pool->jobCount = 0;
+	pthread_mutex_unlock(&pool->lock);
+}
+
+int nvg__rasterPoolSubmit(NVGRasterPool* pool, NVGGlyphJob* job) {
+	if (!pool || !job) return 0;
+	if (!nvg__glyphQueuePush(&pool->submitted, job)) return 0;
+
+	// Only take the lock when a worker may be asleep
+	atomic_thread_fence(memory_order_seq_cst);
+	if (atomic_load(&pool->idleWorkers) > 0) {
+		pthread_mutex_lock(&pool->lock);
+		pthread_cond_signal(&pool->workReady);
+		pthread_mutex_unlock(&pool->lock);
+	}
+	return 1;
+}
+
+NVGGlyphJob* nvg__rasterPoolPoll(NVGRasterPool* pool) {
+	if (!pool) return NULL;
+	return nvg__glyphQueuePop(&pool->completed);
+}
@@ -0,0 +1,28 @@
+#ifndef NVG_FONT_RASTER_H
+#define NVG_FONT_RASTER_H
+
+#include "nvg_font_internal.h"
+
+// Fixed pool of glyph rasterization workers. Each worker owns an FT_Library
+// and opens its own FT_Face per font, so FreeType state is never shared
+// between threads.
+
+// Start threadCount workers. Returns NULL on failure (callers fall back to
+// rasterizing on the calling thread).
+NVGRasterPool* nvg__rasterPoolCreate(NVGFontSystem* fs, int threadCount);
+
+// Stop the workers and close their faces
+void nvg__rasterPoolDestroy(NVGRasterPool* pool);
+
+// Rasterize jobs[0..count) on the workers and wait for them. Jobs that need
+// the main thread are left with status NVG_GLYPH_JOB_MAIN_THREAD.
+void nvg__rasterPoolRun(NVGRasterPool* pool, NVGGlyphJob* jobs, int count);
+
+// Streaming: hand a heap allocated job to the workers without waiting.
+// Submit returns 0 if the queue is full. Finished jobs (any status) come back
+// through Poll, which returns NULL when none are ready. Both ends are
+// lock-free; Destroy frees jobs still queued in either direction.
+int nvg__rasterPoolSubmit(NVGRasterPool* pool, NVGGlyphJob* job);
+NVGGlyphJob* nvg__rasterPoolPoll(NVGRasterPool* pool);
+
+#endif // NVG_FONT_RASTER_H
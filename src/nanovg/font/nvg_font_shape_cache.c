@@ -101,9 +101,86 @@ void nvgShapeCache_sortFeatures(NVGShapeKey* key) {
 	}
 }
 
+// Helper: Empty all buckets and lists (entries must already be freed)
+static void nvgShapeCache__reset(NVGShapedTextCache* cache) {
+	memset(cache->entries, 0, sizeof(cache->entries));
+	for (int i = 0; i < NVG_SHAPED_TEXT_CACHE_BUCKETS; i++) {
+		cache->buckets[i] = -1;
+	}
+	cache->count = 0;
+	cache->lruHead = -1;
+	cache->lruTail = -1;
+	cache->freeList = -1;
+}
+
+static void nvgShapeCache__lruUnlink(NVGShapedTextCache* cache, int idx) {
+	NVGShapedTextEntry* entry = &cache->entries[idx];
+	if (entry->lruPrev != -1) {
+		cache->entries[entry->lruPrev].lruNext = entry->lruNext;
+	} else {
+		cache->lruHead = entry->lruNext;
+	}
+	if (entry->lruNext != -1) {
+		cache->entries[entry->lruNext].lruPrev = entry->lruPrev;
+	} else {
+		cache->lruTail = entry->lruPrev;
+	}
+	entry->lruPrev = -1;
+	entry->lruNext = -1;
+}
+
+static void nvgShapeCache__lruPushFront(NVGShapedTextCache* cache, int idx) {
+	NVGShapedTextEntry* entry = &cache->entries[idx];
+	entry->lruPrev = -1;
+	entry->lruNext = cache->lruHead;
+	if (cache->lruHead != -1) {
+		cache->entries[cache->lruHead].lruPrev = idx;
+	} else {
+		cache->lruTail = idx;
+	}
+	cache->lruHead = idx;
+}
+
+// Helper: Unlink a valid entry from its bucket and the LRU list, free its
+// storage and put it on the free list
+static void nvgShapeCache__remove(NVGShapedTextCache* cache, int idx) {
+	NVGShapedTextEntry* entry = &cache->entries[idx];
+
+	int* link = &cache->buckets[entry->key.hash & (NVG_SHAPED_TEXT_CACHE_BUCKETS - 1)];
+	while (*link != idx) {
+		link = &cache->entries[*link].bucketNext;
+	}
+	*link = entry->bucketNext;
+
+	nvgShapeCache__lruUnlink(cache, idx);
+
+	free(entry->glyphs);
+	memset(entry, 0, sizeof(NVGShapedTextEntry));
+	entry->lruNext = cache->freeList;
+	cache->freeList = idx;
+}
+
+static int nvgShapeCache__fits16(hb_position_t v) {
+	return v >= INT16_MIN && v <= INT16_MAX;
+}
+
+// Runs with positions past +/-512 px are not cached, so a hit always lays
+// out exactly like the miss that stored it
+static int nvgShapeCache__runFits16(const hb_glyph_position_t* pos, unsigned int glyphCount) {
+	for (unsigned int i = 0; i < glyphCount; i++) {
+		if (!nvgShapeCache__fits16(pos[i].x_advance) || !nvgShapeCache__fits16(pos[i].y_advance) ||
+			!nvgShapeCache__fits16(pos[i].x_offset) || !nvgShapeCache__fits16(pos[i].y_offset))
+			return 0;
+	}
+	return 1;
+}
+
 // Create a new shaped text cache
 NVGShapedTextCache* nvgShapeCache_create(void) {
 	NVGShapedTextCache* cache = (NVGShapedTextCache*)calloc(1, sizeof(NVGShapedTextCache));
+	if (cache) {
+		nvgShapeCache__reset(cache);
+	}
 	return cache;
 }
 
@@ -111,111 +188,92 @@ NVGShapedTextCache* nvgShapeCache_create(void) {
 void nvgShapeCache_destroy(NVGShapedTextCache* cache) {
 	if (!cache) return;
 
-	// Free all entries
+	// Free all entries (text and glyphs share one allocation)
 	for (int i = 0; i < cache->count; i++) {
-		if (cache->keys[i].text) {
-			free(cache->keys[i].text);
-			cache->keys[i].text = NULL;
-		}
-		if (cache->values[i].glyphInfo) {
-			free(cache->values[i].glyphInfo);
-			cache->values[i].glyphInfo = NULL;
-		}
-		if (cache->values[i].glyphPos) {
-			free(cache->values[i].glyphPos);
-			cache->values[i].glyphPos = NULL;
-		}
+		free(cache->entries[i].glyphs);
 	}
 
 	free(cache);
 }
 
-// Look up a key in the cache
+// Look up a key in the cache. The key may borrow the caller's string.
 NVGShapedTextEntry* nvgShapeCache_lookup(NVGShapedTextCache* cache, const NVGShapeKey* key) {
 	if (!cache || !key) return NULL;
 
-	for (int i = 0; i < cache->count; i++) {
-		if (cache->values[i].valid && nvgShapeCache_compareKeys(&cache->keys[i], key)) {
-			// Cache hit - update LRU
-			cache->values[i].lastUsed = cache->frameCounter++;
-			return &cache->values[i];
+	int idx = cache->buckets[key->hash & (NVG_SHAPED_TEXT_CACHE_BUCKETS - 1)];
+	while (idx != -1) {
+		NVGShapedTextEntry* entry = &cache->entries[idx];
+		if (nvgShapeCache_compareKeys(&entry->key, key)) {
+			// Cache hit - move to front of LRU list
+			if (cache->lruHead != idx) {
+				nvgShapeCache__lruUnlink(cache, idx);
+				nvgShapeCache__lruPushFront(cache, idx);
+			}
+			return entry;
 		}
+		idx = entry->bucketNext;
 	}
 
 	return NULL;  // Cache miss
 }
 
-// Insert shaped text result into cache
-void nvgShapeCache_insert(NVGShapedTextCache* cache, NVGShapeKey* key, hb_buffer_t* hb_buffer) {
-	if (!cache || !key || !hb_buffer) return;
-
-	int insertIdx = -1;
-
-	// Find slot: empty or LRU eviction
-	if (cache->count < NVG_SHAPED_TEXT_CACHE_SIZE) {
-		// Use next empty slot
-		insertIdx = cache->count++;
-	} else {
-		// Cache is full - evict LRU entry
-		unsigned int minUsed = cache->values[0].lastUsed;
-		insertIdx = 0;
-		for (int i = 1; i < NVG_SHAPED_TEXT_CACHE_SIZE; i++) {
-			if (cache->values[i].lastUsed < minUsed) {
-				minUsed = cache->values[i].lastUsed;
-				insertIdx = i;
-			}
-		}
-
-		// Free evicted entry
-		if (cache->keys[insertIdx].text) {
-			free(cache->keys[insertIdx].text);
-			cache->keys[insertIdx].text = NULL;
-		}
-		if (cache->values[insertIdx].glyphInfo) {
-			free(cache->values[insertIdx].glyphInfo);
-			cache->values[insertIdx].glyphInfo = NULL;
-		}
-		if (cache->values[insertIdx].glyphPos) {
-			free(cache->values[insertIdx].glyphPos);
-			cache->values[insertIdx].glyphPos = NULL;
-		}
-	}
-
-	// Copy key (transfer ownership of key->text)
-	cache->keys[insertIdx] = *key;
+// Insert shaped text result into cache (the key text is copied)
+void nvgShapeCache_insert(NVGShapedTextCache* cache, const NVGShapeKey* key, hb_buffer_t* hb_buffer) {
+	if (!cache || !key || !key->text || !hb_buffer) return;
 
-	// Copy HarfBuzz output
 	unsigned int glyphCount;
 	hb_glyph_info_t* info = hb_buffer_get_glyph_infos(hb_buffer, &glyphCount);
 	hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(hb_buffer, &glyphCount);
+	if (!nvgShapeCache__runFits16(pos, glyphCount)) return;
 
-	cache->values[insertIdx].glyphCount = glyphCount;
-	cache->values[insertIdx].glyphInfo = (hb_glyph_info_t*)malloc(
-		sizeof(hb_glyph_info_t) * glyphCount);
-	cache->values[insertIdx].glyphPos = (hb_glyph_position_t*)malloc(
-		sizeof(hb_glyph_position_t) * glyphCount);
-
-	if (cache->values[insertIdx].glyphInfo && cache->values[insertIdx].glyphPos) {
-		memcpy(cache->values[insertIdx].glyphInfo, info,
-		       sizeof(hb_glyph_info_t) * glyphCount);
-		memcpy(cache->values[insertIdx].glyphPos, pos,
-		       sizeof(hb_glyph_position_t) * glyphCount);
-
-		cache->values[insertIdx].direction = hb_buffer_get_direction(hb_buffer);
-		cache->values[insertIdx].lastUsed = cache->frameCounter++;
-		cache->values[insertIdx].valid = 1;
+	// Find slot: free list, next unused entry, or evict LRU entry
+	int insertIdx;
+	if (cache->freeList == -1 && cache->count >= NVG_SHAPED_TEXT_CACHE_SIZE) {
+		nvgShapeCache__remove(cache, cache->lruTail);
+	}
+	if (cache->freeList != -1) {
+		insertIdx = cache->freeList;
+		cache->freeList = cache->entries[insertIdx].lruNext;
 	} else {
-		// Allocation failed - invalidate entry
-		if (cache->values[insertIdx].glyphInfo) free(cache->values[insertIdx].glyphInfo);
-		if (cache->values[insertIdx].glyphPos) free(cache->values[insertIdx].glyphPos);
-		cache->values[insertIdx].glyphInfo = NULL;
-		cache->values[insertIdx].glyphPos = NULL;
-		cache->values[insertIdx].valid = 0;
-		if (cache->keys[insertIdx].text) {
-			free(cache->keys[insertIdx].text);
-			cache->keys[insertIdx].text = NULL;
-		}
+		insertIdx = cache->count++;
+	}
+
+	// Glyph records first (for alignment), followed by the key text
+	size_t glyphBytes = sizeof(NVGShapedGlyph) * glyphCount;
+	unsigned char* block = (unsigned char*)malloc(glyphBytes + key->textLen + 1);
+	NVGShapedTextEntry* entry = &cache->entries[insertIdx];
+	if (!block) {
+		// Allocation failed - return slot to the free list
+		entry->lruNext = cache->freeList;
+		cache->freeList = insertIdx;
+		return;
+	}
+
+	NVGShapedGlyph* glyphs = (NVGShapedGlyph*)block;
+	for (unsigned int i = 0; i < glyphCount; i++) {
+		glyphs[i].glyphId = info[i].codepoint;
+		glyphs[i].cluster = info[i].cluster;
+		glyphs[i].xAdvance = (int16_t)pos[i].x_advance;
+		glyphs[i].yAdvance = (int16_t)pos[i].y_advance;
+		glyphs[i].xOffset = (int16_t)pos[i].x_offset;
+		glyphs[i].yOffset = (int16_t)pos[i].y_offset;
 	}
+
+	char* text = (char*)(block + glyphBytes);
+	memcpy(text, key->text, key->textLen);
+	text[key->textLen] = '\0';
+
+	entry->key = *key;
+	entry->key.text = text;
+	entry->glyphs = glyphs;
+	entry->glyphCount = glyphCount;
+	entry->direction = hb_buffer_get_direction(hb_buffer);
+	entry->valid = 1;
+
+	int* bucket = &cache->buckets[key->hash & (NVG_SHAPED_TEXT_CACHE_BUCKETS - 1)];
+	entry->bucketNext = *bucket;
+	*bucket = insertIdx;
+	nvgShapeCache__lruPushFront(cache, insertIdx);
 }
 
 // Clear entire cache
@@ -223,22 +281,10 @@ void nvgShapeCache_clear(NVGShapedTextCache* cache) {
 	if (!cache) return;
 
 	for (int i = 0; i < cache->count; i++) {
-		if (cache->keys[i].text) {
-			free(cache->keys[i].text);
-			cache->keys[i].text = NULL;
-		}
-		if (cache->values[i].glyphInfo) {
-			free(cache->values[i].glyphInfo);
-			cache->values[i].glyphInfo = NULL;
-		}
-		if (cache->values[i].glyphPos) {
-			free(cache->values[i].glyphPos);
-			cache->values[i].glyphPos = NULL;
-		}
-		cache->values[i].valid = 0;
+		free(cache->entries[i].glyphs);
 	}
 
-	memset(cache, 0, sizeof(NVGShapedTextCache));
+	nvgShapeCache__reset(cache);
 }
 
 // Invalidate all cache entries for a specific font
@@ -246,21 +292,8 @@ void nvgShapeCache_invalidateFont(NVGShapedTextCache* cache, int fontId) {
 	if (!cache) return;
 
 	for (int i = 0; i < cache->count; i++) {
-		if (cache->keys[i].fontId == fontId) {
-			// Free this entry
-			if (cache->keys[i].text) {
-				free(cache->keys[i].text);
-				cache->keys[i].text = NULL;
-			}
-			if (cache->values[i].glyphInfo) {
-				free(cache->values[i].glyphInfo);
-				cache->values[i].glyphInfo = NULL;
-			}
-			if (cache->values[i].glyphPos) {
-				free(cache->values[i].glyphPos);
-				cache->values[i].glyphPos = NULL;
-			}
-			cache->values[i].valid = 0;
+		if (cache->entries[i].valid && cache->entries[i].key.fontId == fontId) {
+			nvgShapeCache__remove(cache, i);
 		}
 	}
 }
@@ -6,7 +6,7 @@
 
 // Cache key for shaped text lookup
 typedef struct {
-	char* text;                    // UTF-8 string (heap allocated)
+	const char* text;              // UTF-8 string (borrowed for lookups, owned by the entry once cached)
 	int textLen;                   // Length in bytes
 	int fontId;                    // Font ID
 	float size;                    // Font size
@@ -27,16 +27,30 @@ typedef struct {
 	uint32_t hash;                 // Pre-computed hash for fast lookup
 } NVGShapeKey;
 
+// Compact shaped glyph record. Positions are HarfBuzz 26.6 values narrowed to
+// 16 bits, enough for +/-512 px per glyph; runs that exceed it are not cached.
+typedef struct {
+	uint32_t glyphId;              // Glyph index (hb_glyph_info_t.codepoint)
+	uint32_t cluster;              // Byte offset of the source cluster
+	int16_t xAdvance;              // 26.6 fixed point
+	int16_t yAdvance;
+	int16_t xOffset;
+	int16_t yOffset;
+} NVGShapedGlyph;
+
 // Cache value containing shaped text result
 typedef struct {
-	// Shaped glyph data (copied from HarfBuzz output)
-	hb_glyph_info_t* glyphInfo;    // Array of glyph info
-	hb_glyph_position_t* glyphPos; // Array of glyph positions
+	NVGShapeKey key;               // key.text points into the entry's allocation
+
+	// Shaped glyph data (compacted from HarfBuzz output)
+	NVGShapedGlyph* glyphs;        // Array of glyphs (same allocation as key.text)
 	unsigned int glyphCount;       // Number of glyphs
 	hb_direction_t direction;      // Text direction
 
-	// LRU tracking
-	unsigned int lastUsed;         // Frame counter for LRU
+	// Hash bucket chain and intrusive LRU list (entry indices, -1 = none)
+	int bucketNext;
+	int lruPrev;                   // Towards most recently used
+	int lruNext;                   // Towards least recently used (free list link when invalid)
 
 	// Memory management
 	int valid;                     // Entry is valid
@@ -44,12 +58,15 @@ typedef struct {
 
 // Shaped text cache
 #define NVG_SHAPED_TEXT_CACHE_SIZE 256
+#define NVG_SHAPED_TEXT_CACHE_BUCKETS 512  // Power of two
 
 typedef struct {
-	NVGShapeKey keys[NVG_SHAPED_TEXT_CACHE_SIZE];
-	NVGShapedTextEntry values[NVG_SHAPED_TEXT_CACHE_SIZE];
-	int count;                     // Number of valid entries
-	unsigned int frameCounter;     // Increments each lookup for LRU
+	NVGShapedTextEntry entries[NVG_SHAPED_TEXT_CACHE_SIZE];
+	int buckets[NVG_SHAPED_TEXT_CACHE_BUCKETS];  // First entry per hash bucket, -1 if empty
+	int count;                     // High-water mark of used entries
+	int lruHead;                   // Most recently used entry
+	int lruTail;                   // Least recently used entry (next victim)
+	int freeList;                  // Invalidated entries awaiting reuse
 } NVGShapedTextCache;
 
 // Cache lifecycle
@@ -58,7 +75,7 @@ void nvgShapeCache_destroy(NVGShapedTextCache* cache);
 
 // Cache operations
 NVGShapedTextEntry* nvgShapeCache_lookup(NVGShapedTextCache* cache, const NVGShapeKey* key);
-void nvgShapeCache_insert(NVGShapedTextCache* cache, NVGShapeKey* key, hb_buffer_t* hb_buffer);
+void nvgShapeCache_insert(NVGShapedTextCache* cache, const NVGShapeKey* key, hb_buffer_t* hb_buffer);
 
 // Cache invalidation
 void nvgShapeCache_clear(NVGShapedTextCache* cache);
@@ -132,13 +132,9 @@ static void nvg__buildShapeKey(NVGFontSystem* fs, NVGShapeKey* key,
                                 const char* string, const char* end, int bidi) {
 	memset(key, 0, sizeof(NVGShapeKey));
 
-	// Copy text
+	// Borrow text (the cache copies it on insert)
+	key->text = string;
 	key->textLen = (int)(end - string);
-	key->text = (char*)malloc(key->textLen + 1);
-	if (key->text) {
-		memcpy(key->text, string, key->textLen);
-		key->text[key->textLen] = '\0';
-	}
 
 	// Copy font state
 	key->fontId = fs->state.fontId;
@@ -187,8 +183,8 @@ void nvgFontShapedTextIterInit(NVGFontSystem* fs, NVGTextIter* iter, float x, fl
 	if (end == string) return;
 
 	// Try cache lookup (Phase 14.2)
+	NVGShapeKey queryKey;
 	if (fs->shapedTextCache) {
-		NVGShapeKey queryKey;
 		nvg__buildShapeKey(fs, &queryKey, string, end, bidi);
 
 		static int shape_lookup = 0;
@@ -199,12 +195,6 @@ void nvgFontShapedTextIterInit(NVGFontSystem* fs, NVGTextIter* iter, float x, fl
 
 		NVGShapedTextEntry* cached = nvgShapeCache_lookup(fs->shapedTextCache, &queryKey);
 
-		// Free the temporary text allocation (key was for lookup only)
-		if (queryKey.text) {
-			free(queryKey.text);
-			queryKey.text = NULL;
-		}
-
 		if (cached) {
 			// Cache HIT - use cached shaped result
 			static int shape_hit = 0;
@@ -323,27 +313,16 @@ void nvgFontShapedTextIterInit(NVGFontSystem* fs, NVGTextIter* iter, float x, fl
 			continue;  // Skip invalid font
 		}
 
-		FT_Face face = fs->fonts[run->fontId].face;
-
 		static int shape_debug = 0;
 		if (shape_debug++ < 10) {
 			printf("[Shaping Run %d] fontId=%d, bytes [%d..%d)\n",
 			       runIdx, run->fontId, run->byteStart, run->byteStart + run->byteLength);
 		}
 
-		// Set FreeType face size
-		FT_Set_Pixel_Sizes(face, 0, (FT_UInt)fs->state.size);
-
-		// Re-apply variation coordinates if any
-		if (fs->fonts[run->fontId].varCoordsCount > 0) {
-			FT_Fixed* ft_coords = (FT_Fixed*)malloc(sizeof(FT_Fixed) * fs->fonts[run->fontId].varCoordsCount);
-			if (ft_coords) {
-				for (unsigned int i = 0; i < fs->fonts[run->fontId].varCoordsCount; i++) {
-					ft_coords[i] = (FT_Fixed)(fs->fonts[run->fontId].varCoords[i] * 65536.0f);
-				}
-				FT_Set_Var_Design_Coordinates(face, fs->fonts[run->fontId].varCoordsCount, ft_coords);
-				free(ft_coords);
-			}
+		// Activate the pooled size for this font (face size + hb_font)
+		NVGFontSize* fontSize = nvg__acquireFontSize(fs, run->fontId, fs->state.size);
+		if (!fontSize) {
+			continue;
 		}
 
 		// Prepare HarfBuzz buffer for this run
@@ -357,30 +336,26 @@ void nvgFontShapedTextIterInit(NVGFontSystem* fs, NVGTextIter* iter, float x, fl
 		                   string + run->byteStart, run->byteLength,
 		                   0, run->byteLength);
 
-		// Create HarfBuzz font and shape
-		hb_font_t* hb_font = hb_ft_font_create(face, NULL);
-		if (hb_font) {
-			if (num_features > 0) {
-				hb_shape(hb_font, fs->shapingState.hb_buffer, features, num_features);
-			} else {
-				hb_shape(hb_font, fs->shapingState.hb_buffer, NULL, 0);
-			}
-
-			// Store shaped results in the run
-			unsigned int count;
-			hb_glyph_info_t* info = hb_buffer_get_glyph_infos(fs->shapingState.hb_buffer, &count);
-			hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(fs->shapingState.hb_buffer, &count);
+		// Shape with the pooled HarfBuzz font
+		hb_font_t* hb_font = fontSize->hbFont;
+		if (num_features > 0) {
+			hb_shape(hb_font, fs->shapingState.hb_buffer, features, num_features);
+		} else {
+			hb_shape(hb_font, fs->shapingState.hb_buffer, NULL, 0);
+		}
 
-			run->glyphCount = count;
-			run->glyphs = (hb_glyph_info_t*)malloc(sizeof(hb_glyph_info_t) * count);
-			run->positions = (hb_glyph_position_t*)malloc(sizeof(hb_glyph_position_t) * count);
+		// Store shaped results in the run
+		unsigned int count;
+		hb_glyph_info_t* info = hb_buffer_get_glyph_infos(fs->shapingState.hb_buffer, &count);
+		hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(fs->shapingState.hb_buffer, &count);
 
-			if (run->glyphs && run->positions) {
-				memcpy(run->glyphs, info, sizeof(hb_glyph_info_t) * count);
-				memcpy(run->positions, pos, sizeof(hb_glyph_position_t) * count);
-			}
+		run->glyphCount = count;
+		run->glyphs = (hb_glyph_info_t*)malloc(sizeof(hb_glyph_info_t) * count);
+		run->positions = (hb_glyph_position_t*)malloc(sizeof(hb_glyph_position_t) * count);
 
-			hb_font_destroy(hb_font);
+		if (run->glyphs && run->positions) {
+			memcpy(run->glyphs, info, sizeof(hb_glyph_info_t) * count);
+			memcpy(run->positions, pos, sizeof(hb_glyph_position_t) * count);
 		}
 	}
 
@@ -392,11 +367,38 @@ void nvgFontShapedTextIterInit(NVGFontSystem* fs, NVGTextIter* iter, float x, fl
 
 	// Insert into cache (Phase 14.2)
 	if (fs->shapedTextCache) {
-		NVGShapeKey insertKey;
-		nvg__buildShapeKey(fs, &insertKey, string, end, bidi);
-		nvgShapeCache_insert(fs->shapedTextCache, &insertKey, fs->shapingState.hb_buffer);
-		// Note: insert takes ownership of insertKey.text, so don't free it
+		nvgShapeCache_insert(fs->shapedTextCache, &queryKey, fs->shapingState.hb_buffer);
+	}
+}
+
+void nvgFontPrepareShapedText(NVGFontSystem* fs, const NVGTextIter* iter) {
+	if (!fs || !iter) return;
+	if (fs->state.fontId < 0 || fs->state.fontId >= fs->nfonts) return;
+
+	// Streamed misses are queued one by one while iterating
+	if (nvg__streamingActive(fs)) return;
+
+	// Walk the glyphs in the same order nvgFontShapedTextIterNext will
+	if (iter->cachedShaping) {
+		NVGShapedTextEntry* cached = (NVGShapedTextEntry*)iter->cachedShaping;
+		for (unsigned int i = 0; i < cached->glyphCount; i++) {
+			unsigned int codepoint = 0;
+			nvg__decodeUTF8(iter->str + cached->glyphs[i].cluster, &codepoint);
+			nvg__queueGlyph(fs, fs->state.fontId, cached->glyphs[i].glyphId, codepoint);
+		}
+	} else {
+		for (int runIdx = 0; runIdx < fs->shapingState.runCount; runIdx++) {
+			NVGFontRun* run = &fs->shapingState.runs[runIdx];
+			if (!run->glyphs) continue;
+			for (unsigned int i = 0; i < run->glyphCount; i++) {
+				unsigned int codepoint = 0;
+				nvg__decodeUTF8(iter->str + run->glyphs[i].cluster, &codepoint);
+				nvg__queueGlyph(fs, run->fontId, run->glyphs[i].codepoint, codepoint);
+			}
+		}
 	}
+
+	nvg__flushGlyphJobs(fs);
 }
 
 int nvgFontShapedTextIterNext(NVGFontSystem* fs, NVGTextIter* iter, NVGCachedGlyph* quad) {
@@ -406,19 +408,16 @@ int nvgFontShapedTextIterNext(NVGFontSystem* fs, NVGTextIter* iter, NVGCachedGly
 	// Handle cached shaping (Phase 14.2) - uses old single-buffer approach
 	if (iter->cachedShaping) {
 		NVGShapedTextEntry* cached = (NVGShapedTextEntry*)iter->cachedShaping;
-		unsigned int glyph_count = cached->glyphCount;
-		hb_glyph_info_t* glyph_info = cached->glyphInfo;
-		hb_glyph_position_t* glyph_pos = cached->glyphPos;
-
-		if (iter->glyphIndex >= glyph_count) {
+		if (iter->glyphIndex >= cached->glyphCount) {
 			return 0;
 		}
 
-		unsigned int glyph_id = glyph_info[iter->glyphIndex].codepoint;
-		unsigned int cluster = glyph_info[iter->glyphIndex].cluster;
-		float x_offset = (float)glyph_pos[iter->glyphIndex].x_offset / 64.0f;
-		float y_offset = (float)glyph_pos[iter->glyphIndex].y_offset / 64.0f;
-		float x_advance = (float)glyph_pos[iter->glyphIndex].x_advance / 64.0f;
+		const NVGShapedGlyph* glyph = &cached->glyphs[iter->glyphIndex];
+		unsigned int glyph_id = glyph->glyphId;
+		unsigned int cluster = glyph->cluster;
+		float x_offset = (float)glyph->xOffset / 64.0f;
+		float y_offset = (float)glyph->yOffset / 64.0f;
+		float x_advance = (float)glyph->xAdvance / 64.0f;
 
 		unsigned int codepoint = 0;
 		nvg__decodeUTF8(iter->str + cluster, &codepoint);
@@ -658,10 +657,16 @@ float nvgFontTextBoundsShaped(NVGFontSystem* fs, float x, float y, const char* s
 		num_features++;
 	}
 
-	// Shape with HarfBuzz
-	hb_font_t* hb_font = fs->fonts[fs->state.fontId].hb_font;
-	int scale = (int)(fs->state.size * 64.0f);
-	hb_font_set_scale(hb_font, scale, scale);
+	// Shape with HarfBuzz using the pooled font for this size
+	NVGFontSize* fontSize = nvg__acquireFontSize(fs, fs->state.fontId, fs->state.size);
+	if (!fontSize) {
+		hb_buffer_destroy(hb_buffer);
+		if (bounds) {
+			bounds[0] = bounds[1] = bounds[2] = bounds[3] = 0.0f;
+		}
+		return 0.0f;
+	}
+	hb_font_t* hb_font = fontSize->hbFont;
 
 	if (num_features > 0) {
 		hb_shape(hb_font, hb_buffer, features, num_features);
@@ -1,27 +1,31 @@
 #include "nvg_font.h"
 #include "nvg_font_internal.h"
 #include "nvg_font_colr.h"
+#include "nvg_font_raster.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
 // Atlas manager internal helpers
 
-static NVGAtlas* nvg__getOrCreateAtlas(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int width, int height) {
+// Match by color spaces, format AND subpixelMode (to allow multiple atlases with different subpixel modes)
+static int nvg__atlasMatches(const NVGAtlas* atlas, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode) {
+	return atlas->active &&
+	       atlas->srcColorSpace == srcColorSpace &&
+	       atlas->dstColorSpace == dstColorSpace &&
+	       atlas->format == format &&
+	       atlas->subpixelMode == subpixelMode;
+}
+
+static NVGAtlas* nvg__getOrCreateAtlas(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page, int width, int height) {
 	if (!mgr) return NULL;
 
-	// Match by color spaces, format AND subpixelMode (to allow multiple atlases with different subpixel modes)
-	for (int i = 0; i < mgr->atlasCount; i++) {
-		if (mgr->atlases[i].active &&
-		    mgr->atlases[i].srcColorSpace == srcColorSpace &&
-		    mgr->atlases[i].dstColorSpace == dstColorSpace &&
-		    mgr->atlases[i].format == format &&
-		    mgr->atlases[i].subpixelMode == subpixelMode) {
-			return &mgr->atlases[i];
-		}
+	NVGAtlas* existing = nvg__getAtlas(mgr, srcColorSpace, dstColorSpace, format, subpixelMode, page);
+	if (existing) {
+		return existing;
 	}
 
-	if (mgr->atlasCount >= NVG_MAX_ATLAS_FORMATS) {
+	if (mgr->atlasCount >= NVG_MAX_ATLASES) {
 		return NULL;
 	}
 
@@ -30,6 +34,7 @@ static NVGAtlas* nvg__getOrCreateAtlas(NVGAtlasManager* mgr, NVGcolorSpace srcCo
 	atlas->dstColorSpace = dstColorSpace;
 	atlas->format = format;
 	atlas->subpixelMode = subpixelMode;
+	atlas->page = page;
 	atlas->width = width;
 	atlas->height = height;
 	atlas->textureId = 0;  // Will be set when texture is created
@@ -48,17 +53,14 @@ static NVGAtlas* nvg__getOrCreateAtlas(NVGAtlasManager* mgr, NVGcolorSpace srcCo
 	return atlas;
 }
 
-// Get atlas by format + color spaces + subpixelMode (composite key)
+// Get atlas page by format + color spaces + subpixelMode (composite key)
 // Format and subpixelMode are ALWAYS part of the key to distinguish different atlas types
-NVGAtlas* nvg__getAtlas(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode) {
+NVGAtlas* nvg__getAtlas(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page) {
 	if (!mgr) return NULL;
 
 	for (int i = 0; i < mgr->atlasCount; i++) {
-		if (mgr->atlases[i].active &&
-		    mgr->atlases[i].srcColorSpace == srcColorSpace &&
-		    mgr->atlases[i].dstColorSpace == dstColorSpace &&
-		    mgr->atlases[i].format == format &&
-		    mgr->atlases[i].subpixelMode == subpixelMode) {
+		if (nvg__atlasMatches(&mgr->atlases[i], srcColorSpace, dstColorSpace, format, subpixelMode) &&
+		    mgr->atlases[i].page == page) {
 			return &mgr->atlases[i];
 		}
 	}
@@ -70,48 +72,158 @@ NVGAtlas* nvg__getAtlas(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGco
 int nvg__allocAtlasNode(NVGAtlas* atlas, int w, int h, int* x, int* y);
 void nvg__expandAtlasNodes(NVGAtlas* atlas, int n);
 
-int nvgAtlasAlloc(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int w, int h, int* x, int* y) {
-	NVGAtlas* atlas = nvg__getAtlas(mgr, srcColorSpace, dstColorSpace, format, subpixelMode);
-	if (!atlas) {
-		// Atlas doesn't exist - create it on-demand
-		atlas = nvg__getOrCreateAtlas(mgr, srcColorSpace, dstColorSpace, format, subpixelMode, mgr->defaultAtlasWidth, mgr->defaultAtlasHeight);
-		if (!atlas) return 0;
+int nvgAtlasAlloc(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int w, int h, int* x, int* y, int* page) {
+	if (!mgr) return 0;
+
+	// Pages are appended in order, so walking backwards tries the newest
+	// (least full) page first and older pages only for their freed rects
+	int npages = 0;
+	for (int i = mgr->atlasCount - 1; i >= 0; i--) {
+		NVGAtlas* atlas = &mgr->atlases[i];
+		if (!nvg__atlasMatches(atlas, srcColorSpace, dstColorSpace, format, subpixelMode)) continue;
+		npages++;
+		if (nvg__allocAtlasNode(atlas, w, h, x, y)) {
+			*page = atlas->page;
+			return 1;
+		}
+	}
+
+	if (npages >= NVG_FONT_MAX_ATLAS_PAGES) {
+		fprintf(stderr, "[nvgAtlasAlloc] ERROR: All %d atlas pages are full (fmt=%u, subpixel=%d)\n", npages, format, subpixelMode);
+		return 0;
 	}
-	return nvg__allocAtlasNode(atlas, w, h, x, y);
+
+	// Add a page. The first page of a format uses the default atlas size, later ones the page size.
+	int width = npages == 0 ? mgr->defaultAtlasWidth : mgr->pageWidth;
+	int height = npages == 0 ? mgr->defaultAtlasHeight : mgr->pageHeight;
+	NVGAtlas* atlas = nvg__getOrCreateAtlas(mgr, srcColorSpace, dstColorSpace, format, subpixelMode, npages, width, height);
+	if (!atlas) return 0;
+
+	if (!nvg__allocAtlasNode(atlas, w, h, x, y)) return 0;
+	*page = atlas->page;
+	return 1;
 }
 
-void nvgAtlasUpdate(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int x, int y, int w, int h, const unsigned char* data) {
+void nvgAtlasUpdate(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page, int x, int y, int w, int h, const unsigned char* data) {
 	if (!mgr || !mgr->textureCallback) {
-		printf("[nvgAtlasUpdate] ERROR: mgr=%p, callback=%p\n", (void*)mgr, (void*)(mgr ? mgr->textureCallback : NULL));
+		fprintf(stderr, "[nvgAtlasUpdate] ERROR: mgr=%p, callback=%p\n", (void*)mgr, (void*)(mgr ? mgr->textureCallback : NULL));
 		return;
 	}
-	printf("[nvgAtlasUpdate] Calling texture callback for (%d,%d) size %dx%d, srcCS=%u, dstCS=%u, format=%u, subpixel=%d\n",
-		x, y, w, h, srcColorSpace, dstColorSpace, format, subpixelMode);
-	mgr->textureCallback(mgr->textureUserdata, x, y, w, h, data, srcColorSpace, dstColorSpace, format, subpixelMode);
+	mgr->textureCallback(mgr->textureUserdata, x, y, w, h, data, srcColorSpace, dstColorSpace, format, subpixelMode, page);
 }
 
-int nvgAtlasGrow(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int* newWidth, int* newHeight) {
-	if (!mgr || !mgr->growCallback) return 0;
-	return mgr->growCallback(mgr->growUserdata, srcColorSpace, dstColorSpace, format, subpixelMode, newWidth, newHeight);
-}
-
-void nvgAtlasGetSize(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int* w, int* h) {
-	NVGAtlas* atlas = nvg__getAtlas(mgr, srcColorSpace, dstColorSpace, format, subpixelMode);
+void nvgAtlasGetSize(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page, int* w, int* h) {
+	NVGAtlas* atlas = nvg__getAtlas(mgr, srcColorSpace, dstColorSpace, format, subpixelMode, page);
 	if (atlas && w && h) {
 		*w = atlas->width;
 		*h = atlas->height;
 	}
 }
 
+// Helper: Empty a page, optionally resizing it
+static void nvg__clearAtlas(NVGAtlas* atlas, int width, int height) {
+	atlas->width = width;
+	atlas->height = height;
+	atlas->nnodes = 1;
+	atlas->nodes[0].x = 0;
+	atlas->nodes[0].y = 0;
+	atlas->nodes[0].width = (short)width;
+	nvg__resetAtlasFreeRects(atlas);
+}
+
+// Empty every page of an atlas format. The first page takes the new size,
+// later pages keep theirs.
 void nvgAtlasReset(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int width, int height) {
-	NVGAtlas* atlas = nvg__getAtlas(mgr, srcColorSpace, dstColorSpace, format, subpixelMode);
-	if (atlas) {
-		atlas->width = width;
-		atlas->height = height;
-		atlas->nnodes = 1;
-		atlas->nodes[0].x = 0;
-		atlas->nodes[0].y = 0;
-		atlas->nodes[0].width = (short)width;
+	if (!mgr) return;
+	for (int i = 0; i < mgr->atlasCount; i++) {
+		NVGAtlas* atlas = &mgr->atlases[i];
+		if (nvg__atlasMatches(atlas, srcColorSpace, dstColorSpace, format, subpixelMode)) {
+			nvg__clearAtlas(atlas, atlas->page == 0 ? width : atlas->width, atlas->page == 0 ? height : atlas->height);
+		}
+	}
+}
+
+// Font size pool
+
+static void nvg__destroyFontSize(NVGFontSize* entry) {
+	if (entry->hbFont) {
+		hb_font_destroy(entry->hbFont);
+	}
+	if (entry->ftSize) {
+		FT_Done_Size(entry->ftSize);
+	}
+	memset(entry, 0, sizeof(NVGFontSize));
+}
+
+NVGFontSize* nvg__acquireFontSize(NVGFontSystem* fs, int fontId, float size) {
+	if (!fs || fontId < 0 || fontId >= fs->nfonts) return NULL;
+
+	NVGFontSizePool* pool = &fs->sizePool;
+	NVGFont* font = &fs->fonts[fontId];
+	int pixelSize = (int)size;
+	if (pixelSize < 1) pixelSize = 1;
+
+	NVGFontSize* victim = NULL;
+	for (int i = 0; i < pool->count; i++) {
+		NVGFontSize* entry = &pool->entries[i];
+		if (entry->fontId == fontId && entry->pixelSize == pixelSize &&
+		    entry->varStateId == font->varStateId) {
+			entry->lastUsed = ++pool->clock;
+			if (font->face->size != entry->ftSize) {
+				FT_Activate_Size(entry->ftSize);
+			}
+			return entry;
+		}
+		if (!victim || entry->lastUsed < victim->lastUsed) {
+			victim = entry;
+		}
+	}
+
+	// Miss: take a free slot or recycle the least recently used one
+	if (pool->count < NVG_FONT_SIZE_POOL_SIZE) {
+		victim = &pool->entries[pool->count++];
+	} else {
+		nvg__destroyFontSize(victim);
+	}
+
+	FT_Size ftSize;
+	if (FT_New_Size(font->face, &ftSize)) {
+		// Keep the slot but mark it unusable until recycled
+		victim->fontId = -1;
+		return NULL;
+	}
+	FT_Activate_Size(ftSize);
+	FT_Set_Pixel_Sizes(font->face, 0, (FT_UInt)pixelSize);
+
+	// hb_ft reads the scale and variation coordinates of the active size now,
+	// and loads glyphs through whichever size is active when shaping
+	hb_font_t* hbFont = hb_ft_font_create(font->face, NULL);
+	if (!hbFont) {
+		FT_Done_Size(ftSize);
+		victim->fontId = -1;
+		return NULL;
+	}
+
+	victim->fontId = fontId;
+	victim->pixelSize = pixelSize;
+	victim->varStateId = font->varStateId;
+	victim->ftSize = ftSize;
+	victim->hbFont = hbFont;
+	victim->lastUsed = ++pool->clock;
+	return victim;
+}
+
+// Drop pooled sizes of a font (all fonts if fontId is -1)
+void nvg__releaseFontSizes(NVGFontSystem* fs, int fontId) {
+	if (!fs) return;
+
+	NVGFontSizePool* pool = &fs->sizePool;
+	for (int i = 0; i < pool->count; i++) {
+		NVGFontSize* entry = &pool->entries[i];
+		if (fontId == -1 || entry->fontId == fontId) {
+			nvg__destroyFontSize(entry);
+			entry->fontId = -1;
+		}
 	}
 }
 
@@ -128,7 +240,7 @@ NVGFontSystem* nvgFontCreate(int atlasWidth, int atlasHeight) {
 	}
 
 	// Initialize glyph cache
-	fs->glyphCache = (NVGGlyphCache*)calloc(1, sizeof(NVGGlyphCache));
+	fs->glyphCache = nvg__createGlyphCache();
 	if (!fs->glyphCache) {
 		FT_Done_FreeType(fs->ftLibrary);
 		free(fs);
@@ -138,13 +250,15 @@ NVGFontSystem* nvgFontCreate(int atlasWidth, int atlasHeight) {
 	// Initialize atlas manager
 	fs->atlasManager = (NVGAtlasManager*)calloc(1, sizeof(NVGAtlasManager));
 	if (!fs->atlasManager) {
-		free(fs->glyphCache);
+		nvg__destroyGlyphCache(fs->glyphCache);
 		FT_Done_FreeType(fs->ftLibrary);
 		free(fs);
 		return NULL;
 	}
 	fs->atlasManager->defaultAtlasWidth = atlasWidth;
 	fs->atlasManager->defaultAtlasHeight = atlasHeight;
+	fs->atlasManager->pageWidth = atlasWidth > NVG_FONT_ATLAS_PAGE_SIZE ? atlasWidth : NVG_FONT_ATLAS_PAGE_SIZE;
+	fs->atlasManager->pageHeight = atlasHeight > NVG_FONT_ATLAS_PAGE_SIZE ? atlasHeight : NVG_FONT_ATLAS_PAGE_SIZE;
 
 	// Create default atlases for sRGB color space (most common case)
 	// Grayscale atlas: sRGB -> sRGB, no subpixel
@@ -153,9 +267,10 @@ NVGFontSystem* nvgFontCreate(int atlasWidth, int atlasHeight) {
 	                            NVG_COLOR_SPACE_SRGB_NONLINEAR,
 	                            NVG_TEXTURE_FORMAT_R8_UNORM,
 	                            0,  // NVG_SUBPIXEL_NONE
+	                            0,  // First page
 	                            atlasWidth, atlasHeight)) {
 		free(fs->atlasManager);
-		free(fs->glyphCache);
+		nvg__destroyGlyphCache(fs->glyphCache);
 		FT_Done_FreeType(fs->ftLibrary);
 		free(fs);
 		return NULL;
@@ -167,10 +282,11 @@ NVGFontSystem* nvgFontCreate(int atlasWidth, int atlasHeight) {
 	                            NVG_COLOR_SPACE_SRGB_NONLINEAR,
 	                            NVG_TEXTURE_FORMAT_R8G8B8A8_UNORM,
 	                            0,  // NVG_SUBPIXEL_NONE
+	                            0,  // First page
 	                            atlasWidth, atlasHeight)) {
 		free(fs->atlasManager->atlases[0].nodes);
 		free(fs->atlasManager);
-		free(fs->glyphCache);
+		nvg__destroyGlyphCache(fs->glyphCache);
 		FT_Done_FreeType(fs->ftLibrary);
 		free(fs);
 		return NULL;
@@ -185,7 +301,7 @@ NVGFontSystem* nvgFontCreate(int atlasWidth, int atlasHeight) {
 			}
 		}
 		free(fs->atlasManager);
-		free(fs->glyphCache);
+		nvg__destroyGlyphCache(fs->glyphCache);
 		FT_Done_FreeType(fs->ftLibrary);
 		free(fs);
 		return NULL;
@@ -200,6 +316,8 @@ NVGFontSystem* nvgFontCreate(int atlasWidth, int atlasHeight) {
 	fs->state.hinting = 1;
 	fs->state.kerningEnabled = 1;
 	fs->state.subpixelMode = NVG_SUBPIXEL_NONE;
+	fs->rasterThreads = NVG_FONT_RASTER_THREADS;
+	fs->streamBudgetMs = NVG_FONT_STREAM_BUDGET_MS;
 	fs->shapingState.bidi_enabled = 1;
 	fs->shapingState.base_dir = FRIBIDI_TYPE_ON;
 	fs->shapingState.runs = NULL;
@@ -219,7 +337,7 @@ NVGFontSystem* nvgFontCreate(int atlasWidth, int atlasHeight) {
 			}
 		}
 		free(fs->atlasManager);
-		free(fs->glyphCache);
+		nvg__destroyGlyphCache(fs->glyphCache);
 		FT_Done_FreeType(fs->ftLibrary);
 		free(fs);
 		return NULL;
@@ -234,6 +352,15 @@ NVGFontSystem* nvgFontCreate(int atlasWidth, int atlasHeight) {
 void nvgFontDestroy(NVGFontSystem* fs) {
 	if (!fs) return;
 
+	// Stop rasterization workers (they read font data); frees streamed jobs
+	if (fs->rasterPool) {
+		nvg__rasterPoolDestroy(fs->rasterPool);
+	}
+	free(fs->glyphJobs);
+
+	// Free pooled sizes before their faces
+	nvg__releaseFontSizes(fs, -1);
+
 	// Free all loaded fonts
 	for (int i = 0; i < fs->nfonts; i++) {
 		if (fs->fonts[i].hb_font) {
@@ -245,6 +372,7 @@ void nvgFontDestroy(NVGFontSystem* fs) {
 		if (fs->fonts[i].freeData && fs->fonts[i].data) {
 			free(fs->fonts[i].data);
 		}
+		free(fs->fonts[i].path);
 	}
 
 	// Free HarfBuzz buffer
@@ -274,13 +402,14 @@ void nvgFontDestroy(NVGFontSystem* fs) {
 			if (fs->atlasManager->atlases[i].nodes) {
 				free(fs->atlasManager->atlases[i].nodes);
 			}
+			free(fs->atlasManager->atlases[i].freeRects);
 		}
 		free(fs->atlasManager);
 	}
 
 	// Free glyph cache
 	if (fs->glyphCache) {
-		free(fs->glyphCache);
+		nvg__destroyGlyphCache(fs->glyphCache);
 	}
 
 	// Free shaped text cache (Phase 14.2)
@@ -294,18 +423,12 @@ void nvgFontDestroy(NVGFontSystem* fs) {
 	free(fs);
 }
 
-void nvgFontSetTextureCallback(NVGFontSystem* fs, void (*callback)(void* uptr, int x, int y, int w, int h, const unsigned char* data, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode), void* userdata) {
+void nvgFontSetTextureCallback(NVGFontSystem* fs, void (*callback)(void* uptr, int x, int y, int w, int h, const unsigned char* data, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page), void* userdata) {
 	if (!fs || !fs->atlasManager) return;
 	fs->atlasManager->textureCallback = callback;
 	fs->atlasManager->textureUserdata = userdata;
 }
 
-void nvgFontSetAtlasGrowCallback(NVGFontSystem* fs, int (*callback)(void* uptr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int* newWidth, int* newHeight), void* userdata) {
-	if (!fs || !fs->atlasManager) return;
-	fs->atlasManager->growCallback = callback;
-	fs->atlasManager->growUserdata = userdata;
-}
-
 void nvgFontSetColorSpace(NVGFontSystem* fs, NVGcolorSpace colorSpace) {
 	if (!fs) return;
 	fs->targetColorSpace = colorSpace;
@@ -347,6 +470,10 @@ int nvgFontAddFont(NVGFontSystem* fs, const char* name, const char* path) {
 	fs->fonts[idx].name[sizeof(fs->fonts[idx].name) - 1] = '\0';
 	fs->fonts[idx].face = face;
 	fs->fonts[idx].hb_font = hb_font;
+	fs->fonts[idx].path = (char*)malloc(strlen(path) + 1);
+	if (fs->fonts[idx].path) {
+		strcpy(fs->fonts[idx].path, path);
+	}
 	fs->fonts[idx].data = NULL;
 	fs->fonts[idx].dataSize = 0;
 	fs->fonts[idx].freeData = 0;
@@ -393,6 +520,7 @@ int nvgFontAddFontMem(NVGFontSystem* fs, const char* name, unsigned char* data,
 	fs->fonts[idx].name[sizeof(fs->fonts[idx].name) - 1] = '\0';
 	fs->fonts[idx].face = face;
 	fs->fonts[idx].hb_font = hb_font;
+	fs->fonts[idx].path = NULL;
 	fs->fonts[idx].data = data;
 	fs->fonts[idx].dataSize = ndata;
 	fs->fonts[idx].freeData = freeData;
@@ -494,21 +622,14 @@ void nvgFontSetFontMSDF(NVGFontSystem* fs, int font, int msdfMode) {
 void nvgFontResetAtlas(NVGFontSystem* fs, int width, int height) {
 	if (!fs || !fs->glyphCache || !fs->atlasManager) return;
 
-	// Clear glyph cache
-	memset(fs->glyphCache->entries, 0, sizeof(fs->glyphCache->entries));
-	fs->glyphCache->count = 0;
-	fs->glyphCache->generation++;
+	// Clear glyph cache (hit/miss/eviction counters are kept)
+	nvg__resetGlyphCache(fs->glyphCache);
 
-	// Reset all atlases
+	// Reset all atlases (extra pages keep their size and texture)
 	for (int i = 0; i < fs->atlasManager->atlasCount; i++) {
 		NVGAtlas* atlas = &fs->atlasManager->atlases[i];
 		if (atlas->active) {
-			atlas->width = width;
-			atlas->height = height;
-			atlas->nnodes = 1;
-			atlas->nodes[0].x = 0;
-			atlas->nodes[0].y = 0;
-			atlas->nodes[0].width = (short)width;
+			nvg__clearAtlas(atlas, atlas->page == 0 ? width : atlas->width, atlas->page == 0 ? height : atlas->height);
 		}
 	}
 }
@@ -519,15 +640,15 @@ void nvgFontSetSubpixelMode(NVGFontSystem* fs, int mode) {
 	fs->state.subpixelMode = (NVGSubpixelMode)mode;
 }
 
-int nvgFontGetAtlasTexture(NVGFontSystem* fs, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode) {
+int nvgFontGetAtlasTexture(NVGFontSystem* fs, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page) {
 	if (!fs || !fs->atlasManager) return 0;
-	NVGAtlas* atlas = nvg__getAtlas(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode);
+	NVGAtlas* atlas = nvg__getAtlas(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, page);
 	return atlas ? atlas->textureId : 0;
 }
 
-void nvgFontSetAtlasTexture(NVGFontSystem* fs, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int textureId) {
+void nvgFontSetAtlasTexture(NVGFontSystem* fs, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page, int textureId) {
 	if (!fs || !fs->atlasManager) return;
-	NVGAtlas* atlas = nvg__getAtlas(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode);
+	NVGAtlas* atlas = nvg__getAtlas(fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, page);
 	if (atlas) {
 		atlas->textureId = textureId;
 	}
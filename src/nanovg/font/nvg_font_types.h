@@ -9,13 +9,26 @@
 #define NVG_FONT_MAX_FALLBACKS 8
 #define NVG_FONT_MAX_VAR_AXES 32
 #define NVG_FONT_ATLAS_INITIAL_SIZE 512
-#define NVG_FONT_GLYPH_CACHE_SIZE 1024
+#define NVG_FONT_ATLAS_PAGE_SIZE 2048   // Side of the pages added when an atlas is full
+#define NVG_FONT_MAX_ATLAS_PAGES 32     // Pages per atlas format
+#define NVG_FONT_ATLAS_MAX_FREE_RECTS 256  // Regions released by evicted glyphs, per atlas page
+#define NVG_FONT_GLYPH_CACHE_SIZE 1024  // Initial entries, power of two (doubles if one frame needs more)
+#define NVG_FONT_SIZE_POOL_SIZE 16     // Live FT_Size + hb_font pairs
+#define NVG_FONT_RASTER_THREADS 4      // Default glyph rasterization workers (0 = serial)
+#define NVG_FONT_MAX_RASTER_THREADS 16
+#define NVG_FONT_RASTER_MIN_BATCH 8    // Smaller batches are rasterized on the calling thread
+#define NVG_FONT_STREAM_QUEUE_SIZE 1024  // Power of two, glyphs in flight when streaming
+#define NVG_FONT_STREAM_BUDGET_MS 2.0f   // Default main thread time per frame for streamed glyphs
 
 // Forward declarations
 typedef struct NVGFontSystem NVGFontSystem;
 typedef struct NVGFont NVGFont;
 typedef struct NVGGlyphCache NVGGlyphCache;
 typedef struct NVGAtlasManager NVGAtlasManager;
+typedef struct NVGRasterPool NVGRasterPool;
+
+// Called on the main thread when a streamed glyph has been added to the atlas
+typedef void (*NVGGlyphReadyFunc)(void* uptr, int fontId, unsigned int codepoint, float size);
 
 // Glyph metrics
 typedef struct {
@@ -40,9 +53,19 @@ typedef struct {
 	NVGcolorSpace dstColorSpace;     // Destination color space (identifies atlas)
 	NVGtextureFormat format;         // Texture format (identifies atlas)
 	int subpixelMode;                // Subpixel mode (identifies atlas)
+	int page;                        // Atlas page holding the glyph
 	unsigned int generation;         // For cache invalidation
 } NVGCachedGlyph;
 
+// Glyph cache statistics (counters are cumulative since font system creation)
+typedef struct {
+	unsigned int hits;
+	unsigned int misses;
+	unsigned int evictions;
+	int count;     // Glyphs currently cached
+	int capacity;  // Entry pool size, NVG_FONT_GLYPH_CACHE_SIZE until a frame outgrows it
+} NVGGlyphCacheStats;
+
 // Text iterator for shaped text
 typedef struct {
 	float x, y;           // Current position
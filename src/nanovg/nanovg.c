@@ -25,6 +25,7 @@
 #include "font/nvg_font.h"
 #include "font/nvg_font_internal.h"
 #include "font/nvg_font_types.h"
+#include "nvg_path_simd.h"
 
 #ifndef NVG_NO_STB
 #define STB_IMAGE_IMPLEMENTATION
@@ -46,6 +47,10 @@
 #define NVG_INIT_POINTS_SIZE 128
 #define NVG_INIT_PATHS_SIZE 16
 #define NVG_INIT_VERTS_SIZE 256
+#define NVG_MAX_BEZIER_SEGMENTS 1024	// Upper bound of line segments per flattened cubic.
+#define NVG_GEOMETRY_CACHE_SIZE 64		// Memoized fill/stroke tessellations (NVGparams.geometryCache).
+#define NVG_GEOMETRY_CACHE_BUCKETS 128	// Power of two
+#define NVG_GEOMETRY_CACHE_ENTRY_BYTES (256*1024)	// Larger tessellations are drawn uncached, bounding the cache at 64 x 256 KB = 16 MB.
 
 #ifndef NVG_MAX_STATES
 #define NVG_MAX_STATES 32
@@ -98,11 +103,9 @@ struct NVGstate {
 };
 typedef struct NVGstate NVGstate;
 
+// Points as added by the flattener, their segments and joins live in NVGpathCache.soa.
 struct NVGpoint {
 	float x,y;
-	float dx, dy;
-	float len;
-	float dmx, dmy;
 	unsigned char flags;
 };
 typedef struct NVGpoint NVGpoint;
@@ -117,6 +120,9 @@ struct NVGpathCache {
 	NVGvertex* verts;
 	int nverts;
 	int cverts;
+	NVGglyphInstance* glyphs;
+	int cglyphs;
+	NVGpathSoA soa;		// Positions, segments and joins of the flattened points, sized to cpoints.
 	float bounds[4];
 };
 typedef struct NVGpathCache NVGpathCache;
@@ -143,12 +149,17 @@ struct NVGcontext {
 	int fillTriCount;
 	int strokeTriCount;
 	int textTriCount;
+	struct NVGgeometryCache* geomCache;
+	NVGshape shape;			// Analytic shape of the current path (NVGparams.renderShape)
+	int shapeCommands;		// ncommands right after the shape, it is stale once more commands follow
+	int cpuVerts;			// Expand into cache->verts even with renderAllocVerts (output is stored, not drawn)
 };
 
+static struct NVGgeometryCache* nvg__createGeometryCache(void);
+static void nvg__deleteGeometryCache(struct NVGgeometryCache* cache);
+
 // Forward declarations for font system callbacks
-void nvgAtlasReset(NVGAtlasManager* mgr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int width, int height);
-static void nvg__textureUpdate(void* uptr, int x, int y, int w, int h, const unsigned char* data, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode);
-static int nvg__atlasGrow(void* uptr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int* newWidth, int* newHeight);
+static void nvg__textureUpdate(void* uptr, int x, int y, int w, int h, const unsigned char* data, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page);
 
 static float nvg__sqrtf(float a) { return sqrtf(a); }
 static float nvg__modf(float a, float b) { return fmodf(a, b); }
@@ -186,6 +197,8 @@ static void nvg__deletePathCache(NVGpathCache* c)
 	if (c->points != NULL) free(c->points);
 	if (c->paths != NULL) free(c->paths);
 	if (c->verts != NULL) free(c->verts);
+	if (c->glyphs != NULL) free(c->glyphs);
+	nvgPathSoAFree(&c->soa);
 	free(c);
 }
 
@@ -199,6 +212,7 @@ static NVGpathCache* nvg__allocPathCache(void)
 	if (!c->points) goto error;
 	c->npoints = 0;
 	c->cpoints = NVG_INIT_POINTS_SIZE;
+	if (!nvgPathSoAReserve(&c->soa, NVG_INIT_POINTS_SIZE)) goto error;
 
 	c->paths = (NVGpath*)malloc(sizeof(NVGpath)*NVG_INIT_PATHS_SIZE);
 	if (!c->paths) goto error;
@@ -302,9 +316,6 @@ static NVGstate* nvg__getState(NVGcontext* ctx)
 	return &ctx->states[ctx->nstates-1];
 }
 
-// Forward declaration for texture callback
-static void nvg__textureUpdate(void* uptr, int x, int y, int w, int h, const unsigned char* data, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode);
-
 NVGcontext* nvgCreateInternal(NVGparams* params)
 {
 	NVGcontext* ctx = (NVGcontext*)malloc(sizeof(NVGcontext));
@@ -331,6 +342,11 @@ NVGcontext* nvgCreateInternal(NVGparams* params)
 
 	nvg__setDevicePixelRatio(ctx, 1.0f);
 
+	if (params->geometryCache) {
+		ctx->geomCache = nvg__createGeometryCache();
+		if (ctx->geomCache == NULL) goto error;
+	}
+
 	if (ctx->params.renderCreate(ctx->params.userPtr) == 0) goto error;
 
 	// Init font rendering with nvg_freetype
@@ -339,12 +355,9 @@ NVGcontext* nvgCreateInternal(NVGparams* params)
 	ctx->fs = nvgFontCreate(atlasSize, atlasSize);
 	if (ctx->fs == NULL) goto error;
 
-	// Set texture upload callback
+	// Set texture upload callback (also creates the texture of each new atlas page)
 	nvgFontSetTextureCallback(ctx->fs, nvg__textureUpdate, ctx);
 
-	// Set atlas growth callback
-	nvgFontSetAtlasGrowCallback(ctx->fs, nvg__atlasGrow, ctx);
-
 	// Set target color space if provided by backend
 	if (params->colorSpace != 0) {
 		nvgFontSetColorSpace(ctx->fs, (NVGcolorSpace)params->colorSpace);
@@ -385,6 +398,7 @@ void nvgDeleteInternal(NVGcontext* ctx)
 	if (ctx == NULL) return;
 	if (ctx->commands != NULL) free(ctx->commands);
 	if (ctx->cache != NULL) nvg__deletePathCache(ctx->cache);
+	nvg__deleteGeometryCache(ctx->geomCache);
 
 	if (ctx->fs)
 		nvgFontDestroy(ctx->fs);
@@ -424,6 +438,11 @@ void nvgBeginFrame(NVGcontext* ctx, float windowWidth, float windowHeight, float
 	ctx->fillTriCount = 0;
 	ctx->strokeTriCount = 0;
 	ctx->textTriCount = 0;
+
+	// Add glyphs streamed in since the last frame; uploads go out with this frame
+	if (ctx->fs) {
+		nvgFontBeginFrame(ctx->fs);
+	}
 }
 
 void nvgCancelFrame(NVGcontext* ctx)
@@ -1212,6 +1231,20 @@ static NVGpoint* nvg__lastPoint(NVGcontext* ctx)
 	return NULL;
 }
 
+static int nvg__reservePoints(NVGcontext* ctx, int npoints)
+{
+	if (ctx->cache->npoints+npoints > ctx->cache->cpoints) {
+		NVGpoint* points;
+		int cpoints = ctx->cache->npoints+npoints + ctx->cache->cpoints/2;
+		if (!nvgPathSoAReserve(&ctx->cache->soa, cpoints)) return 0;
+		points = (NVGpoint*)realloc(ctx->cache->points, sizeof(NVGpoint)*cpoints);
+		if (points == NULL) return 0;
+		ctx->cache->points = points;
+		ctx->cache->cpoints = cpoints;
+	}
+	return 1;
+}
+
 static void nvg__addPoint(NVGcontext* ctx, float x, float y, int flags)
 {
 	NVGpath* path = nvg__lastPath(ctx);
@@ -1226,14 +1259,7 @@ static void nvg__addPoint(NVGcontext* ctx, float x, float y, int flags)
 		}
 	}
 
-	if (ctx->cache->npoints+1 > ctx->cache->cpoints) {
-		NVGpoint* points;
-		int cpoints = ctx->cache->npoints+1 + ctx->cache->cpoints/2;
-		points = (NVGpoint*)realloc(ctx->cache->points, sizeof(NVGpoint)*cpoints);
-		if (points == NULL) return;
-		ctx->cache->points = points;
-		ctx->cache->cpoints = cpoints;
-	}
+	if (!nvg__reservePoints(ctx, 1)) return;
 
 	pt = &ctx->cache->points[ctx->cache->npoints];
 	memset(pt, 0, sizeof(*pt));
@@ -1268,6 +1294,13 @@ static float nvg__getAverageScale(float *t)
 
 static NVGvertex* nvg__allocTempVerts(NVGcontext* ctx, int nverts)
 {
+	// Back-ends with mapped vertex memory take the output directly (zero-copy).
+	// Output that is read back into a geometry cache stays in CPU memory instead.
+	if (ctx->params.renderAllocVerts != NULL && !ctx->cpuVerts) {
+		NVGvertex* verts = ctx->params.renderAllocVerts(ctx->params.userPtr, nverts);
+		if (verts != NULL) return verts;
+	}
+
 	if (nverts > ctx->cache->cverts) {
 		NVGvertex* verts;
 		int cverts = (nverts + 0xff) & ~0xff; // Round up to prevent allocations when things change just slightly.
@@ -1280,6 +1313,20 @@ static NVGvertex* nvg__allocTempVerts(NVGcontext* ctx, int nverts)
 	return ctx->cache->verts;
 }
 
+static NVGglyphInstance* nvg__allocTempGlyphs(NVGcontext* ctx, int nglyphs)
+{
+	if (nglyphs > ctx->cache->cglyphs) {
+		NVGglyphInstance* glyphs;
+		int cglyphs = (nglyphs + 0xff) & ~0xff; // Round up to prevent allocations when things change just slightly.
+		glyphs = (NVGglyphInstance*)realloc(ctx->cache->glyphs, sizeof(NVGglyphInstance)*cglyphs);
+		if (glyphs == NULL) return NULL;
+		ctx->cache->glyphs = glyphs;
+		ctx->cache->cglyphs = cglyphs;
+	}
+
+	return ctx->cache->glyphs;
+}
+
 static float nvg__triarea2(float ax, float ay, float bx, float by, float cx, float cy)
 {
 	float abx = bx - ax;
@@ -1324,53 +1371,67 @@ static void nvg__vset(NVGvertex* vtx, float x, float y, float u, float v)
 	vtx->v = v;
 }
 
+// Number of line segments keeping a cubic within tol of its flattening (Wang's formula):
+// n = sqrt(3*2/8 * max|second difference of the control points| / tol).
+static int nvg__bezierSegments(float x1, float y1, float x2, float y2,
+							   float x3, float y3, float x4, float y4, float tol)
+{
+	float ddx0 = x1 - 2.0f*x2 + x3, ddy0 = y1 - 2.0f*y2 + y3;
+	float ddx1 = x2 - 2.0f*x3 + x4, ddy1 = y2 - 2.0f*y3 + y4;
+	float dd = nvg__maxf(ddx0*ddx0 + ddy0*ddy0, ddx1*ddx1 + ddy1*ddy1);
+	float n = ceilf(nvg__sqrtf(0.75f * nvg__sqrtf(dd) / tol));
+	if (!(n >= 1.0f)) return 1;	// Also catches NaN from degenerate input.
+	if (n > NVG_MAX_BEZIER_SEGMENTS) return NVG_MAX_BEZIER_SEGMENTS;
+	return (int)n;
+}
+
 static void nvg__tesselateBezier(NVGcontext* ctx,
 								 float x1, float y1, float x2, float y2,
 								 float x3, float y3, float x4, float y4,
-								 int level, int type)
-{
-	float x12,y12,x23,y23,x34,y34,x123,y123,x234,y234,x1234,y1234;
-	float dx,dy,d2,d3;
-
-	if (level > 10) return;
-
-	x12 = (x1+x2)*0.5f;
-	y12 = (y1+y2)*0.5f;
-	x23 = (x2+x3)*0.5f;
-	y23 = (y2+y3)*0.5f;
-	x34 = (x3+x4)*0.5f;
-	y34 = (y3+y4)*0.5f;
-	x123 = (x12+x23)*0.5f;
-	y123 = (y12+y23)*0.5f;
-
-	dx = x4 - x1;
-	dy = y4 - y1;
-	d2 = nvg__absf(((x2 - x4) * dy - (y2 - y4) * dx));
-	d3 = nvg__absf(((x3 - x4) * dy - (y3 - y4) * dx));
-
-	if ((d2 + d3)*(d2 + d3) < ctx->tessTol * (dx*dx + dy*dy)) {
-		nvg__addPoint(ctx, x4, y4, type);
-		return;
+								 int type)
+{
+	// Commands are stored transformed, so the segment count already follows the transform scale.
+	// tessTol was compared against squared distances by the recursive flattener, so the
+	// flatness distance it stands for is its square root (0.5 px at a device ratio of 1).
+	int i, n = nvg__bezierSegments(x1,y1, x2,y2, x3,y3, x4,y4, nvg__sqrtf(ctx->tessTol));
+	float h = 1.0f / n, h2 = h*h, h3 = h2*h;
+	float ax, ay, bx, by, cx, cy;
+	float x, y, dx, dy, ddx, ddy, dddx, dddy;
+
+	if (!nvg__reservePoints(ctx, n)) return;
+
+	// Power basis: B(t) = a t^3 + b t^2 + c t + p1
+	ax = -x1 + 3.0f*(x2 - x3) + x4;
+	ay = -y1 + 3.0f*(y2 - y3) + y4;
+	bx = 3.0f*(x1 - 2.0f*x2 + x3);
+	by = 3.0f*(y1 - 2.0f*y2 + y3);
+	cx = 3.0f*(x2 - x1);
+	cy = 3.0f*(y2 - y1);
+
+	// Forward differences for a step of h
+	x = x1;
+	y = y1;
+	dx = ax*h3 + bx*h2 + cx*h;
+	dy = ay*h3 + by*h2 + cy*h;
+	ddx = 6.0f*ax*h3 + 2.0f*bx*h2;
+	ddy = 6.0f*ay*h3 + 2.0f*by*h2;
+	dddx = 6.0f*ax*h3;
+	dddy = 6.0f*ay*h3;
+
+	for (i = 1; i < n; i++) {
+		x += dx; dx += ddx; ddx += dddx;
+		y += dy; dy += ddy; ddy += dddy;
+		nvg__addPoint(ctx, x, y, 0);
 	}
-
-/*	if (nvg__absf(x1+x3-x2-x2) + nvg__absf(y1+y3-y2-y2) + nvg__absf(x2+x4-x3-x3) + nvg__absf(y2+y4-y3-y3) < ctx->tessTol) {
-		nvg__addPoint(ctx, x4, y4, type);
-		return;
-	}*/
-
-	x234 = (x23+x34)*0.5f;
-	y234 = (y23+y34)*0.5f;
-	x1234 = (x123+x234)*0.5f;
-	y1234 = (y123+y234)*0.5f;
-
-	nvg__tesselateBezier(ctx, x1,y1, x12,y12, x123,y123, x1234,y1234, level+1, 0);
-	nvg__tesselateBezier(ctx, x1234,y1234, x234,y234, x34,y34, x4,y4, level+1, type);
+	// Exact end point, accumulated rounding never moves it.
+	nvg__addPoint(ctx, x4, y4, type);
 }
 
 static void nvg__flattenPaths(NVGcontext* ctx)
 {
 	NVGpathCache* cache = ctx->cache;
 //	NVGstate* state = nvg__getState(ctx);
+	NVGpathSoA* soa = &cache->soa;
 	NVGpoint* last;
 	NVGpoint* p0;
 	NVGpoint* p1;
@@ -1407,7 +1468,7 @@ static void nvg__flattenPaths(NVGcontext* ctx)
 				cp1 = &ctx->commands[i+1];
 				cp2 = &ctx->commands[i+3];
 				p = &ctx->commands[i+5];
-				nvg__tesselateBezier(ctx, last->x,last->y, cp1[0],cp1[1], cp2[0],cp2[1], p[0],p[1], 0, NVG_PT_CORNER);
+				nvg__tesselateBezier(ctx, last->x,last->y, cp1[0],cp1[1], cp2[0],cp2[1], p[0],p[1], NVG_PT_CORNER);
 			}
 			i += 7;
 			break;
@@ -1450,19 +1511,19 @@ static void nvg__flattenPaths(NVGcontext* ctx)
 				nvg__polyReverse(pts, path->count);
 		}
 
-		for(i = 0; i < path->count; i++) {
-			// Calculate segment direction and length
-			p0->dx = p1->x - p0->x;
-			p0->dy = p1->y - p0->y;
-			p0->len = nvg__normalize(&p0->dx, &p0->dy);
-			// Update bounds
-			cache->bounds[0] = nvg__minf(cache->bounds[0], p0->x);
-			cache->bounds[1] = nvg__minf(cache->bounds[1], p0->y);
-			cache->bounds[2] = nvg__maxf(cache->bounds[2], p0->x);
-			cache->bounds[3] = nvg__maxf(cache->bounds[3], p0->y);
-			// Advance
-			p0 = p1++;
+		// Gather positions and update bounds.
+		for (i = 0; i < path->count; i++) {
+			soa->x[path->first + i] = pts[i].x;
+			soa->y[path->first + i] = pts[i].y;
+			cache->bounds[0] = nvg__minf(cache->bounds[0], pts[i].x);
+			cache->bounds[1] = nvg__minf(cache->bounds[1], pts[i].y);
+			cache->bounds[2] = nvg__maxf(cache->bounds[2], pts[i].x);
+			cache->bounds[3] = nvg__maxf(cache->bounds[3], pts[i].y);
 		}
+
+		// Calculate segment direction and length.
+		nvgPathSegments(&soa->x[path->first], &soa->y[path->first], path->count,
+						&soa->dx[path->first], &soa->dy[path->first], &soa->len[path->first]);
 	}
 }
 
@@ -1472,162 +1533,162 @@ static int nvg__curveDivs(float r, float arc, float tol)
 	return nvg__maxi(2, (int)ceilf(arc / da));
 }
 
-static void nvg__chooseBevel(int bevel, NVGpoint* p0, NVGpoint* p1, float w,
+static void nvg__chooseBevel(int bevel, const NVGpathSoA* s, int p0, int p1, float w,
 							float* x0, float* y0, float* x1, float* y1)
 {
 	if (bevel) {
-		*x0 = p1->x + p0->dy * w;
-		*y0 = p1->y - p0->dx * w;
-		*x1 = p1->x + p1->dy * w;
-		*y1 = p1->y - p1->dx * w;
+		*x0 = s->x[p1] + s->dy[p0] * w;
+		*y0 = s->y[p1] - s->dx[p0] * w;
+		*x1 = s->x[p1] + s->dy[p1] * w;
+		*y1 = s->y[p1] - s->dx[p1] * w;
 	} else {
-		*x0 = p1->x + p1->dmx * w;
-		*y0 = p1->y + p1->dmy * w;
-		*x1 = p1->x + p1->dmx * w;
-		*y1 = p1->y + p1->dmy * w;
+		*x0 = s->x[p1] + s->dmx[p1] * w;
+		*y0 = s->y[p1] + s->dmy[p1] * w;
+		*x1 = s->x[p1] + s->dmx[p1] * w;
+		*y1 = s->y[p1] + s->dmy[p1] * w;
 	}
 }
 
-static NVGvertex* nvg__roundJoin(NVGvertex* dst, NVGpoint* p0, NVGpoint* p1,
+static NVGvertex* nvg__roundJoin(NVGvertex* dst, const NVGpathSoA* s, int p0, int p1,
 								 float lw, float rw, float lu, float ru, int ncap,
 								 float fringe)
 {
 	int i, n;
-	float dlx0 = p0->dy;
-	float dly0 = -p0->dx;
-	float dlx1 = p1->dy;
-	float dly1 = -p1->dx;
+	float dlx0 = s->dy[p0];
+	float dly0 = -s->dx[p0];
+	float dlx1 = s->dy[p1];
+	float dly1 = -s->dx[p1];
 	NVG_NOTUSED(fringe);
 
-	if (p1->flags & NVG_PT_LEFT) {
+	if (s->flags[p1] & NVG_PT_LEFT) {
 		float lx0,ly0,lx1,ly1,a0,a1;
-		nvg__chooseBevel(p1->flags & NVG_PR_INNERBEVEL, p0, p1, lw, &lx0,&ly0, &lx1,&ly1);
+		nvg__chooseBevel(s->flags[p1] & NVG_PR_INNERBEVEL, s, p0, p1, lw, &lx0,&ly0, &lx1,&ly1);
 		a0 = atan2f(-dly0, -dlx0);
 		a1 = atan2f(-dly1, -dlx1);
 		if (a1 > a0) a1 -= NVG_PI*2;
 
 		nvg__vset(dst, lx0, ly0, lu,1); dst++;
-		nvg__vset(dst, p1->x - dlx0*rw, p1->y - dly0*rw, ru,1); dst++;
+		nvg__vset(dst, s->x[p1] - dlx0*rw, s->y[p1] - dly0*rw, ru,1); dst++;
 
 		n = nvg__clampi((int)ceilf(((a0 - a1) / NVG_PI) * ncap), 2, ncap);
 		for (i = 0; i < n; i++) {
 			float u = i/(float)(n-1);
 			float a = a0 + u*(a1-a0);
-			float rx = p1->x + cosf(a) * rw;
-			float ry = p1->y + sinf(a) * rw;
-			nvg__vset(dst, p1->x, p1->y, 0.5f,1); dst++;
+			float rx = s->x[p1] + cosf(a) * rw;
+			float ry = s->y[p1] + sinf(a) * rw;
+			nvg__vset(dst, s->x[p1], s->y[p1], 0.5f,1); dst++;
 			nvg__vset(dst, rx, ry, ru,1); dst++;
 		}
 
 		nvg__vset(dst, lx1, ly1, lu,1); dst++;
-		nvg__vset(dst, p1->x - dlx1*rw, p1->y - dly1*rw, ru,1); dst++;
+		nvg__vset(dst, s->x[p1] - dlx1*rw, s->y[p1] - dly1*rw, ru,1); dst++;
 
 	} else {
 		float rx0,ry0,rx1,ry1,a0,a1;
-		nvg__chooseBevel(p1->flags & NVG_PR_INNERBEVEL, p0, p1, -rw, &rx0,&ry0, &rx1,&ry1);
+		nvg__chooseBevel(s->flags[p1] & NVG_PR_INNERBEVEL, s, p0, p1, -rw, &rx0,&ry0, &rx1,&ry1);
 		a0 = atan2f(dly0, dlx0);
 		a1 = atan2f(dly1, dlx1);
 		if (a1 < a0) a1 += NVG_PI*2;
 
-		nvg__vset(dst, p1->x + dlx0*rw, p1->y + dly0*rw, lu,1); dst++;
+		nvg__vset(dst, s->x[p1] + dlx0*rw, s->y[p1] + dly0*rw, lu,1); dst++;
 		nvg__vset(dst, rx0, ry0, ru,1); dst++;
 
 		n = nvg__clampi((int)ceilf(((a1 - a0) / NVG_PI) * ncap), 2, ncap);
 		for (i = 0; i < n; i++) {
 			float u = i/(float)(n-1);
 			float a = a0 + u*(a1-a0);
-			float lx = p1->x + cosf(a) * lw;
-			float ly = p1->y + sinf(a) * lw;
+			float lx = s->x[p1] + cosf(a) * lw;
+			float ly = s->y[p1] + sinf(a) * lw;
 			nvg__vset(dst, lx, ly, lu,1); dst++;
-			nvg__vset(dst, p1->x, p1->y, 0.5f,1); dst++;
+			nvg__vset(dst, s->x[p1], s->y[p1], 0.5f,1); dst++;
 		}
 
-		nvg__vset(dst, p1->x + dlx1*rw, p1->y + dly1*rw, lu,1); dst++;
+		nvg__vset(dst, s->x[p1] + dlx1*rw, s->y[p1] + dly1*rw, lu,1); dst++;
 		nvg__vset(dst, rx1, ry1, ru,1); dst++;
 
 	}
 	return dst;
 }
 
-static NVGvertex* nvg__bevelJoin(NVGvertex* dst, NVGpoint* p0, NVGpoint* p1,
+static NVGvertex* nvg__bevelJoin(NVGvertex* dst, const NVGpathSoA* s, int p0, int p1,
 										float lw, float rw, float lu, float ru, float fringe)
 {
 	float rx0,ry0,rx1,ry1;
 	float lx0,ly0,lx1,ly1;
-	float dlx0 = p0->dy;
-	float dly0 = -p0->dx;
-	float dlx1 = p1->dy;
-	float dly1 = -p1->dx;
+	float dlx0 = s->dy[p0];
+	float dly0 = -s->dx[p0];
+	float dlx1 = s->dy[p1];
+	float dly1 = -s->dx[p1];
 	NVG_NOTUSED(fringe);
 
-	if (p1->flags & NVG_PT_LEFT) {
-		nvg__chooseBevel(p1->flags & NVG_PR_INNERBEVEL, p0, p1, lw, &lx0,&ly0, &lx1,&ly1);
+	if (s->flags[p1] & NVG_PT_LEFT) {
+		nvg__chooseBevel(s->flags[p1] & NVG_PR_INNERBEVEL, s, p0, p1, lw, &lx0,&ly0, &lx1,&ly1);
 
 		nvg__vset(dst, lx0, ly0, lu,1); dst++;
-		nvg__vset(dst, p1->x - dlx0*rw, p1->y - dly0*rw, ru,1); dst++;
+		nvg__vset(dst, s->x[p1] - dlx0*rw, s->y[p1] - dly0*rw, ru,1); dst++;
 
-		if (p1->flags & NVG_PT_BEVEL) {
+		if (s->flags[p1] & NVG_PT_BEVEL) {
 			nvg__vset(dst, lx0, ly0, lu,1); dst++;
-			nvg__vset(dst, p1->x - dlx0*rw, p1->y - dly0*rw, ru,1); dst++;
+			nvg__vset(dst, s->x[p1] - dlx0*rw, s->y[p1] - dly0*rw, ru,1); dst++;
 
 			nvg__vset(dst, lx1, ly1, lu,1); dst++;
-			nvg__vset(dst, p1->x - dlx1*rw, p1->y - dly1*rw, ru,1); dst++;
+			nvg__vset(dst, s->x[p1] - dlx1*rw, s->y[p1] - dly1*rw, ru,1); dst++;
 		} else {
-			rx0 = p1->x - p1->dmx * rw;
-			ry0 = p1->y - p1->dmy * rw;
+			rx0 = s->x[p1] - s->dmx[p1] * rw;
+			ry0 = s->y[p1] - s->dmy[p1] * rw;
 
-			nvg__vset(dst, p1->x, p1->y, 0.5f,1); dst++;
-			nvg__vset(dst, p1->x - dlx0*rw, p1->y - dly0*rw, ru,1); dst++;
+			nvg__vset(dst, s->x[p1], s->y[p1], 0.5f,1); dst++;
+			nvg__vset(dst, s->x[p1] - dlx0*rw, s->y[p1] - dly0*rw, ru,1); dst++;
 
 			nvg__vset(dst, rx0, ry0, ru,1); dst++;
 			nvg__vset(dst, rx0, ry0, ru,1); dst++;
 
-			nvg__vset(dst, p1->x, p1->y, 0.5f,1); dst++;
-			nvg__vset(dst, p1->x - dlx1*rw, p1->y - dly1*rw, ru,1); dst++;
+			nvg__vset(dst, s->x[p1], s->y[p1], 0.5f,1); dst++;
+			nvg__vset(dst, s->x[p1] - dlx1*rw, s->y[p1] - dly1*rw, ru,1); dst++;
 		}
 
 		nvg__vset(dst, lx1, ly1, lu,1); dst++;
-		nvg__vset(dst, p1->x - dlx1*rw, p1->y - dly1*rw, ru,1); dst++;
+		nvg__vset(dst, s->x[p1] - dlx1*rw, s->y[p1] - dly1*rw, ru,1); dst++;
 
 	} else {
-		nvg__chooseBevel(p1->flags & NVG_PR_INNERBEVEL, p0, p1, -rw, &rx0,&ry0, &rx1,&ry1);
+		nvg__chooseBevel(s->flags[p1] & NVG_PR_INNERBEVEL, s, p0, p1, -rw, &rx0,&ry0, &rx1,&ry1);
 
-		nvg__vset(dst, p1->x + dlx0*lw, p1->y + dly0*lw, lu,1); dst++;
+		nvg__vset(dst, s->x[p1] + dlx0*lw, s->y[p1] + dly0*lw, lu,1); dst++;
 		nvg__vset(dst, rx0, ry0, ru,1); dst++;
 
-		if (p1->flags & NVG_PT_BEVEL) {
-			nvg__vset(dst, p1->x + dlx0*lw, p1->y + dly0*lw, lu,1); dst++;
+		if (s->flags[p1] & NVG_PT_BEVEL) {
+			nvg__vset(dst, s->x[p1] + dlx0*lw, s->y[p1] + dly0*lw, lu,1); dst++;
 			nvg__vset(dst, rx0, ry0, ru,1); dst++;
 
-			nvg__vset(dst, p1->x + dlx1*lw, p1->y + dly1*lw, lu,1); dst++;
+			nvg__vset(dst, s->x[p1] + dlx1*lw, s->y[p1] + dly1*lw, lu,1); dst++;
 			nvg__vset(dst, rx1, ry1, ru,1); dst++;
 		} else {
-			lx0 = p1->x + p1->dmx * lw;
-			ly0 = p1->y + p1->dmy * lw;
+			lx0 = s->x[p1] + s->dmx[p1] * lw;
+			ly0 = s->y[p1] + s->dmy[p1] * lw;
 
-			nvg__vset(dst, p1->x + dlx0*lw, p1->y + dly0*lw, lu,1); dst++;
-			nvg__vset(dst, p1->x, p1->y, 0.5f,1); dst++;
+			nvg__vset(dst, s->x[p1] + dlx0*lw, s->y[p1] + dly0*lw, lu,1); dst++;
+			nvg__vset(dst, s->x[p1], s->y[p1], 0.5f,1); dst++;
 
 			nvg__vset(dst, lx0, ly0, lu,1); dst++;
 			nvg__vset(dst, lx0, ly0, lu,1); dst++;
 
-			nvg__vset(dst, p1->x + dlx1*lw, p1->y + dly1*lw, lu,1); dst++;
-			nvg__vset(dst, p1->x, p1->y, 0.5f,1); dst++;
+			nvg__vset(dst, s->x[p1] + dlx1*lw, s->y[p1] + dly1*lw, lu,1); dst++;
+			nvg__vset(dst, s->x[p1], s->y[p1], 0.5f,1); dst++;
 		}
 
-		nvg__vset(dst, p1->x + dlx1*lw, p1->y + dly1*lw, lu,1); dst++;
+		nvg__vset(dst, s->x[p1] + dlx1*lw, s->y[p1] + dly1*lw, lu,1); dst++;
 		nvg__vset(dst, rx1, ry1, ru,1); dst++;
 	}
 
 	return dst;
 }
 
-static NVGvertex* nvg__buttCapStart(NVGvertex* dst, NVGpoint* p,
+static NVGvertex* nvg__buttCapStart(NVGvertex* dst, const NVGpathSoA* s, int p,
 									float dx, float dy, float w, float d,
 									float aa, float u0, float u1)
 {
-	float px = p->x - dx*d;
-	float py = p->y - dy*d;
+	float px = s->x[p] - dx*d;
+	float py = s->y[p] - dy*d;
 	float dlx = dy;
 	float dly = -dx;
 	nvg__vset(dst, px + dlx*w - dx*aa, py + dly*w - dy*aa, u0,0); dst++;
@@ -1637,12 +1698,12 @@ static NVGvertex* nvg__buttCapStart(NVGvertex* dst, NVGpoint* p,
 	return dst;
 }
 
-static NVGvertex* nvg__buttCapEnd(NVGvertex* dst, NVGpoint* p,
+static NVGvertex* nvg__buttCapEnd(NVGvertex* dst, const NVGpathSoA* s, int p,
 								  float dx, float dy, float w, float d,
 								  float aa, float u0, float u1)
 {
-	float px = p->x + dx*d;
-	float py = p->y + dy*d;
+	float px = s->x[p] + dx*d;
+	float py = s->y[p] + dy*d;
 	float dlx = dy;
 	float dly = -dx;
 	nvg__vset(dst, px + dlx*w, py + dly*w, u0,1); dst++;
@@ -1653,13 +1714,13 @@ static NVGvertex* nvg__buttCapEnd(NVGvertex* dst, NVGpoint* p,
 }
 
 
-static NVGvertex* nvg__roundCapStart(NVGvertex* dst, NVGpoint* p,
+static NVGvertex* nvg__roundCapStart(NVGvertex* dst, const NVGpathSoA* s, int p,
 									 float dx, float dy, float w, int ncap,
 									 float aa, float u0, float u1)
 {
 	int i;
-	float px = p->x;
-	float py = p->y;
+	float px = s->x[p];
+	float py = s->y[p];
 	float dlx = dy;
 	float dly = -dx;
 	NVG_NOTUSED(aa);
@@ -1674,13 +1735,13 @@ static NVGvertex* nvg__roundCapStart(NVGvertex* dst, NVGpoint* p,
 	return dst;
 }
 
-static NVGvertex* nvg__roundCapEnd(NVGvertex* dst, NVGpoint* p,
+static NVGvertex* nvg__roundCapEnd(NVGvertex* dst, const NVGpathSoA* s, int p,
 								   float dx, float dy, float w, int ncap,
 								   float aa, float u0, float u1)
 {
 	int i;
-	float px = p->x;
-	float py = p->y;
+	float px = s->x[p];
+	float py = s->y[p];
 	float dlx = dy;
 	float dly = -dx;
 	NVG_NOTUSED(aa);
@@ -1699,6 +1760,7 @@ static NVGvertex* nvg__roundCapEnd(NVGvertex* dst, NVGpoint* p,
 static void nvg__calculateJoins(NVGcontext* ctx, float w, int lineJoin, float miterLimit)
 {
 	NVGpathCache* cache = ctx->cache;
+	NVGpathSoA* soa = &cache->soa;
 	int i, j;
 	float iw = 0.0f;
 
@@ -1708,57 +1770,25 @@ static void nvg__calculateJoins(NVGcontext* ctx, float w, int lineJoin, float mi
 	for (i = 0; i < cache->npaths; i++) {
 		NVGpath* path = &cache->paths[i];
 		NVGpoint* pts = &cache->points[path->first];
-		NVGpoint* p0 = &pts[path->count-1];
-		NVGpoint* p1 = &pts[0];
+		unsigned char* flags = &soa->flags[path->first];
 		int nleft = 0;
 
 		path->nbevel = 0;
 
-		for (j = 0; j < path->count; j++) {
-			float dlx0, dly0, dlx1, dly1, dmr2, cross, limit;
-			dlx0 = p0->dy;
-			dly0 = -p0->dx;
-			dlx1 = p1->dy;
-			dly1 = -p1->dx;
-			// Calculate extrusions
-			p1->dmx = (dlx0 + dlx1) * 0.5f;
-			p1->dmy = (dly0 + dly1) * 0.5f;
-			dmr2 = p1->dmx*p1->dmx + p1->dmy*p1->dmy;
-			if (dmr2 > 0.000001f) {
-				float scale = 1.0f / dmr2;
-				if (scale > 600.0f) {
-					scale = 600.0f;
-				}
-				p1->dmx *= scale;
-				p1->dmy *= scale;
-			}
+		nvgPathJoins(&soa->dx[path->first], &soa->dy[path->first], &soa->len[path->first], path->count,
+					 iw, miterLimit, &soa->dmx[path->first], &soa->dmy[path->first], flags);
 
-			// Clear flags, but keep the corner.
-			p1->flags = (p1->flags & NVG_PT_CORNER) ? NVG_PT_CORNER : 0;
+		for (j = 0; j < path->count; j++) {
+			// Keep the corner, bevel only corners that exceed the miter limit or use bevel/round joins.
+			unsigned char f = (pts[j].flags & NVG_PT_CORNER) | (flags[j] & (NVG_PT_LEFT | NVG_PR_INNERBEVEL));
+			if ((f & NVG_PT_CORNER) && ((flags[j] & NVG_JOIN_BEVEL) || lineJoin == NVG_BEVEL || lineJoin == NVG_ROUND))
+				f |= NVG_PT_BEVEL;
+			flags[j] = f;
 
-			// Keep track of left turns.
-			cross = p1->dx * p0->dy - p0->dx * p1->dy;
-			if (cross > 0.0f) {
+			if (f & NVG_PT_LEFT)
 				nleft++;
-				p1->flags |= NVG_PT_LEFT;
-			}
-
-			// Calculate if we should use bevel or miter for inner join.
-			limit = nvg__maxf(1.01f, nvg__minf(p0->len, p1->len) * iw);
-			if ((dmr2 * limit*limit) < 1.0f)
-				p1->flags |= NVG_PR_INNERBEVEL;
-
-			// Check to see if the corner needs to be beveled.
-			if (p1->flags & NVG_PT_CORNER) {
-				if ((dmr2 * miterLimit*miterLimit) < 1.0f || lineJoin == NVG_BEVEL || lineJoin == NVG_ROUND) {
-					p1->flags |= NVG_PT_BEVEL;
-				}
-			}
-
-			if ((p1->flags & (NVG_PT_BEVEL | NVG_PR_INNERBEVEL)) != 0)
+			if ((f & (NVG_PT_BEVEL | NVG_PR_INNERBEVEL)) != 0)
 				path->nbevel++;
-
-			p0 = p1++;
 		}
 
 		path->convex = (nleft == path->count) ? 1 : 0;
@@ -1769,6 +1799,7 @@ static void nvg__calculateJoins(NVGcontext* ctx, float w, int lineJoin, float mi
 static int nvg__expandStroke(NVGcontext* ctx, float w, float fringe, int lineCap, int lineJoin, float miterLimit)
 {
 	NVGpathCache* cache = ctx->cache;
+	const NVGpathSoA* soa = &cache->soa;
 	NVGvertex* verts;
 	NVGvertex* dst;
 	int cverts, i, j;
@@ -1810,10 +1841,7 @@ static int nvg__expandStroke(NVGcontext* ctx, float w, float fringe, int lineCap
 
 	for (i = 0; i < cache->npaths; i++) {
 		NVGpath* path = &cache->paths[i];
-		NVGpoint* pts = &cache->points[path->first];
-		NVGpoint* p0;
-		NVGpoint* p1;
-		int s, e, loop;
+		int p0, p1, s, e, loop;
 		float dx, dy;
 
 		path->fill = 0;
@@ -1826,41 +1854,41 @@ static int nvg__expandStroke(NVGcontext* ctx, float w, float fringe, int lineCap
 
 		if (loop) {
 			// Looping
-			p0 = &pts[path->count-1];
-			p1 = &pts[0];
+			p0 = path->first + path->count-1;
+			p1 = path->first;
 			s = 0;
 			e = path->count;
 		} else {
 			// Add cap
-			p0 = &pts[0];
-			p1 = &pts[1];
+			p0 = path->first;
+			p1 = path->first + 1;
 			s = 1;
 			e = path->count-1;
 		}
 
 		if (loop == 0) {
 			// Add cap
-			dx = p1->x - p0->x;
-			dy = p1->y - p0->y;
+			dx = soa->x[p1] - soa->x[p0];
+			dy = soa->y[p1] - soa->y[p0];
 			nvg__normalize(&dx, &dy);
 			if (lineCap == NVG_BUTT)
-				dst = nvg__buttCapStart(dst, p0, dx, dy, w, -aa*0.5f, aa, u0, u1);
+				dst = nvg__buttCapStart(dst, soa, p0, dx, dy, w, -aa*0.5f, aa, u0, u1);
 			else if (lineCap == NVG_BUTT || lineCap == NVG_SQUARE)
-				dst = nvg__buttCapStart(dst, p0, dx, dy, w, w-aa, aa, u0, u1);
+				dst = nvg__buttCapStart(dst, soa, p0, dx, dy, w, w-aa, aa, u0, u1);
 			else if (lineCap == NVG_ROUND)
-				dst = nvg__roundCapStart(dst, p0, dx, dy, w, ncap, aa, u0, u1);
+				dst = nvg__roundCapStart(dst, soa, p0, dx, dy, w, ncap, aa, u0, u1);
 		}
 
 		for (j = s; j < e; ++j) {
-			if ((p1->flags & (NVG_PT_BEVEL | NVG_PR_INNERBEVEL)) != 0) {
+			if ((soa->flags[p1] & (NVG_PT_BEVEL | NVG_PR_INNERBEVEL)) != 0) {
 				if (lineJoin == NVG_ROUND) {
-					dst = nvg__roundJoin(dst, p0, p1, w, w, u0, u1, ncap, aa);
+					dst = nvg__roundJoin(dst, soa, p0, p1, w, w, u0, u1, ncap, aa);
 				} else {
-					dst = nvg__bevelJoin(dst, p0, p1, w, w, u0, u1, aa);
+					dst = nvg__bevelJoin(dst, soa, p0, p1, w, w, u0, u1, aa);
 				}
 			} else {
-				nvg__vset(dst, p1->x + (p1->dmx * w), p1->y + (p1->dmy * w), u0,1); dst++;
-				nvg__vset(dst, p1->x - (p1->dmx * w), p1->y - (p1->dmy * w), u1,1); dst++;
+				nvg__vset(dst, soa->x[p1] + (soa->dmx[p1] * w), soa->y[p1] + (soa->dmy[p1] * w), u0,1); dst++;
+				nvg__vset(dst, soa->x[p1] - (soa->dmx[p1] * w), soa->y[p1] - (soa->dmy[p1] * w), u1,1); dst++;
 			}
 			p0 = p1++;
 		}
@@ -1871,15 +1899,15 @@ static int nvg__expandStroke(NVGcontext* ctx, float w, float fringe, int lineCap
 			nvg__vset(dst, verts[1].x, verts[1].y, u1,1); dst++;
 		} else {
 			// Add cap
-			dx = p1->x - p0->x;
-			dy = p1->y - p0->y;
+			dx = soa->x[p1] - soa->x[p0];
+			dy = soa->y[p1] - soa->y[p0];
 			nvg__normalize(&dx, &dy);
 			if (lineCap == NVG_BUTT)
-				dst = nvg__buttCapEnd(dst, p1, dx, dy, w, -aa*0.5f, aa, u0, u1);
+				dst = nvg__buttCapEnd(dst, soa, p1, dx, dy, w, -aa*0.5f, aa, u0, u1);
 			else if (lineCap == NVG_BUTT || lineCap == NVG_SQUARE)
-				dst = nvg__buttCapEnd(dst, p1, dx, dy, w, w-aa, aa, u0, u1);
+				dst = nvg__buttCapEnd(dst, soa, p1, dx, dy, w, w-aa, aa, u0, u1);
 			else if (lineCap == NVG_ROUND)
-				dst = nvg__roundCapEnd(dst, p1, dx, dy, w, ncap, aa, u0, u1);
+				dst = nvg__roundCapEnd(dst, soa, p1, dx, dy, w, ncap, aa, u0, u1);
 		}
 
 		path->nstroke = (int)(dst - verts);
@@ -1893,6 +1921,7 @@ static int nvg__expandStroke(NVGcontext* ctx, float w, float fringe, int lineCap
 static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLimit)
 {
 	NVGpathCache* cache = ctx->cache;
+	const NVGpathSoA* soa = &cache->soa;
 	NVGvertex* verts;
 	NVGvertex* dst;
 	int cverts, convex, i, j;
@@ -1920,9 +1949,9 @@ static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLi
 
 	for (i = 0; i < cache->npaths; i++) {
 		NVGpath* path = &cache->paths[i];
-		NVGpoint* pts = &cache->points[path->first];
-		NVGpoint* p0;
-		NVGpoint* p1;
+		const float* px = &soa->x[path->first];
+		const float* py = &soa->y[path->first];
+		int p0, p1;
 		float rw, lw, woff;
 		float ru, lu;
 
@@ -1936,8 +1965,8 @@ static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLi
 			// Calculate center point for the shape
 			float cx = 0.0f, cy = 0.0f;
 			for (j = 0; j < path->count; ++j) {
-				cx += pts[j].x;
-				cy += pts[j].y;
+				cx += px[j];
+				cy += py[j];
 			}
 			cx /= (float)path->count;
 			cy /= (float)path->count;
@@ -1947,16 +1976,16 @@ static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLi
 				int j1 = (j + 1) % path->count;
 				// Triangle: center, current vertex, next vertex
 				nvg__vset(dst, cx, cy, 0.5f, 1); dst++;
-				nvg__vset(dst, pts[j].x, pts[j].y, 0.5f, 1); dst++;
-				nvg__vset(dst, pts[j1].x, pts[j1].y, 0.5f, 1); dst++;
+				nvg__vset(dst, px[j], py[j], 0.5f, 1); dst++;
+				nvg__vset(dst, px[j1], py[j1], 0.5f, 1); dst++;
 			}
 		} else {
 			// For Vulkan: Generate TRIANGLE_LIST geometry instead of TRIANGLE_FAN
 			// Calculate center point for the shape
 			float cx = 0.0f, cy = 0.0f;
 			for (j = 0; j < path->count; ++j) {
-				cx += pts[j].x;
-				cy += pts[j].y;
+				cx += px[j];
+				cy += py[j];
 			}
 			cx /= (float)path->count;
 			cy /= (float)path->count;
@@ -1966,8 +1995,8 @@ static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLi
 				int j1 = (j + 1) % path->count;
 				// Triangle: center, current vertex, next vertex
 				nvg__vset(dst, cx, cy, 0.5f, 1); dst++;
-				nvg__vset(dst, pts[j].x, pts[j].y, 0.5f, 1); dst++;
-				nvg__vset(dst, pts[j1].x, pts[j1].y, 0.5f, 1); dst++;
+				nvg__vset(dst, px[j], py[j], 0.5f, 1); dst++;
+				nvg__vset(dst, px[j1], py[j1], 0.5f, 1); dst++;
 			}
 		}
 
@@ -1991,15 +2020,15 @@ static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLi
 			}
 
 			// Looping
-			p0 = &pts[path->count-1];
-			p1 = &pts[0];
+			p0 = path->first + path->count-1;
+			p1 = path->first;
 
 			for (j = 0; j < path->count; ++j) {
-				if ((p1->flags & (NVG_PT_BEVEL | NVG_PR_INNERBEVEL)) != 0) {
-					dst = nvg__bevelJoin(dst, p0, p1, lw, rw, lu, ru, ctx->fringeWidth);
+				if ((soa->flags[p1] & (NVG_PT_BEVEL | NVG_PR_INNERBEVEL)) != 0) {
+					dst = nvg__bevelJoin(dst, soa, p0, p1, lw, rw, lu, ru, ctx->fringeWidth);
 				} else {
-					nvg__vset(dst, p1->x + (p1->dmx * lw), p1->y + (p1->dmy * lw), lu,1); dst++;
-					nvg__vset(dst, p1->x - (p1->dmx * rw), p1->y - (p1->dmy * rw), ru,1); dst++;
+					nvg__vset(dst, soa->x[p1] + (soa->dmx[p1] * lw), soa->y[p1] + (soa->dmy[p1] * lw), lu,1); dst++;
+					nvg__vset(dst, soa->x[p1] - (soa->dmx[p1] * rw), soa->y[p1] - (soa->dmy[p1] * rw), ru,1); dst++;
 				}
 				p0 = p1++;
 			}
@@ -2024,6 +2053,7 @@ static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLi
 void nvgBeginPath(NVGcontext* ctx)
 {
 	ctx->ncommands = 0;
+	ctx->shape.type = NVG_SHAPE_NONE;
 	nvg__clearPathCache(ctx);
 }
 
@@ -2194,8 +2224,27 @@ void nvgArc(NVGcontext* ctx, float cx, float cy, float r, float a0, float a1, in
 	nvg__appendCommands(ctx, vals, nvals);
 }
 
+// Records the shape just appended if it is the only sub-path of the current path.
+static void nvg__setShape(NVGcontext* ctx, int first, int type, float cx, float cy, float ex, float ey, float r)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGshape* shape = &ctx->shape;
+
+	if (first != 0 || ctx->ncommands == 0 || ex <= 0.0f || ey <= 0.0f)
+		return;
+
+	shape->type = type;
+	memcpy(shape->xform, state->xform, sizeof(float)*4);
+	nvgTransformPoint(&shape->xform[4], &shape->xform[5], state->xform, cx, cy);
+	shape->extent[0] = ex;
+	shape->extent[1] = ey;
+	shape->radius = r;
+	ctx->shapeCommands = ctx->ncommands;
+}
+
 void nvgRect(NVGcontext* ctx, float x, float y, float w, float h)
 {
+	int first = ctx->ncommands;
 	float vals[] = {
 		NVG_MOVETO, x,y,
 		NVG_LINETO, x,y+h,
@@ -2204,6 +2253,7 @@ void nvgRect(NVGcontext* ctx, float x, float y, float w, float h)
 		NVG_CLOSE
 	};
 	nvg__appendCommands(ctx, vals, NVG_COUNTOF(vals));
+	nvg__setShape(ctx, first, NVG_SHAPE_BOX, x + w*0.5f, y + h*0.5f, nvg__absf(w)*0.5f, nvg__absf(h)*0.5f, 0.0f);
 }
 
 void nvgRoundedRect(NVGcontext* ctx, float x, float y, float w, float h, float r)
@@ -2217,6 +2267,7 @@ void nvgRoundedRectVarying(NVGcontext* ctx, float x, float y, float w, float h,
 		nvgRect(ctx, x, y, w, h);
 		return;
 	} else {
+		int first = ctx->ncommands;
 		float halfw = nvg__absf(w)*0.5f;
 		float halfh = nvg__absf(h)*0.5f;
 		float rxBL = nvg__minf(radBottomLeft, halfw) * nvg__signf(w), ryBL = nvg__minf(radBottomLeft, halfh) * nvg__signf(h);
@@ -2236,11 +2287,17 @@ void nvgRoundedRectVarying(NVGcontext* ctx, float x, float y, float w, float h,
 			NVG_CLOSE
 		};
 		nvg__appendCommands(ctx, vals, NVG_COUNTOF(vals));
+
+		// Equal circular corners only, radii clamped on one axis become elliptical.
+		if (radTopLeft == radTopRight && radTopLeft == radBottomRight && radTopLeft == radBottomLeft &&
+			radTopLeft <= nvg__minf(halfw, halfh))
+			nvg__setShape(ctx, first, NVG_SHAPE_ROUNDBOX, x + w*0.5f, y + h*0.5f, halfw, halfh, radTopLeft);
 	}
 }
 
 void nvgEllipse(NVGcontext* ctx, float cx, float cy, float rx, float ry)
 {
+	int first = ctx->ncommands;
 	float vals[] = {
 		NVG_MOVETO, cx-rx, cy,
 		NVG_BEZIERTO, cx-rx, cy+ry*NVG_KAPPA90, cx-rx*NVG_KAPPA90, cy+ry, cx, cy+ry,
@@ -2250,6 +2307,7 @@ void nvgEllipse(NVGcontext* ctx, float cx, float cy, float rx, float ry)
 		NVG_CLOSE
 	};
 	nvg__appendCommands(ctx, vals, NVG_COUNTOF(vals));
+	nvg__setShape(ctx, first, NVG_SHAPE_ELLIPSE, cx, cy, nvg__absf(rx), nvg__absf(ry), 0.0f);
 }
 
 void nvgCircle(NVGcontext* ctx, float cx, float cy, float r)
@@ -2291,7 +2349,7 @@ int nvgGetAtlasTextureId(NVGcontext* ctx, int format)
 	if (vkFormat == NVG_TEXTURE_FORMAT_R8G8B8A8_UNORM) {
 		// Try with sRGB color space (COLR emojis)
 		textureId = nvgFontGetAtlasTexture(ctx->fs, NVG_COLOR_SPACE_SRGB_NONLINEAR,
-		                                    ctx->fs->targetColorSpace, vkFormat, subpixelMode);
+		                                    ctx->fs->targetColorSpace, vkFormat, subpixelMode, 0);
 		if (textureId != 0) return textureId;
 	}
 
@@ -2299,79 +2357,734 @@ int nvgGetAtlasTextureId(NVGcontext* ctx, int format)
 	NVGcolorSpace srcCS = (NVGcolorSpace)-1;
 	NVGcolorSpace dstCS = (NVGcolorSpace)-1;
 
-	return nvgFontGetAtlasTexture(ctx->fs, srcCS, dstCS, vkFormat, subpixelMode);
+	return nvgFontGetAtlasTexture(ctx->fs, srcCS, dstCS, vkFormat, subpixelMode, 0);
 }
 
-void nvgFill(NVGcontext* ctx)
+static void nvg__fillPaths(NVGcontext* ctx, const float* bounds, const NVGpath* paths, int npaths)
 {
 	NVGstate* state = nvg__getState(ctx);
-	const NVGpath* path;
 	NVGpaint fillPaint = state->fill;
 	int i;
 
-	nvg__flattenPaths(ctx);
-	if (ctx->params.edgeAntiAlias && state->shapeAntiAlias)
-		nvg__expandFill(ctx, ctx->fringeWidth, NVG_MITER, 2.4f);
-	else
-		nvg__expandFill(ctx, 0.0f, NVG_MITER, 2.4f);
-
 	// Apply global alpha
 	fillPaint.innerColor.a *= state->alpha;
 	fillPaint.outerColor.a *= state->alpha;
 
 	ctx->params.renderFill(ctx->params.userPtr, &fillPaint, state->compositeOperation, &state->scissor, ctx->fringeWidth,
-						   ctx->cache->bounds, ctx->cache->paths, ctx->cache->npaths);
+						   bounds, paths, npaths);
 
 	// Count triangles
-	for (i = 0; i < ctx->cache->npaths; i++) {
-		path = &ctx->cache->paths[i];
-		ctx->fillTriCount += path->nfill-2;
-		ctx->fillTriCount += path->nstroke-2;
+	for (i = 0; i < npaths; i++) {
+		ctx->fillTriCount += paths[i].nfill-2;
+		ctx->fillTriCount += paths[i].nstroke-2;
 		ctx->drawCallCount += 2;
 	}
 }
 
-void nvgStroke(NVGcontext* ctx)
+// Returns the device space stroke width and the paint to stroke with.
+static float nvg__strokeStyle(NVGcontext* ctx, NVGpaint* strokePaint)
 {
 	NVGstate* state = nvg__getState(ctx);
 	float scale = nvg__getAverageScale(state->xform);
 	float strokeWidth = nvg__clampf(state->strokeWidth * scale, 0.0f, 200.0f);
-	NVGpaint strokePaint = state->stroke;
-	const NVGpath* path;
-	int i;
-
 
+	*strokePaint = state->stroke;
 	if (strokeWidth < ctx->fringeWidth) {
 		// If the stroke width is less than pixel size, use alpha to emulate coverage.
 		// Since coverage is area, scale by alpha*alpha.
 		float alpha = nvg__clampf(strokeWidth / ctx->fringeWidth, 0.0f, 1.0f);
-		strokePaint.innerColor.a *= alpha*alpha;
-		strokePaint.outerColor.a *= alpha*alpha;
+		strokePaint->innerColor.a *= alpha*alpha;
+		strokePaint->outerColor.a *= alpha*alpha;
 		strokeWidth = ctx->fringeWidth;
 	}
 
 	// Apply global alpha
-	strokePaint.innerColor.a *= state->alpha;
-	strokePaint.outerColor.a *= state->alpha;
+	strokePaint->innerColor.a *= state->alpha;
+	strokePaint->outerColor.a *= state->alpha;
 
-	nvg__flattenPaths(ctx);
+	return strokeWidth;
+}
 
-	if (ctx->params.edgeAntiAlias && state->shapeAntiAlias)
-		nvg__expandStroke(ctx, strokeWidth*0.5f, ctx->fringeWidth, state->lineCap, state->lineJoin, state->miterLimit);
-	else
-		nvg__expandStroke(ctx, strokeWidth*0.5f, 0.0f, state->lineCap, state->lineJoin, state->miterLimit);
+static void nvg__strokePaths(NVGcontext* ctx, NVGpaint* strokePaint, float strokeWidth, const NVGpath* paths, int npaths)
+{
+	NVGstate* state = nvg__getState(ctx);
+	int i;
 
-	ctx->params.renderStroke(ctx->params.userPtr, &strokePaint, state->compositeOperation, &state->scissor, ctx->fringeWidth,
-							 strokeWidth, ctx->cache->paths, ctx->cache->npaths);
+	ctx->params.renderStroke(ctx->params.userPtr, strokePaint, state->compositeOperation, &state->scissor, ctx->fringeWidth,
+							 strokeWidth, paths, npaths);
 
 	// Count triangles
-	for (i = 0; i < ctx->cache->npaths; i++) {
-		path = &ctx->cache->paths[i];
-		ctx->strokeTriCount += path->nstroke-2;
+	for (i = 0; i < npaths; i++) {
+		ctx->strokeTriCount += paths[i].nstroke-2;
 		ctx->drawCallCount++;
 	}
 }
 
+// Analytic shapes
+
+// Returns 1 if t only rotates, mirrors and scales uniformly, the scale is stored in *scale.
+static int nvg__isConformal(const float* t, float* scale)
+{
+	float sx = sqrtf(t[0]*t[0] + t[1]*t[1]);
+	float sy = sqrtf(t[2]*t[2] + t[3]*t[3]);
+	float dot = t[0]*t[2] + t[1]*t[3];
+
+	if (sx < 1e-6f || nvg__absf(sx - sy) > 1e-4f*sx || nvg__absf(dot) > 1e-4f*sx*sy)
+		return 0;
+	*scale = sx;
+	return 1;
+}
+
+static const NVGshape* nvg__currentShape(NVGcontext* ctx)
+{
+	if (ctx->params.renderShape == NULL || ctx->shape.type == NVG_SHAPE_NONE || ctx->ncommands != ctx->shapeCommands)
+		return NULL;
+	return &ctx->shape;
+}
+
+// Fills the current path as a single analytic shape, returns 0 if it has to be tessellated.
+static int nvg__fillShape(NVGcontext* ctx, float fringe)
+{
+	NVGstate* state = nvg__getState(ctx);
+	const NVGshape* shape = nvg__currentShape(ctx);
+	NVGpaint fillPaint = state->fill;
+
+	if (shape == NULL)
+		return 0;
+
+	fillPaint.innerColor.a *= state->alpha;
+	fillPaint.outerColor.a *= state->alpha;
+
+	if (!ctx->params.renderShape(ctx->params.userPtr, &fillPaint, state->compositeOperation, &state->scissor, fringe,
+								 shape, 0.0f))
+		return 0;
+
+	ctx->fillTriCount += 2;
+	ctx->drawCallCount++;
+	return 1;
+}
+
+// Strokes the current path as a single analytic shape, returns 0 if it has to be tessellated.
+static int nvg__strokeShape(NVGcontext* ctx, NVGpaint* strokePaint, float strokeWidth, float fringe)
+{
+	NVGstate* state = nvg__getState(ctx);
+	const NVGshape* current = nvg__currentShape(ctx);
+	NVGshape shape;
+	float scale, width;
+
+	// The stroke keeps its width in every direction only without shear or non-uniform scale.
+	if (current == NULL || !nvg__isConformal(current->xform, &scale))
+		return 0;
+	shape = *current;
+	width = strokeWidth / scale;
+
+	if (shape.type == NVG_SHAPE_BOX) {
+		// Square outer corners are a miter join, rounded ones a round join. 90 degree
+		// corners are beveled once miterLimit drops below sqrt(2).
+		if (state->lineJoin == NVG_ROUND) {
+			shape.type = NVG_SHAPE_ROUNDBOX;
+			shape.radius = 0.0f;
+		} else if (state->lineJoin != NVG_MITER || state->miterLimit*state->miterLimit < 2.0f) {
+			return 0;
+		}
+	} else if (shape.type == NVG_SHAPE_ELLIPSE && shape.extent[0] != shape.extent[1]) {
+		// Ellipse distance is a first order estimate, only accurate close to the outline.
+		if (width > 0.2f * nvg__minf(shape.extent[0], shape.extent[1]))
+			return 0;
+	}
+
+	if (!ctx->params.renderShape(ctx->params.userPtr, strokePaint, state->compositeOperation, &state->scissor, fringe,
+								 &shape, width))
+		return 0;
+
+	ctx->strokeTriCount += 2;
+	ctx->drawCallCount++;
+	return 1;
+}
+
+// Retained paths
+
+// Parameters the cached geometry depends on. The transform enters only through
+// its scale/shear part, rotation and translation are applied when drawing.
+struct NVGtessKey {
+	float lin[4];
+	float tessTol;
+	float fringe;
+	float strokeWidth;
+	float miterLimit;
+	int lineCap;
+	int lineJoin;
+};
+typedef struct NVGtessKey NVGtessKey;
+
+struct NVGpathGeometry {
+	int valid;
+	NVGtessKey key;
+	NVGpath* paths;			// fill/stroke point into verts
+	NVGpath* drawPaths;		// Same paths placed in the current frame's vertices
+	int npaths;
+	int cpaths;
+	NVGvertex* verts;
+	int nverts;
+	int cverts;
+	float bounds[4];
+};
+typedef struct NVGpathGeometry NVGpathGeometry;
+
+struct NVGretainedPath {
+	float* commands;		// Local space
+	float* tessCommands;	// Scratch, commands in tessellation space
+	int ncommands;
+	NVGpathGeometry fill;
+	NVGpathGeometry stroke;
+};
+
+static void nvg__transformCommands(float* dst, const float* src, int n, const float* t)
+{
+	int i = 0;
+	memcpy(dst, src, sizeof(float)*n);
+	while (i < n) {
+		int cmd = (int)dst[i];
+		switch (cmd) {
+		case NVG_MOVETO:
+		case NVG_LINETO:
+			nvgTransformPoint(&dst[i+1],&dst[i+2], t, src[i+1],src[i+2]);
+			i += 3;
+			break;
+		case NVG_BEZIERTO:
+			nvgTransformPoint(&dst[i+1],&dst[i+2], t, src[i+1],src[i+2]);
+			nvgTransformPoint(&dst[i+3],&dst[i+4], t, src[i+3],src[i+4]);
+			nvgTransformPoint(&dst[i+5],&dst[i+6], t, src[i+5],src[i+6]);
+			i += 7;
+			break;
+		case NVG_WINDING:
+			i += 2;
+			break;
+		default:
+			i++;
+		}
+	}
+}
+
+// Splits t into rotation (cs,sn) and an upper triangular scale/shear part lin,
+// so that t = rotate(cs,sn) * lin + translate.
+static void nvg__splitTransform(const float* t, float* lin, float* cs, float* sn)
+{
+	float r = nvg__sqrtf(t[0]*t[0] + t[1]*t[1]);
+	if (r < 1e-6f) {
+		*cs = 1.0f;
+		*sn = 0.0f;
+		lin[0] = t[0]; lin[1] = t[1];
+		lin[2] = t[2]; lin[3] = t[3];
+		return;
+	}
+	*cs = t[0] / r;
+	*sn = t[1] / r;
+	lin[0] = r;
+	lin[1] = 0.0f;
+	lin[2] = *cs * t[2] + *sn * t[3];
+	lin[3] = *cs * t[3] - *sn * t[2];
+}
+
+static int nvg__tessKeyEquals(const NVGtessKey* a, const NVGtessKey* b)
+{
+	int i;
+	for (i = 0; i < 4; i++) {
+		if (nvg__absf(a->lin[i] - b->lin[i]) > 1e-4f * nvg__maxf(1.0f, nvg__absf(b->lin[i])))
+			return 0;
+	}
+	return a->tessTol == b->tessTol && a->fringe == b->fringe && a->strokeWidth == b->strokeWidth &&
+		   a->miterLimit == b->miterLimit && a->lineCap == b->lineCap && a->lineJoin == b->lineJoin;
+}
+
+static void nvg__freePathGeometry(NVGpathGeometry* geom)
+{
+	free(geom->paths);
+	free(geom->drawPaths);
+	free(geom->verts);
+}
+
+// Copies the path cache output into geom.
+static int nvg__storePathGeometry(NVGpathGeometry* geom, NVGpathCache* cache)
+{
+	NVGvertex* dst;
+	int i, nverts = 0;
+
+	for (i = 0; i < cache->npaths; i++)
+		nverts += cache->paths[i].nfill + cache->paths[i].nstroke;
+
+	if (cache->npaths > geom->cpaths) {
+		NVGpath* paths = (NVGpath*)realloc(geom->paths, sizeof(NVGpath)*cache->npaths);
+		NVGpath* drawPaths;
+		if (paths == NULL) return 0;
+		geom->paths = paths;
+		drawPaths = (NVGpath*)realloc(geom->drawPaths, sizeof(NVGpath)*cache->npaths);
+		if (drawPaths == NULL) return 0;
+		geom->drawPaths = drawPaths;
+		geom->cpaths = cache->npaths;
+	}
+	if (nverts > geom->cverts) {
+		NVGvertex* verts = (NVGvertex*)realloc(geom->verts, sizeof(NVGvertex)*nverts);
+		if (verts == NULL) return 0;
+		geom->verts = verts;
+		geom->cverts = nverts;
+	}
+
+	dst = geom->verts;
+	for (i = 0; i < cache->npaths; i++) {
+		NVGpath* path = &geom->paths[i];
+		*path = cache->paths[i];
+		if (path->nfill > 0) memcpy(dst, path->fill, sizeof(NVGvertex)*path->nfill);
+		path->fill = dst;
+		dst += path->nfill;
+		if (path->nstroke > 0) memcpy(dst, path->stroke, sizeof(NVGvertex)*path->nstroke);
+		path->stroke = dst;
+		dst += path->nstroke;
+	}
+	geom->npaths = cache->npaths;
+	geom->nverts = nverts;
+	memcpy(geom->bounds, cache->bounds, sizeof(geom->bounds));
+	return 1;
+}
+
+// Flattens and expands the retained commands in tessellation space, using the path cache as scratch.
+static int nvg__buildPathGeometry(NVGcontext* ctx, NVGretainedPath* path, NVGpathGeometry* geom, const NVGtessKey* key, int stroke)
+{
+	float* commands = ctx->commands;
+	int ncommands = ctx->ncommands;
+	float t[6];
+	int res;
+
+	t[0] = key->lin[0]; t[1] = key->lin[1];
+	t[2] = key->lin[2]; t[3] = key->lin[3];
+	t[4] = 0.0f; t[5] = 0.0f;
+	nvg__transformCommands(path->tessCommands, path->commands, path->ncommands, t);
+
+	ctx->commands = path->tessCommands;
+	ctx->ncommands = path->ncommands;
+	nvg__clearPathCache(ctx);
+	nvg__flattenPaths(ctx);
+	ctx->cpuVerts = 1;
+	if (stroke)
+		res = nvg__expandStroke(ctx, key->strokeWidth*0.5f, key->fringe, key->lineCap, key->lineJoin, key->miterLimit);
+	else
+		res = nvg__expandFill(ctx, key->fringe, NVG_MITER, 2.4f);
+	ctx->cpuVerts = 0;
+	if (res)
+		res = nvg__storePathGeometry(geom, ctx->cache);
+
+	// The current path is flattened again on its next use.
+	ctx->commands = commands;
+	ctx->ncommands = ncommands;
+	nvg__clearPathCache(ctx);
+
+	geom->valid = res;
+	geom->key = *key;
+	return res;
+}
+
+// Copies the cached vertices into this frame's vertex memory, rotated by
+// rot[0..1] (cos, sin) and translated by rot[2..3]. Copies them unchanged when rot is NULL.
+static int nvg__placePathGeometry(NVGcontext* ctx, NVGpathGeometry* geom, const float* rot, float* bounds)
+{
+	NVGvertex* verts = nvg__allocTempVerts(ctx, geom->nverts);
+	float cx[4], cy[4];
+	int i;
+
+	if (verts == NULL) return 0;
+
+	for (i = 0; i < geom->npaths; i++) {
+		NVGpath* path = &geom->drawPaths[i];
+		*path = geom->paths[i];
+		path->fill = verts + (geom->paths[i].fill - geom->verts);
+		path->stroke = verts + (geom->paths[i].stroke - geom->verts);
+	}
+
+	if (rot == NULL) {
+		memcpy(verts, geom->verts, sizeof(NVGvertex)*geom->nverts);
+		memcpy(bounds, geom->bounds, sizeof(geom->bounds));
+		return 1;
+	}
+
+	for (i = 0; i < geom->nverts; i++) {
+		const NVGvertex* src = &geom->verts[i];
+		nvg__vset(&verts[i], rot[0]*src->x - rot[1]*src->y + rot[2], rot[1]*src->x + rot[0]*src->y + rot[3], src->u, src->v);
+	}
+
+	cx[0] = geom->bounds[0]; cy[0] = geom->bounds[1];
+	cx[1] = geom->bounds[2]; cy[1] = geom->bounds[1];
+	cx[2] = geom->bounds[2]; cy[2] = geom->bounds[3];
+	cx[3] = geom->bounds[0]; cy[3] = geom->bounds[3];
+	bounds[0] = bounds[1] = 1e6f;
+	bounds[2] = bounds[3] = -1e6f;
+	for (i = 0; i < 4; i++) {
+		float x = rot[0]*cx[i] - rot[1]*cy[i] + rot[2];
+		float y = rot[1]*cx[i] + rot[0]*cy[i] + rot[3];
+		bounds[0] = nvg__minf(bounds[0], x);
+		bounds[1] = nvg__minf(bounds[1], y);
+		bounds[2] = nvg__maxf(bounds[2], x);
+		bounds[3] = nvg__maxf(bounds[3], y);
+	}
+	return 1;
+}
+
+NVGretainedPath* nvgCreatePath(NVGcontext* ctx)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGretainedPath* path;
+	float inv[6];
+
+	// Commands are stored transformed, map them back to local space.
+	if (!nvgTransformInverse(inv, state->xform)) return NULL;
+
+	path = (NVGretainedPath*)malloc(sizeof(NVGretainedPath));
+	if (path == NULL) return NULL;
+	memset(path, 0, sizeof(NVGretainedPath));
+
+	path->commands = (float*)malloc(sizeof(float)*nvg__maxi(ctx->ncommands, 1));
+	path->tessCommands = (float*)malloc(sizeof(float)*nvg__maxi(ctx->ncommands, 1));
+	if (path->commands == NULL || path->tessCommands == NULL) {
+		nvgDeletePath(ctx, path);
+		return NULL;
+	}
+	nvg__transformCommands(path->commands, ctx->commands, ctx->ncommands, inv);
+	path->ncommands = ctx->ncommands;
+
+	return path;
+}
+
+void nvgDrawPath(NVGcontext* ctx, NVGretainedPath* path, int flags)
+{
+	NVGstate* state = nvg__getState(ctx);
+	float fringe = (ctx->params.edgeAntiAlias && state->shapeAntiAlias) ? ctx->fringeWidth : 0.0f;
+	float rot[4], bounds[4];
+	NVGtessKey key;
+
+	if (path == NULL || path->ncommands == 0) return;
+
+	memset(&key, 0, sizeof(key));
+	nvg__splitTransform(state->xform, key.lin, &rot[0], &rot[1]);
+	rot[2] = state->xform[4];
+	rot[3] = state->xform[5];
+	key.tessTol = ctx->tessTol;
+	key.fringe = fringe;
+
+	if (flags & NVG_PATH_FILL) {
+		if (!path->fill.valid || !nvg__tessKeyEquals(&path->fill.key, &key))
+			nvg__buildPathGeometry(ctx, path, &path->fill, &key, 0);
+		if (path->fill.valid && nvg__placePathGeometry(ctx, &path->fill, rot, bounds))
+			nvg__fillPaths(ctx, bounds, path->fill.drawPaths, path->fill.npaths);
+	}
+
+	if (flags & NVG_PATH_STROKE) {
+		NVGpaint strokePaint;
+		key.strokeWidth = nvg__strokeStyle(ctx, &strokePaint);
+		key.miterLimit = state->miterLimit;
+		key.lineCap = state->lineCap;
+		key.lineJoin = state->lineJoin;
+		if (!path->stroke.valid || !nvg__tessKeyEquals(&path->stroke.key, &key))
+			nvg__buildPathGeometry(ctx, path, &path->stroke, &key, 1);
+		if (path->stroke.valid && nvg__placePathGeometry(ctx, &path->stroke, rot, bounds))
+			nvg__strokePaths(ctx, &strokePaint, key.strokeWidth, path->stroke.drawPaths, path->stroke.npaths);
+	}
+}
+
+void nvgDeletePath(NVGcontext* ctx, NVGretainedPath* path)
+{
+	NVG_NOTUSED(ctx);
+	if (path == NULL) return;
+	free(path->commands);
+	free(path->tessCommands);
+	nvg__freePathGeometry(&path->fill);
+	nvg__freePathGeometry(&path->stroke);
+	free(path);
+}
+
+// Geometry cache
+//
+// Memoizes the tessellation of immediate mode paths. Entries are keyed by the
+// (already transformed) command buffer and the tessellation parameters, fill
+// keys have zero stroke width.
+
+struct NVGgeometryEntry {
+	unsigned int hash;
+	NVGtessKey key;
+	float* commands;
+	int ncommands;
+	int ccommands;
+	NVGpathGeometry geom;
+	// Hash bucket chain and intrusive LRU list (entry indices, -1 = none)
+	int bucketNext;
+	int lruPrev;
+	int lruNext;
+};
+typedef struct NVGgeometryEntry NVGgeometryEntry;
+
+struct NVGgeometryCache {
+	NVGgeometryEntry entries[NVG_GEOMETRY_CACHE_SIZE];
+	int buckets[NVG_GEOMETRY_CACHE_BUCKETS];
+	int count;
+	int lruHead;	// Most recently used
+	int lruTail;	// Least recently used, next victim
+	int hits;
+	int misses;
+};
+typedef struct NVGgeometryCache NVGgeometryCache;
+
+static NVGgeometryCache* nvg__createGeometryCache(void)
+{
+	NVGgeometryCache* cache = (NVGgeometryCache*)malloc(sizeof(NVGgeometryCache));
+	int i;
+	if (cache == NULL) return NULL;
+	memset(cache, 0, sizeof(NVGgeometryCache));
+	for (i = 0; i < NVG_GEOMETRY_CACHE_BUCKETS; i++)
+		cache->buckets[i] = -1;
+	cache->lruHead = -1;
+	cache->lruTail = -1;
+	return cache;
+}
+
+static void nvg__deleteGeometryCache(NVGgeometryCache* cache)
+{
+	int i;
+	if (cache == NULL) return;
+	for (i = 0; i < cache->count; i++) {
+		free(cache->entries[i].commands);
+		nvg__freePathGeometry(&cache->entries[i].geom);
+	}
+	free(cache);
+}
+
+// FNV-1a over the command words and the key.
+static unsigned int nvg__geometryHash(const float* commands, int ncommands, const NVGtessKey* key)
+{
+	unsigned int hash = 2166136261u;
+	unsigned int w;
+	int i;
+	for (i = 0; i < ncommands; i++) {
+		memcpy(&w, &commands[i], sizeof(w));
+		hash ^= w;
+		hash *= 16777619u;
+	}
+	for (i = 0; i < (int)(sizeof(NVGtessKey)/sizeof(w)); i++) {
+		memcpy(&w, (const unsigned char*)key + i*sizeof(w), sizeof(w));
+		hash ^= w;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static void nvg__geometryLruUnlink(NVGgeometryCache* cache, int idx)
+{
+	NVGgeometryEntry* entry = &cache->entries[idx];
+	if (entry->lruPrev != -1)
+		cache->entries[entry->lruPrev].lruNext = entry->lruNext;
+	else
+		cache->lruHead = entry->lruNext;
+	if (entry->lruNext != -1)
+		cache->entries[entry->lruNext].lruPrev = entry->lruPrev;
+	else
+		cache->lruTail = entry->lruPrev;
+	entry->lruPrev = -1;
+	entry->lruNext = -1;
+}
+
+static void nvg__geometryLruPushFront(NVGgeometryCache* cache, int idx)
+{
+	NVGgeometryEntry* entry = &cache->entries[idx];
+	entry->lruPrev = -1;
+	entry->lruNext = cache->lruHead;
+	if (cache->lruHead != -1)
+		cache->entries[cache->lruHead].lruPrev = idx;
+	else
+		cache->lruTail = idx;
+	cache->lruHead = idx;
+}
+
+static NVGgeometryEntry* nvg__geometryCacheLookup(NVGgeometryCache* cache, const float* commands, int ncommands,
+												  const NVGtessKey* key, unsigned int hash)
+{
+	int idx = cache->buckets[hash & (NVG_GEOMETRY_CACHE_BUCKETS - 1)];
+	while (idx != -1) {
+		NVGgeometryEntry* entry = &cache->entries[idx];
+		if (entry->hash == hash && entry->ncommands == ncommands &&
+			memcmp(&entry->key, key, sizeof(NVGtessKey)) == 0 &&
+			memcmp(entry->commands, commands, sizeof(float)*ncommands) == 0) {
+			if (cache->lruHead != idx) {
+				nvg__geometryLruUnlink(cache, idx);
+				nvg__geometryLruPushFront(cache, idx);
+			}
+			cache->hits++;
+			return entry;
+		}
+		idx = entry->bucketNext;
+	}
+	cache->misses++;
+	return NULL;
+}
+
+// Stores the tessellation held by the path cache. Evicted entries keep their
+// allocations for reuse. Returns NULL if the entry could not be allocated.
+static NVGgeometryEntry* nvg__geometryCacheInsert(NVGgeometryCache* cache, const float* commands, int ncommands,
+									 const NVGtessKey* key, unsigned int hash, NVGpathCache* paths)
+{
+	NVGgeometryEntry* entry;
+	size_t bytes = sizeof(float)*ncommands + sizeof(NVGpath)*2*paths->npaths;
+	int* link;
+	int i, idx;
+
+	// Entries keep their allocations when evicted, so one dense path must not pin an unbounded block.
+	for (i = 0; i < paths->npaths; i++)
+		bytes += sizeof(NVGvertex)*(paths->paths[i].nfill + paths->paths[i].nstroke);
+	if (bytes > NVG_GEOMETRY_CACHE_ENTRY_BYTES) return NULL;
+
+	if (cache->count < NVG_GEOMETRY_CACHE_SIZE) {
+		idx = cache->count++;
+		entry = &cache->entries[idx];
+		entry->lruPrev = entry->lruNext = -1;
+	} else {
+		idx = cache->lruTail;
+		entry = &cache->entries[idx];
+		link = &cache->buckets[entry->hash & (NVG_GEOMETRY_CACHE_BUCKETS - 1)];
+		while (*link != idx)
+			link = &cache->entries[*link].bucketNext;
+		*link = entry->bucketNext;
+		nvg__geometryLruUnlink(cache, idx);
+	}
+
+	if (ncommands > entry->ccommands) {
+		float* buf = (float*)realloc(entry->commands, sizeof(float)*ncommands);
+		if (buf == NULL) goto error;
+		entry->commands = buf;
+		entry->ccommands = ncommands;
+	}
+	if (!nvg__storePathGeometry(&entry->geom, paths)) goto error;
+	memcpy(entry->commands, commands, sizeof(float)*ncommands);
+	entry->ncommands = ncommands;
+	entry->key = *key;
+	entry->hash = hash;
+
+	link = &cache->buckets[hash & (NVG_GEOMETRY_CACHE_BUCKETS - 1)];
+	entry->bucketNext = *link;
+	*link = idx;
+	nvg__geometryLruPushFront(cache, idx);
+	return entry;
+
+error:
+	// Park the slot as a never matching entry at the LRU tail so it is reused first.
+	entry->ncommands = -1;
+	entry->hash = 0;
+	entry->bucketNext = cache->buckets[0];
+	cache->buckets[0] = idx;
+	entry->lruPrev = cache->lruTail;
+	entry->lruNext = -1;
+	if (cache->lruTail != -1)
+		cache->entries[cache->lruTail].lruNext = idx;
+	else
+		cache->lruHead = idx;
+	cache->lruTail = idx;
+	return NULL;
+}
+
+void nvgGetGeometryCacheStats(NVGcontext* ctx, NVGgeometryCacheStats* stats)
+{
+	memset(stats, 0, sizeof(*stats));
+	if (ctx->geomCache == NULL) return;
+	stats->hits = ctx->geomCache->hits;
+	stats->misses = ctx->geomCache->misses;
+	stats->entries = ctx->geomCache->count;
+}
+
+void nvgFill(NVGcontext* ctx)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGgeometryEntry* entry = NULL;
+	NVGtessKey key;
+	unsigned int hash = 0;
+	int memo = ctx->geomCache != NULL && ctx->ncommands > 0;
+	int res;
+	float bounds[4];
+
+	memset(&key, 0, sizeof(key));
+	key.tessTol = ctx->tessTol;
+	key.fringe = (ctx->params.edgeAntiAlias && state->shapeAntiAlias) ? ctx->fringeWidth : 0.0f;
+
+	if (nvg__fillShape(ctx, key.fringe))
+		return;
+
+	if (memo) {
+		hash = nvg__geometryHash(ctx->commands, ctx->ncommands, &key);
+		entry = nvg__geometryCacheLookup(ctx->geomCache, ctx->commands, ctx->ncommands, &key, hash);
+		if (entry != NULL) {
+			if (nvg__placePathGeometry(ctx, &entry->geom, NULL, bounds))
+				nvg__fillPaths(ctx, bounds, entry->geom.drawPaths, entry->geom.npaths);
+			return;
+		}
+	}
+
+	// A miss is expanded in CPU memory and drawn from the new entry like a hit,
+	// so the mapped vertex memory is only written, never read back.
+	nvg__flattenPaths(ctx);
+	ctx->cpuVerts = memo;
+	res = nvg__expandFill(ctx, key.fringe, NVG_MITER, 2.4f);
+	ctx->cpuVerts = 0;
+	if (!res) return;
+
+	if (memo)
+		entry = nvg__geometryCacheInsert(ctx->geomCache, ctx->commands, ctx->ncommands, &key, hash, ctx->cache);
+	if (entry != NULL && nvg__placePathGeometry(ctx, &entry->geom, NULL, bounds))
+		nvg__fillPaths(ctx, bounds, entry->geom.drawPaths, entry->geom.npaths);
+	else
+		nvg__fillPaths(ctx, ctx->cache->bounds, ctx->cache->paths, ctx->cache->npaths);
+}
+
+void nvgStroke(NVGcontext* ctx)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGgeometryEntry* entry = NULL;
+	NVGpaint strokePaint;
+	NVGtessKey key;
+	unsigned int hash = 0;
+	int memo = ctx->geomCache != NULL && ctx->ncommands > 0;
+	int res;
+	float bounds[4];
+
+	memset(&key, 0, sizeof(key));
+	key.tessTol = ctx->tessTol;
+	key.fringe = (ctx->params.edgeAntiAlias && state->shapeAntiAlias) ? ctx->fringeWidth : 0.0f;
+	key.strokeWidth = nvg__strokeStyle(ctx, &strokePaint);
+	key.miterLimit = state->miterLimit;
+	key.lineCap = state->lineCap;
+	key.lineJoin = state->lineJoin;
+
+	if (nvg__strokeShape(ctx, &strokePaint, key.strokeWidth, key.fringe))
+		return;
+
+	if (memo) {
+		hash = nvg__geometryHash(ctx->commands, ctx->ncommands, &key);
+		entry = nvg__geometryCacheLookup(ctx->geomCache, ctx->commands, ctx->ncommands, &key, hash);
+		if (entry != NULL) {
+			if (nvg__placePathGeometry(ctx, &entry->geom, NULL, bounds))
+				nvg__strokePaths(ctx, &strokePaint, key.strokeWidth, entry->geom.drawPaths, entry->geom.npaths);
+			return;
+		}
+	}
+
+	nvg__flattenPaths(ctx);
+	ctx->cpuVerts = memo;
+	res = nvg__expandStroke(ctx, key.strokeWidth*0.5f, key.fringe, key.lineCap, key.lineJoin, key.miterLimit);
+	ctx->cpuVerts = 0;
+	if (!res) return;
+
+	if (memo)
+		entry = nvg__geometryCacheInsert(ctx->geomCache, ctx->commands, ctx->ncommands, &key, hash, ctx->cache);
+	if (entry != NULL && nvg__placePathGeometry(ctx, &entry->geom, NULL, bounds))
+		nvg__strokePaths(ctx, &strokePaint, key.strokeWidth, entry->geom.drawPaths, entry->geom.npaths);
+	else
+		nvg__strokePaths(ctx, &strokePaint, key.strokeWidth, ctx->cache->paths, ctx->cache->npaths);
+}
+
+
 // Add fonts
 int nvgCreateFont(NVGcontext* ctx, const char* name, const char* filename)
 {
@@ -2494,20 +3207,20 @@ static float nvg__getFontScale(NVGstate* state)
 }
 
 // Texture upload callback for nvg_freetype
-static void nvg__textureUpdate(void* uptr, int x, int y, int w, int h, const unsigned char* data, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode)
+static void nvg__textureUpdate(void* uptr, int x, int y, int w, int h, const unsigned char* data, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page)
 {
 	NVGcontext* ctx = (NVGcontext*)uptr;
 
-	// Get texture ID for this atlas
-	int textureId = nvgFontGetAtlasTexture(ctx->fs, srcColorSpace, dstColorSpace, format, subpixelMode);
+	// Get texture ID for this atlas page
+	int textureId = nvgFontGetAtlasTexture(ctx->fs, srcColorSpace, dstColorSpace, format, subpixelMode, page);
 
 	// If texture doesn't exist yet, create it
 	if (textureId == 0) {
 		int atlasWidth = 0, atlasHeight = 0;
-		nvgAtlasGetSize(ctx->fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, &atlasWidth, &atlasHeight);
+		nvgAtlasGetSize(ctx->fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode, page, &atlasWidth, &atlasHeight);
 
-		printf("[nvg__textureUpdate] Creating texture for atlas: src=%u dst=%u format=%u subpixel=%d size=%dx%d\n",
-		       srcColorSpace, dstColorSpace, format, subpixelMode, atlasWidth, atlasHeight);
+		printf("[nvg__textureUpdate] Creating texture for atlas: src=%u dst=%u format=%u subpixel=%d page=%d size=%dx%d\n",
+		       srcColorSpace, dstColorSpace, format, subpixelMode, page, atlasWidth, atlasHeight);
 
 		if (atlasWidth == 0 || atlasHeight == 0) {
 			printf("[nvg__textureUpdate] ERROR: Atlas has invalid size!\n");
@@ -2532,7 +3245,7 @@ static void nvg__textureUpdate(void* uptr, int x, int y, int w, int h, const uns
 		printf("[nvg__textureUpdate] Created texture ID %d\n", textureId);
 
 		// Store texture ID in atlas
-		nvgFontSetAtlasTexture(ctx->fs, srcColorSpace, dstColorSpace, format, subpixelMode, textureId);
+		nvgFontSetAtlasTexture(ctx->fs, srcColorSpace, dstColorSpace, format, subpixelMode, page, textureId);
 	}
 
 	if (textureId != 0) {
@@ -2572,136 +3285,13 @@ static int nvg__allocTextAtlas(NVGcontext* ctx)
 	return 1;
 }
 
-// Atlas growth callback for font system
-static int nvg__atlasGrow(void* uptr, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int* newWidth, int* newHeight)
-{
-	NVGcontext* ctx = (NVGcontext*)uptr;
-	int iw, ih;
-
-	printf("[nvg__atlasGrow] Starting atlas grow: srcCS=%u dstCS=%u fmt=%d subpixel=%d\n",
-	       srcColorSpace, dstColorSpace, format, subpixelMode);
-
-	nvg__flushTextTexture(ctx);
-
-	// Get current atlas texture
-	int currentTextureId = nvgFontGetAtlasTexture(ctx->fs, srcColorSpace, dstColorSpace, format, subpixelMode);
-	if (currentTextureId == 0) {
-		// No texture yet, should not happen
-		printf("[nvg__atlasGrow] ERROR: No current texture ID\n");
-		return 0;
-	}
-
-	// Get current size and calculate new size
-	nvgImageSize(ctx, currentTextureId, &iw, &ih);
-	int oldWidth = iw, oldHeight = ih;
-	if (iw > ih)
-		ih *= 2;
-	else
-		iw *= 2;
-	if (iw > NVG_MAX_FONTIMAGE_SIZE || ih > NVG_MAX_FONTIMAGE_SIZE)
-		iw = ih = NVG_MAX_FONTIMAGE_SIZE;
-
-	printf("[nvg__atlasGrow] Growing from %dx%d to %dx%d\n", oldWidth, oldHeight, iw, ih);
-
-	// Dump atlas BEFORE growth
-	char beforeFilename[256];
-	const char* formatName = (format == NVG_TEXTURE_FORMAT_R8G8B8A8_UNORM) ? "rgba" : "alpha";
-	snprintf(beforeFilename, sizeof(beforeFilename), "screendumps/atlas_%s_before_%dx%d.ppm", formatName, oldWidth, oldHeight);
-	nvgVkDumpAtlasTextureByIndex(ctx, currentTextureId - 1, beforeFilename);
-	printf("[nvg__atlasGrow] Dumped BEFORE: %s\n", beforeFilename);
-
-	// Create new larger texture
-	int texType = (format == NVG_TEXTURE_FORMAT_R8G8B8A8_UNORM) ? NVG_TEXTURE_RGBA : NVG_TEXTURE_ALPHA;
-	int newTextureId = ctx->params.renderCreateTexture(ctx->params.userPtr, texType, iw, ih, 0, NULL);
-	if (newTextureId == 0) {
-		printf("[nvg__atlasGrow] ERROR: Failed to create new texture\n");
-		return 0;
-	}
-	printf("[nvg__atlasGrow] Created new texture ID %d\n", newTextureId);
-
-	// Copy old texture data to new texture (preserve existing glyphs)
-	if (ctx->params.renderCopyTexture) {
-		printf("[nvg__atlasGrow] Copying old texture %d to new texture %d (%dx%d)\n",
-		       currentTextureId, newTextureId, oldWidth, oldHeight);
-		ctx->params.renderCopyTexture(ctx->params.userPtr, currentTextureId, newTextureId,
-		                               0, 0, 0, 0, oldWidth, oldHeight);
-	} else {
-		printf("[nvg__atlasGrow] WARNING: No renderCopyTexture function available!\n");
-	}
-
-	// NOTE: Don't delete old texture immediately - it may still be referenced by pending draw calls
-	// The old texture will be leaked, but this prevents rendering corruption
-	// TODO: Implement proper texture lifecycle management to delete old textures after frame completes
-	// nvgDeleteImage(ctx, currentTextureId);
-	printf("[nvg__atlasGrow] Old texture %d NOT deleted (may be referenced by pending draws)\n", currentTextureId);
-
-	// Store new texture ID in atlas
-	nvgFontSetAtlasTexture(ctx->fs, srcColorSpace, dstColorSpace, format, subpixelMode, newTextureId);
-
-	// Update atlas dimensions
-	NVGAtlas* atlas = nvg__getAtlas(ctx->fs->atlasManager, srcColorSpace, dstColorSpace, format, subpixelMode);
-	if (atlas) {
-		printf("[nvg__atlasGrow] Updating atlas dimensions from %dx%d to %dx%d (preserving %d nodes)\n",
-		       atlas->width, atlas->height, iw, ih, atlas->nnodes);
-		atlas->width = iw;
-		atlas->height = ih;
-	}
-
-	// Scale cached texture coordinates to account for new atlas size
-	// Old texture at (0,0) in new texture, so coords scale by (oldWidth/newWidth, oldHeight/newHeight)
-	// ONLY scale glyphs that belong to THIS atlas (matching srcCS, dstCS, format, subpixel)
-	if (ctx->fs->glyphCache) {
-		float scaleX = (float)oldWidth / (float)iw;
-		float scaleY = (float)oldHeight / (float)ih;
-		int scaledCount = 0;
-
-		for (int i = 0; i < ctx->fs->glyphCache->count; i++) {
-			NVGGlyphCacheEntry* entry = &ctx->fs->glyphCache->entries[i];
-			if (entry->valid &&
-			    entry->srcColorSpace == srcColorSpace &&
-			    entry->dstColorSpace == dstColorSpace &&
-			    entry->format == format &&
-			    entry->subpixelMode == subpixelMode) {
-				entry->s0 *= scaleX;
-				entry->s1 *= scaleX;
-				entry->t0 *= scaleY;
-				entry->t1 *= scaleY;
-				scaledCount++;
-			}
-		}
-
-		printf("[nvg__atlasGrow] Scaled %d cached glyph texture coords by (%.3f, %.3f) for this atlas\n",
-		       scaledCount, scaleX, scaleY);
-	}
-
-	// Dump atlas AFTER growth
-	char afterFilename[256];
-	snprintf(afterFilename, sizeof(afterFilename), "screendumps/atlas_%s_after_%dx%d.ppm", formatName, iw, ih);
-	nvgVkDumpAtlasTextureByIndex(ctx, newTextureId - 1, afterFilename);
-	printf("[nvg__atlasGrow] Dumped AFTER: %s\n", afterFilename);
-
-	if (newWidth) *newWidth = iw;
-	if (newHeight) *newHeight = ih;
-
-	printf("[nvg__atlasGrow] Atlas grow completed successfully\n");
-	return 1;
-}
-
-static void nvg__renderText(NVGcontext* ctx, NVGvertex* verts, int nverts, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode)
+static NVGpaint nvg__textPaint(NVGcontext* ctx, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page)
 {
 	NVGstate* state = nvg__getState(ctx);
 	NVGpaint paint = state->fill;
 
-	// Look up texture for this atlas
-	int textureId = nvgFontGetAtlasTexture(ctx->fs, srcColorSpace, dstColorSpace, format, subpixelMode);
-	paint.image = textureId;
-
-	static int render_call_count = 0;
-	render_call_count++;
-	if (render_call_count <= 10 || textureId == 0) {
-		printf("[nvg__renderText #%d] nverts=%d, src=%u dst=%u fmt=%u subpixel=%d, textureId=%d\n",
-		       render_call_count, nverts, srcColorSpace, dstColorSpace, format, subpixelMode, textureId);
-	}
+	// Look up texture for this atlas page
+	paint.image = nvgFontGetAtlasTexture(ctx->fs, srcColorSpace, dstColorSpace, format, subpixelMode, page);
 
 	// For COLR emoji (valid srcColorSpace), use white as inner color so the emoji colors show through
 	// LCD/grayscale/MSDF have srcColorSpace=(NVGcolorSpace)-1 and should use the text color
@@ -2714,12 +3304,39 @@ static void nvg__renderText(NVGcontext* ctx, NVGvertex* verts, int nverts, NVGco
 		paint.outerColor.a *= state->alpha;
 	}
 
+	return paint;
+}
+
+static void nvg__renderText(NVGcontext* ctx, NVGvertex* verts, int nverts, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpaint paint = nvg__textPaint(ctx, srcColorSpace, dstColorSpace, format, subpixelMode, page);
+
+	static int render_call_count = 0;
+	render_call_count++;
+	if (render_call_count <= 10 || paint.image == 0) {
+		printf("[nvg__renderText #%d] nverts=%d, src=%u dst=%u fmt=%u subpixel=%d, textureId=%d\n",
+		       render_call_count, nverts, srcColorSpace, dstColorSpace, format, subpixelMode, paint.image);
+	}
+
 	ctx->params.renderTriangles(ctx->params.userPtr, &paint, state->compositeOperation, &state->scissor, verts, nverts, ctx->fringeWidth);
 
 	ctx->drawCallCount++;
 	ctx->textTriCount += nverts/3;
 }
 
+// Instanced variant: the back-end expands each glyph quad and applies the transform
+static void nvg__renderGlyphs(NVGcontext* ctx, const NVGglyphInstance* glyphs, int nglyphs, NVGcolorSpace srcColorSpace, NVGcolorSpace dstColorSpace, NVGtextureFormat format, int subpixelMode, int page)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpaint paint = nvg__textPaint(ctx, srcColorSpace, dstColorSpace, format, subpixelMode, page);
+
+	ctx->params.renderGlyphs(ctx->params.userPtr, &paint, state->compositeOperation, &state->scissor, state->xform, glyphs, nglyphs, ctx->fringeWidth);
+
+	ctx->drawCallCount++;
+	ctx->textTriCount += nglyphs*2;
+}
+
 static int nvg__isTransformFlipped(const float *xform)
 {
 	float det = xform[0] * xform[3] - xform[2] * xform[1];
@@ -2731,11 +3348,12 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 	NVGstate* state = nvg__getState(ctx);
 	NVGTextIter iter;
 	NVGCachedGlyph q;
-	NVGvertex* verts;
+	NVGvertex* verts = NULL;
+	NVGglyphInstance* glyphs = NULL;
 	float scale = nvg__getFontScale(state) * ctx->devicePxRatio;
 	float invscale = 1.0f / scale;
-	int cverts = 0;
-	int nverts = 0;
+	int cquads = 0;
+	int nquads = 0;
 	int isFlipped = nvg__isTransformFlipped(state->xform);
 
 	if (end == NULL)
@@ -2750,37 +3368,51 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 	nvgFontSetBlur(ctx->fs, state->fontBlur*scale);
 	nvgFontSetAlign(ctx->fs, state->textAlign);
 
-	cverts = nvg__maxi(2, (int)(end - string)) * 6; // conservative estimate.
-	verts = nvg__allocTempVerts(ctx, cverts);
-	if (verts == NULL) return x;
+	cquads = nvg__maxi(2, (int)(end - string)); // conservative estimate.
+	if (ctx->params.renderGlyphs != NULL) {
+		// One instance per glyph, transformed by the back-end
+		glyphs = nvg__allocTempGlyphs(ctx, cquads);
+		if (glyphs == NULL) return x;
+	} else {
+		verts = nvg__allocTempVerts(ctx, cquads * 6);
+		if (verts == NULL) return x;
+	}
 
 	nvgFontShapedTextIterInit(ctx->fs, &iter, x*scale, y*scale, string, end, 1, NULL);
 
+	// Rasterize all missing glyphs up front (in parallel) instead of one per iteration step
+	nvgFontPrepareShapedText(ctx->fs, &iter);
+
 	// Track current atlas for batching
 	NVGcolorSpace currentSrcColorSpace = NVG_COLOR_SPACE_MAX_ENUM;
 	NVGcolorSpace currentDstColorSpace = NVG_COLOR_SPACE_MAX_ENUM;
 	NVGtextureFormat currentFormat = NVG_TEXTURE_FORMAT_UNDEFINED;
 	int currentSubpixelMode = 0;
+	int currentPage = 0;
 	int firstGlyph = 1;
-	int batchStartVert = 0;       // Start of current batch
+	int batchStart = 0;           // First quad of current batch
 
 	while (nvgFontShapedTextIterNext(ctx->fs, &iter, &q)) {
 		// Check if we need to flush the current batch due to atlas change
 		if (!firstGlyph && (q.srcColorSpace != currentSrcColorSpace ||
 		                     q.dstColorSpace != currentDstColorSpace ||
 		                     q.format != currentFormat ||
-		                     q.subpixelMode != currentSubpixelMode)) {
+		                     q.subpixelMode != currentSubpixelMode ||
+		                     q.page != currentPage)) {
 			// Flush current batch with its atlas
 			nvg__flushTextTexture(ctx);
-			int batchVerts = nverts - batchStartVert;
-			if (batchVerts > 0) {
+			int batchQuads = nquads - batchStart;
+			if (batchQuads > 0) {
 				static int batch_count = 0;
 				if (batch_count++ < 10) {
 					printf("[nvgText] Atlas change detected, flushing batch\n");
 				}
-				nvg__renderText(ctx, verts + batchStartVert, batchVerts, currentSrcColorSpace, currentDstColorSpace, currentFormat, currentSubpixelMode);
+				if (glyphs != NULL)
+					nvg__renderGlyphs(ctx, glyphs + batchStart, batchQuads, currentSrcColorSpace, currentDstColorSpace, currentFormat, currentSubpixelMode, currentPage);
+				else
+					nvg__renderText(ctx, verts + batchStart*6, batchQuads*6, currentSrcColorSpace, currentDstColorSpace, currentFormat, currentSubpixelMode, currentPage);
 			}
-			batchStartVert = nverts;
+			batchStart = nquads;
 		}
 
 		static int glyph_count = 0;
@@ -2792,6 +3424,7 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 		currentDstColorSpace = q.dstColorSpace;
 		currentFormat = q.format;
 		currentSubpixelMode = q.subpixelMode;
+		currentPage = q.page;
 		firstGlyph = 0;
 
 		float c[4*2];
@@ -2801,22 +3434,34 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 			tmp = q.y0; q.y0 = q.y1; q.y1 = tmp;
 			tmp = q.t0; q.t0 = q.t1; q.t1 = tmp;
 		}
-		// Transform corners.
 		// Apply baseline shift
 		float yShift = state->baselineShift * scale;
+		if (nquads >= cquads) continue;
+		if (glyphs != NULL) {
+			// Untransformed quad, the back-end applies state->xform per corner
+			NVGglyphInstance* g = &glyphs[nquads++];
+			g->x = q.x0*invscale;
+			g->y = (q.y0 + yShift)*invscale;
+			g->w = (q.x1 - q.x0)*invscale;
+			g->h = (q.y1 - q.y0)*invscale;
+			g->s0 = q.s0; g->t0 = q.t0;
+			g->s1 = q.s1; g->t1 = q.t1;
+			continue;
+		}
+		// Transform corners.
 		nvgTransformPoint(&c[0],&c[1], state->xform, q.x0*invscale, (q.y0 + yShift)*invscale);
 		nvgTransformPoint(&c[2],&c[3], state->xform, q.x1*invscale, (q.y0 + yShift)*invscale);
 		nvgTransformPoint(&c[4],&c[5], state->xform, q.x1*invscale, (q.y1 + yShift)*invscale);
 		nvgTransformPoint(&c[6],&c[7], state->xform, q.x0*invscale, (q.y1 + yShift)*invscale);
 		// Create triangles
-		if (nverts+6 <= cverts) {
-			nvg__vset(&verts[nverts], c[0], c[1], q.s0, q.t0); nverts++;
-			nvg__vset(&verts[nverts], c[4], c[5], q.s1, q.t1); nverts++;
-			nvg__vset(&verts[nverts], c[2], c[3], q.s1, q.t0); nverts++;
-			nvg__vset(&verts[nverts], c[0], c[1], q.s0, q.t0); nverts++;
-			nvg__vset(&verts[nverts], c[6], c[7], q.s0, q.t1); nverts++;
-			nvg__vset(&verts[nverts], c[4], c[5], q.s1, q.t1); nverts++;
-		}
+		NVGvertex* v = &verts[nquads*6];
+		nvg__vset(&v[0], c[0], c[1], q.s0, q.t0);
+		nvg__vset(&v[1], c[4], c[5], q.s1, q.t1);
+		nvg__vset(&v[2], c[2], c[3], q.s1, q.t0);
+		nvg__vset(&v[3], c[0], c[1], q.s0, q.t0);
+		nvg__vset(&v[4], c[6], c[7], q.s0, q.t1);
+		nvg__vset(&v[5], c[4], c[5], q.s1, q.t1);
+		nquads++;
 	}
 
 	nvgFontTextIterFree(&iter);
@@ -2824,9 +3469,12 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 	nvg__flushTextTexture(ctx);
 
 	// Render final batch
-	int finalBatchVerts = nverts - batchStartVert;
-	if (finalBatchVerts > 0 && !firstGlyph) {
-		nvg__renderText(ctx, verts + batchStartVert, finalBatchVerts, currentSrcColorSpace, currentDstColorSpace, currentFormat, currentSubpixelMode);
+	int finalBatchQuads = nquads - batchStart;
+	if (finalBatchQuads > 0 && !firstGlyph) {
+		if (glyphs != NULL)
+			nvg__renderGlyphs(ctx, glyphs + batchStart, finalBatchQuads, currentSrcColorSpace, currentDstColorSpace, currentFormat, currentSubpixelMode, currentPage);
+		else
+			nvg__renderText(ctx, verts + batchStart*6, finalBatchQuads*6, currentSrcColorSpace, currentDstColorSpace, currentFormat, currentSubpixelMode, currentPage);
 	}
 
 	return iter.x / scale;
@@ -3398,7 +4046,7 @@ float nvgRenderGlyph(NVGcontext* ctx, unsigned int codepoint, float x, float y)
 	nvg__vset(&verts[nverts], c[6], c[7], quad.s0, quad.t1); nverts++;
 	nvg__vset(&verts[nverts], c[4], c[5], quad.s1, quad.t1); nverts++;
 
-	nvg__renderText(ctx, verts, nverts, quad.srcColorSpace, quad.dstColorSpace, quad.format, quad.subpixelMode);
+	nvg__renderText(ctx, verts, nverts, quad.srcColorSpace, quad.dstColorSpace, quad.format, quad.subpixelMode, quad.page);
 
 	return quad.advanceX * invscale;
 }
@@ -3473,6 +4121,39 @@ int nvgFontIsFixedWidth(NVGcontext* ctx)
 	return 0;
 }
 
+void nvgGlyphRasterThreads(NVGcontext* ctx, int count)
+{
+	if (!ctx || !ctx->fs) return;
+	nvgFontSetRasterThreads(ctx->fs, count);
+}
+
+void nvgGlyphStreaming(NVGcontext* ctx, int enabled, float budgetMs)
+{
+	if (!ctx || !ctx->fs) return;
+	nvgFontSetStreaming(ctx->fs, enabled, budgetMs);
+}
+
+void nvgGlyphReadyCallback(NVGcontext* ctx, void (*callback)(void* uptr, int font, unsigned int codepoint, float size), void* uptr)
+{
+	if (!ctx || !ctx->fs) return;
+	nvgFontSetGlyphReadyCallback(ctx->fs, callback, uptr);
+}
+
+void nvgGlyphCacheStats(NVGcontext* ctx, NVGglyphCacheStats* stats)
+{
+	if (!stats) return;
+	memset(stats, 0, sizeof(NVGglyphCacheStats));
+	if (!ctx || !ctx->fs) return;
+
+	NVGGlyphCacheStats fsStats;
+	nvgFontGetGlyphCacheStats(ctx->fs, &fsStats);
+	stats->hits = fsStats.hits;
+	stats->misses = fsStats.misses;
+	stats->evictions = fsStats.evictions;
+	stats->count = fsStats.count;
+	stats->capacity = fsStats.capacity;
+}
+
 // Variable Fonts
 int nvgFontIsVariable(NVGcontext* ctx)
 {
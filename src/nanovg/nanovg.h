@@ -538,6 +538,50 @@ void nvgFill(NVGcontext* ctx);
 // Fills the current path with current stroke style.
 void nvgStroke(NVGcontext* ctx);
 
+//
+// Retained paths
+//
+// A retained path records the current path once and keeps its tessellated
+// fill and stroke geometry between frames. Redrawing it skips flattening and
+// expansion as long as the stroke width, line cap and join, miter limit,
+// tessellation tolerance and the scale/shear part of the transform stay the
+// same; translation and rotation are applied to the cached vertices.
+
+typedef struct NVGretainedPath NVGretainedPath;
+
+enum NVGdrawPathFlags {
+	NVG_PATH_FILL = 1<<0,		// Fill with current fill style.
+	NVG_PATH_STROKE = 1<<1,		// Stroke with current stroke style.
+};
+
+// Creates a retained path from the current path. The path is stored in the
+// local space of the current transform. Returns NULL on failure.
+NVGretainedPath* nvgCreatePath(NVGcontext* ctx);
+
+// Draws a retained path using the current transform and styles.
+// Flags is a combination of NVGdrawPathFlags.
+void nvgDrawPath(NVGcontext* ctx, NVGretainedPath* path, int flags);
+
+// Deletes a retained path.
+void nvgDeletePath(NVGcontext* ctx, NVGretainedPath* path);
+
+//
+// Geometry cache
+//
+// When enabled at context creation, nvgFill and nvgStroke memoize the
+// tessellation of each path in a small LRU keyed by the path commands and the
+// stroke/tessellation state, and reuse the vertices when the same path is drawn
+// again with the same transform.
+
+typedef struct NVGgeometryCacheStats {
+	int hits;		// Fills and strokes served from the cache
+	int misses;		// Fills and strokes that were tessellated
+	int entries;	// Cached tessellations
+} NVGgeometryCacheStats;
+
+// Returns the cache counters since context creation, all zero when the cache is disabled.
+void nvgGetGeometryCacheStats(NVGcontext* ctx, NVGgeometryCacheStats* stats);
+
 
 //
 // Text
@@ -738,6 +782,35 @@ int nvgFontIsScalable(NVGcontext* ctx);
 // Returns 1 if fixed-width, 0 if not or on error.
 int nvgFontIsFixedWidth(NVGcontext* ctx);
 
+// Glyph cache statistics
+typedef struct NVGglyphCacheStats {
+	unsigned int hits;       // Lookups served from the cache
+	unsigned int misses;     // Lookups that had to rasterize the glyph
+	unsigned int evictions;  // Glyphs dropped (least recently used first) to make room
+	int count;               // Glyphs currently cached
+	int capacity;            // Entry pool size (grows when one frame draws more glyphs)
+} NVGglyphCacheStats;
+
+// Set the number of worker threads used to rasterize glyph cache misses.
+// nvgText collects the missing glyphs of a string and rasterizes them in
+// parallel; atlas placement stays the same as serial rendering.
+// count: 0 rasterizes on the calling thread. Default: 4.
+void nvgGlyphRasterThreads(NVGcontext* ctx, int count);
+
+// Stream glyph cache misses instead of rasterizing them while drawing.
+// Missing glyphs are rasterized by the worker threads and left blank until
+// they are ready; nvgBeginFrame adds finished glyphs to the atlas, spending
+// at most budgetMs of the frame on them (<= 0 uses the default of 2ms).
+// Needs at least one raster thread, otherwise glyphs render synchronously.
+void nvgGlyphStreaming(NVGcontext* ctx, int enabled, float budgetMs);
+
+// Set a function called from nvgBeginFrame for every streamed glyph that
+// became available, e.g. to redraw a static scene. size is in device pixels.
+void nvgGlyphReadyCallback(NVGcontext* ctx, void (*callback)(void* uptr, int font, unsigned int codepoint, float size), void* uptr);
+
+// Get glyph cache counters. Counters accumulate over the context lifetime.
+void nvgGlyphCacheStats(NVGcontext* ctx, NVGglyphCacheStats* stats);
+
 //
 // Variable Fonts (OpenType Font Variations)
 //
@@ -851,6 +924,30 @@ struct NVGvertex {
 };
 typedef struct NVGvertex NVGvertex;
 
+// Glyph quad of instanced text (see NVGparams::renderGlyphs)
+struct NVGglyphInstance {
+	float x, y, w, h;      // Quad in text space, before the render call's xform
+	float s0, t0, s1, t1;  // Atlas UV rect
+};
+typedef struct NVGglyphInstance NVGglyphInstance;
+
+// Analytic shape of a path made of a single nvgRect, nvgRoundedRect, nvgCircle or nvgEllipse
+// (see NVGparams::renderShape). Distances are measured in shape space.
+enum NVGshapeType {
+	NVG_SHAPE_NONE = 0,
+	NVG_SHAPE_BOX,			// Rectangle, Chebyshev distance (square corners, mitered stroke)
+	NVG_SHAPE_ROUNDBOX,		// Rounded rectangle, Euclidean distance (radius 0 = rectangle with round stroke joins)
+	NVG_SHAPE_ELLIPSE,
+};
+
+struct NVGshape {
+	int type;
+	float xform[6];		// Shape space, centered on the shape, to device space
+	float extent[2];	// Half size
+	float radius;		// Corner radius of NVG_SHAPE_ROUNDBOX
+};
+typedef struct NVGshape NVGshape;
+
 struct NVGpath {
 	int first;
 	int count;
@@ -871,6 +968,7 @@ struct NVGparams {
 	int msdfText;  // Enable MSDF text rendering (requires NVG_MSDF_TEXT flag)
 	int fontAtlasSize;  // Size of font atlas (0 = default 512x512, otherwise e.g. 4096 for virtual atlas)
 	int colorSpace;  // Target color space (VkColorSpaceKHR) for text rendering (0 = default sRGB)
+	int geometryCache;  // Memoize fill/stroke tessellation across frames
 	int (*renderCreate)(void* uptr);
 	int (*renderCreateTexture)(void* uptr, int type, int w, int h, int imageFlags, const unsigned char* data);
 	int (*renderDeleteTexture)(void* uptr, int image);
@@ -883,6 +981,9 @@ struct NVGparams {
 	void (*renderFill)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, const float* bounds, const NVGpath* paths, int npaths);
 	void (*renderStroke)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, float strokeWidth, const NVGpath* paths, int npaths);
 	void (*renderTriangles)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const NVGvertex* verts, int nverts, float fringe);
+	NVGvertex* (*renderAllocVerts)(void* uptr, int nverts);  // Optional: vertex memory for expanded paths/text, valid until the next call
+	void (*renderGlyphs)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const float* xform, const NVGglyphInstance* glyphs, int nglyphs, float fringe);  // Optional: text as one quad per glyph, xform applied by the back-end
+	int (*renderShape)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, const NVGshape* shape, float strokeWidth);  // Optional: single analytic shape, strokeWidth in shape space (0 = fill); return 0 to draw it as a path
 	void (*renderDelete)(void* uptr);
 	void (*renderFontSystemCreated)(void* uptr, void* fontSystem);  // Called after font system is created
 };
@@ -0,0 +1,271 @@
+#include <stdlib.h>
+#include <math.h>
+#include "nvg_path_simd.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NVG_PATH_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define NVG_PATH_NEON 1
+#endif
+
+int nvgPathSoAReserve(NVGpathSoA* soa, int n)
+{
+	float* block;
+	int cap;
+
+	if (n <= soa->capacity)
+		return 1;
+
+	// One block: seven float arrays followed by the flags.
+	cap = n + n/2;
+	block = (float*)malloc(sizeof(float)*cap*7 + cap);
+	if (block == NULL)
+		return 0;
+	free(soa->x);
+
+	soa->x = block;
+	soa->y = block + cap;
+	soa->dx = block + cap*2;
+	soa->dy = block + cap*3;
+	soa->len = block + cap*4;
+	soa->dmx = block + cap*5;
+	soa->dmy = block + cap*6;
+	soa->flags = (unsigned char*)(block + cap*7);
+	soa->capacity = cap;
+	return 1;
+}
+
+void nvgPathSoAFree(NVGpathSoA* soa)
+{
+	free(soa->x);
+	soa->x = soa->y = NULL;
+	soa->dx = soa->dy = soa->len = NULL;
+	soa->dmx = soa->dmy = NULL;
+	soa->flags = NULL;
+	soa->capacity = 0;
+}
+
+static void nvg__segment(const float* x, const float* y, int i, int j, float* dx, float* dy, float* len)
+{
+	float sx = x[j] - x[i];
+	float sy = y[j] - y[i];
+	float d = sqrtf(sx*sx + sy*sy);
+	if (d > 1e-6f) {
+		float id = 1.0f / d;
+		sx *= id;
+		sy *= id;
+	}
+	dx[i] = sx;
+	dy[i] = sy;
+	len[i] = d;
+}
+
+static void nvg__join(const float* dx, const float* dy, const float* len, int p, int i, float iw, float miterLimit,
+					  float* dmx, float* dmy, unsigned char* flags)
+{
+	float dlx0 = dy[p], dly0 = -dx[p];
+	float dlx1 = dy[i], dly1 = -dx[i];
+	float mx = (dlx0 + dlx1) * 0.5f;
+	float my = (dly0 + dly1) * 0.5f;
+	float dmr2 = mx*mx + my*my;
+	float cross, limit;
+	unsigned char f = 0;
+
+	if (dmr2 > 0.000001f) {
+		float scale = 1.0f / dmr2;
+		if (scale > 600.0f)
+			scale = 600.0f;
+		mx *= scale;
+		my *= scale;
+	}
+	dmx[i] = mx;
+	dmy[i] = my;
+
+	cross = dx[i] * dy[p] - dx[p] * dy[i];
+	if (cross > 0.0f)
+		f |= NVG_JOIN_LEFT;
+
+	limit = (len[p] < len[i] ? len[p] : len[i]) * iw;
+	if (limit < 1.01f)
+		limit = 1.01f;
+	if ((dmr2 * limit*limit) < 1.0f)
+		f |= NVG_JOIN_INNERBEVEL;
+	if ((dmr2 * miterLimit*miterLimit) < 1.0f)
+		f |= NVG_JOIN_BEVEL;
+	flags[i] = f;
+}
+
+void nvgPathSegmentsScalar(const float* x, const float* y, int n, float* dx, float* dy, float* len)
+{
+	int i;
+	for (i = 0; i < n; i++)
+		nvg__segment(x, y, i, i+1 < n ? i+1 : 0, dx, dy, len);
+}
+
+void nvgPathJoinsScalar(const float* dx, const float* dy, const float* len, int n, float iw, float miterLimit,
+						float* dmx, float* dmy, unsigned char* flags)
+{
+	int i;
+	for (i = 0; i < n; i++)
+		nvg__join(dx, dy, len, i > 0 ? i-1 : n-1, i, iw, miterLimit, dmx, dmy, flags);
+}
+
+#if defined(NVG_PATH_SSE2)
+
+void nvgPathSegments(const float* x, const float* y, int n, float* dx, float* dy, float* len)
+{
+	const __m128 eps = _mm_set1_ps(1e-6f);
+	const __m128 one = _mm_set1_ps(1.0f);
+	int i = 0;
+
+	// Segments whose end point does not wrap around.
+	for (; i + 4 < n; i += 4) {
+		__m128 sx = _mm_sub_ps(_mm_loadu_ps(x + i + 1), _mm_loadu_ps(x + i));
+		__m128 sy = _mm_sub_ps(_mm_loadu_ps(y + i + 1), _mm_loadu_ps(y + i));
+		__m128 d = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(sx, sx), _mm_mul_ps(sy, sy)));
+		__m128 m = _mm_cmpgt_ps(d, eps);
+		__m128 id = _mm_or_ps(_mm_and_ps(m, _mm_div_ps(one, d)), _mm_andnot_ps(m, one));
+		_mm_storeu_ps(dx + i, _mm_mul_ps(sx, id));
+		_mm_storeu_ps(dy + i, _mm_mul_ps(sy, id));
+		_mm_storeu_ps(len + i, d);
+	}
+	for (; i < n; i++)
+		nvg__segment(x, y, i, i+1 < n ? i+1 : 0, dx, dy, len);
+}
+
+void nvgPathJoins(const float* dx, const float* dy, const float* len, int n, float iw, float miterLimit,
+				  float* dmx, float* dmy, unsigned char* flags)
+{
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 eps = _mm_set1_ps(0.000001f);
+	const __m128 maxScale = _mm_set1_ps(600.0f);
+	const __m128 minLimit = _mm_set1_ps(1.01f);
+	const __m128 viw = _mm_set1_ps(iw);
+	const __m128 vml = _mm_set1_ps(miterLimit);
+	int i, k;
+
+	if (n <= 0)
+		return;
+	// The first join wraps to the last segment.
+	nvg__join(dx, dy, len, n-1, 0, iw, miterLimit, dmx, dmy, flags);
+
+	for (i = 1; i + 4 <= n; i += 4) {
+		__m128 dx0 = _mm_loadu_ps(dx + i - 1), dx1 = _mm_loadu_ps(dx + i);
+		__m128 dy0 = _mm_loadu_ps(dy + i - 1), dy1 = _mm_loadu_ps(dy + i);
+		__m128 mx = _mm_mul_ps(_mm_add_ps(dy0, dy1), half);
+		__m128 my = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(zero, dx0), dx1), half);
+		__m128 dmr2 = _mm_add_ps(_mm_mul_ps(mx, mx), _mm_mul_ps(my, my));
+		__m128 m = _mm_cmpgt_ps(dmr2, eps);
+		__m128 scale = _mm_min_ps(_mm_div_ps(one, dmr2), maxScale);
+		__m128 cross, limit;
+		int left, inner, bevel;
+
+		scale = _mm_or_ps(_mm_and_ps(m, scale), _mm_andnot_ps(m, one));
+		_mm_storeu_ps(dmx + i, _mm_mul_ps(mx, scale));
+		_mm_storeu_ps(dmy + i, _mm_mul_ps(my, scale));
+
+		cross = _mm_sub_ps(_mm_mul_ps(dx1, dy0), _mm_mul_ps(dx0, dy1));
+		limit = _mm_mul_ps(_mm_min_ps(_mm_loadu_ps(len + i - 1), _mm_loadu_ps(len + i)), viw);
+		limit = _mm_max_ps(limit, minLimit);
+		left = _mm_movemask_ps(_mm_cmpgt_ps(cross, zero));
+		inner = _mm_movemask_ps(_mm_cmplt_ps(_mm_mul_ps(_mm_mul_ps(dmr2, limit), limit), one));
+		bevel = _mm_movemask_ps(_mm_cmplt_ps(_mm_mul_ps(_mm_mul_ps(dmr2, vml), vml), one));
+		for (k = 0; k < 4; k++) {
+			flags[i + k] = (unsigned char)((((left >> k) & 1) ? NVG_JOIN_LEFT : 0) |
+										   (((inner >> k) & 1) ? NVG_JOIN_INNERBEVEL : 0) |
+										   (((bevel >> k) & 1) ? NVG_JOIN_BEVEL : 0));
+		}
+	}
+	for (; i < n; i++)
+		nvg__join(dx, dy, len, i-1, i, iw, miterLimit, dmx, dmy, flags);
+}
+
+#elif defined(NVG_PATH_NEON)
+
+void nvgPathSegments(const float* x, const float* y, int n, float* dx, float* dy, float* len)
+{
+	const float32x4_t eps = vdupq_n_f32(1e-6f);
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	int i = 0;
+
+	// Segments whose end point does not wrap around.
+	for (; i + 4 < n; i += 4) {
+		float32x4_t sx = vsubq_f32(vld1q_f32(x + i + 1), vld1q_f32(x + i));
+		float32x4_t sy = vsubq_f32(vld1q_f32(y + i + 1), vld1q_f32(y + i));
+		float32x4_t d = vsqrtq_f32(vaddq_f32(vmulq_f32(sx, sx), vmulq_f32(sy, sy)));
+		float32x4_t id = vbslq_f32(vcgtq_f32(d, eps), vdivq_f32(one, d), one);
+		vst1q_f32(dx + i, vmulq_f32(sx, id));
+		vst1q_f32(dy + i, vmulq_f32(sy, id));
+		vst1q_f32(len + i, d);
+	}
+	for (; i < n; i++)
+		nvg__segment(x, y, i, i+1 < n ? i+1 : 0, dx, dy, len);
+}
+
+void nvgPathJoins(const float* dx, const float* dy, const float* len, int n, float iw, float miterLimit,
+				  float* dmx, float* dmy, unsigned char* flags)
+{
+	const float32x4_t half = vdupq_n_f32(0.5f);
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t eps = vdupq_n_f32(0.000001f);
+	const float32x4_t maxScale = vdupq_n_f32(600.0f);
+	const float32x4_t minLimit = vdupq_n_f32(1.01f);
+	const float32x4_t viw = vdupq_n_f32(iw);
+	const float32x4_t vml = vdupq_n_f32(miterLimit);
+	int i;
+
+	if (n <= 0)
+		return;
+	// The first join wraps to the last segment.
+	nvg__join(dx, dy, len, n-1, 0, iw, miterLimit, dmx, dmy, flags);
+
+	for (i = 1; i + 4 <= n; i += 4) {
+		float32x4_t dx0 = vld1q_f32(dx + i - 1), dx1 = vld1q_f32(dx + i);
+		float32x4_t dy0 = vld1q_f32(dy + i - 1), dy1 = vld1q_f32(dy + i);
+		float32x4_t mx = vmulq_f32(vaddq_f32(dy0, dy1), half);
+		float32x4_t my = vmulq_f32(vsubq_f32(vnegq_f32(dx0), dx1), half);
+		float32x4_t dmr2 = vaddq_f32(vmulq_f32(mx, mx), vmulq_f32(my, my));
+		float32x4_t scale = vminq_f32(vdivq_f32(one, dmr2), maxScale);
+		float32x4_t cross, limit;
+		uint32x4_t f;
+		uint32_t lanes[4];
+
+		scale = vbslq_f32(vcgtq_f32(dmr2, eps), scale, one);
+		vst1q_f32(dmx + i, vmulq_f32(mx, scale));
+		vst1q_f32(dmy + i, vmulq_f32(my, scale));
+
+		cross = vsubq_f32(vmulq_f32(dx1, dy0), vmulq_f32(dx0, dy1));
+		limit = vmulq_f32(vminq_f32(vld1q_f32(len + i - 1), vld1q_f32(len + i)), viw);
+		limit = vmaxq_f32(limit, minLimit);
+		f = vandq_u32(vcgtq_f32(cross, zero), vdupq_n_u32(NVG_JOIN_LEFT));
+		f = vorrq_u32(f, vandq_u32(vcltq_f32(vmulq_f32(vmulq_f32(dmr2, limit), limit), one), vdupq_n_u32(NVG_JOIN_INNERBEVEL)));
+		f = vorrq_u32(f, vandq_u32(vcltq_f32(vmulq_f32(vmulq_f32(dmr2, vml), vml), one), vdupq_n_u32(NVG_JOIN_BEVEL)));
+		vst1q_u32(lanes, f);
+		flags[i] = (unsigned char)lanes[0];
+		flags[i+1] = (unsigned char)lanes[1];
+		flags[i+2] = (unsigned char)lanes[2];
+		flags[i+3] = (unsigned char)lanes[3];
+	}
+	for (; i < n; i++)
+		nvg__join(dx, dy, len, i-1, i, iw, miterLimit, dmx, dmy, flags);
+}
+
+#else
+
+void nvgPathSegments(const float* x, const float* y, int n, float* dx, float* dy, float* len)
+{
+	nvgPathSegmentsScalar(x, y, n, dx, dy, len);
+}
+
+void nvgPathJoins(const float* dx, const float* dy, const float* len, int n, float iw, float miterLimit,
+				  float* dmx, float* dmy, unsigned char* flags)
+{
+	nvgPathJoinsScalar(dx, dy, len, n, iw, miterLimit, dmx, dmy, flags);
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef NVG_PATH_SIMD_H
+#define NVG_PATH_SIMD_H
+
+// Struct-of-arrays kernels for path flattening and join classification.
+// Points of one path are stored as parallel arrays; segment i runs from
+// point i to point (i+1) % n, join i sits between segments i-1 and i.
+// nvgPath* dispatch to SSE2 or NEON when available, the *Scalar variants
+// are the reference implementations.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Join flags, bit compatible with NVGpointFlags in nanovg.c.
+enum NVGjoinFlags {
+	NVG_JOIN_LEFT = 0x02,		// Left turn
+	NVG_JOIN_BEVEL = 0x04,		// Miter exceeds miter limit
+	NVG_JOIN_INNERBEVEL = 0x08,	// Inner miter exceeds segment length
+};
+
+typedef struct NVGpathSoA {
+	float* x;
+	float* y;
+	float* dx;
+	float* dy;
+	float* len;
+	float* dmx;
+	float* dmy;
+	unsigned char* flags;
+	int capacity;
+} NVGpathSoA;
+
+// Grows all arrays to hold at least n points, contents are not preserved.
+// Returns 1 on success, 0 on allocation failure.
+int nvgPathSoAReserve(NVGpathSoA* soa, int n);
+void nvgPathSoAFree(NVGpathSoA* soa);
+
+// Normalized segment directions and lengths.
+void nvgPathSegments(const float* x, const float* y, int n, float* dx, float* dy, float* len);
+void nvgPathSegmentsScalar(const float* x, const float* y, int n, float* dx, float* dy, float* len);
+
+// Miter extrusion vectors and NVGjoinFlags per join. iw is 1/half stroke width
+// (0 for fills), miterLimit is the stroke miter limit.
+void nvgPathJoins(const float* dx, const float* dy, const float* len, int n, float iw, float miterLimit,
+				  float* dmx, float* dmy, unsigned char* flags);
+void nvgPathJoinsScalar(const float* dx, const float* dy, const float* len, int n, float iw, float miterLimit,
+						float* dmx, float* dmy, unsigned char* flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NVG_PATH_SIMD_H
@@ -122,5 +122,35 @@ if [ $? -ne 0 ]; then
 	exit 1
 fi
 
+# Pipeline shaders. The build compiles and embeds its own copies (glslc is
+# required); these are for nvgVkSetShaderPath("src/shaders") during development.
+compile_pipeline_shader() {
+	local src="$1"
+	local out="$2"
+	shift 2
+	echo "Compiling $out..."
+	if [ "$COMPILER" = "glslc" ]; then
+		glslc "$@" "$src" -o "$out"
+	else
+		glslangValidator -V "$@" "$src" -o "$out"
+	fi
+
+	if [ $? -ne 0 ]; then
+		echo "Error: Failed to compile $src"
+		exit 1
+	fi
+}
+
+for shader in fill_grad.vert fill_grad.frag fill_img.vert fill_img.frag simple.vert simple.frag \
+              img.vert img.frag text_msdf_simple.frag text_alpha.frag shape.frag; do
+	compile_pipeline_shader "$shader" "$shader.spv"
+done
+
+# Bindless texture table variants (NVG_BINDLESS_TEXTURES)
+for shader in fill_img img text_msdf_simple text_subpixel text_alpha; do
+	compile_pipeline_shader "$shader.frag" "${shader}_bindless.frag.spv" -DNVGVK_BINDLESS
+done
+
 echo "Shader compilation successful!"
 echo "Generated: fill.vert.spv, text_instanced.vert.spv, fill.frag.spv, text_sdf.frag.spv, text_subpixel.frag.spv, text_msdf.frag.spv, text_color.frag.spv, tessellate.comp.spv"
+echo "           and the pipeline shaders (including *_bindless.frag.spv)"
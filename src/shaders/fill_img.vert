@@ -2,15 +2,18 @@
 
 layout(location = 0) in vec2 inPos;
 layout(location = 1) in vec2 inTexCoord;
+layout(location = 2) in uint inUniformIndex;
 
 layout(location = 0) out vec2 fragTexCoord;
 layout(location = 1) out vec2 fragPos;
+layout(location = 2) flat out uint fragUniformIndex;
 
 layout(binding = 0) uniform ViewUniforms {
 	vec2 viewSize;
 } view;
 
 void main() {
+	fragUniformIndex = inUniformIndex;
 	fragTexCoord = inTexCoord;
 	fragPos = inPos;
 
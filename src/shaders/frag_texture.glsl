@@ -0,0 +1,25 @@
+// Texture sampled by the fragment shader, as texSampler.
+// Default: the call's texture in set 0, binding 1 (one descriptor set per texture).
+// NVGVK_BINDLESS: every texture in one array (set 3, binding 0) indexed by the
+// call's image slot in the fragment uniforms (see frag_uniforms.glsl).
+
+#ifndef FRAG_TEXTURE_GLSL
+#define FRAG_TEXTURE_GLSL
+
+// Note: Include before any declaration (it may enable an extension)
+
+#ifdef NVGVK_BINDLESS
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Must match NVGVK_MAX_TEXTURES in C (nvg_vk_types.h)
+#define NVGVK_MAX_TEXTURES 256
+
+layout(set = 3, binding = 0) uniform sampler2D textures[NVGVK_MAX_TEXTURES];
+
+// Draws merge calls with different images, so the index is not uniform
+#define texSampler textures[nonuniformEXT(frag.image)]
+#else
+layout(binding = 1) uniform sampler2D texSampler;
+#endif
+
+#endif // FRAG_TEXTURE_GLSL
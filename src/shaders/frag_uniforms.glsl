@@ -0,0 +1,43 @@
+// Fragment uniforms (set = 2, binding = 0)
+// One entry per NanoVG call, written into a per-frame storage buffer.
+// Must match NVGVkFragUniforms in C (nvg_vk_types.h), std430 layout.
+
+#ifndef FRAG_UNIFORMS_GLSL
+#define FRAG_UNIFORMS_GLSL
+
+// Note: Including shader must have GL_GOOGLE_include_directive extension enabled.
+// Vertex shaders define NVGVK_VERTEX_STAGE first and index entries themselves.
+
+struct FragUniforms {
+	mat3x4 scissorMat;
+	mat3x4 paintMat;
+	vec4 innerCol;
+	vec4 outerCol;
+	vec2 scissorExt;
+	vec2 scissorScale;
+	vec2 extent;
+	float radius;
+	float feather;
+	float strokeMult;
+	float strokeThr;
+	int texType;
+	int type;
+	int image;        // Texture slot in the bindless table
+	int shapeType;    // Analytic shapes: NVGshapeType
+	int shapeAntiAlias;
+	vec4 xform[2];    // Instanced text: glyph transform (a, b, c, d), (e, f, -, -); shapes: inverse shape transform
+	vec4 shape;       // Analytic shapes: half extent, corner radius, stroke half width (0 = fill)
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer FragUniformBuffer {
+	FragUniforms entries[];
+} fragUniforms;
+
+#ifndef NVGVK_VERTEX_STAGE
+// Index of the call's entry, passed through flat by the vertex shader
+layout(location = 2) flat in uint fragUniformIndex;
+
+#define frag fragUniforms.entries[fragUniformIndex]
+#endif
+
+#endif // FRAG_UNIFORMS_GLSL
@@ -0,0 +1,83 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Analytic shapes (NVGVK_SHAPE): one screen quad per rect, rounded rect or
+// ellipse, coverage from the shape's signed distance instead of stencil and
+// fringe geometry.
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 1) in vec2 fragPosition;
+
+layout(location = 0) out vec4 outColor;
+
+#include "frag_uniforms.glsl"
+
+// NVGshapeType (nanovg.h)
+#define SHAPE_BOX 1
+#define SHAPE_ROUNDBOX 2
+#define SHAPE_ELLIPSE 3
+
+float scissorMask(vec2 p) {
+	vec2 sc = (frag.scissorMat * vec3(p, 1.0)).xy;
+	sc = (vec2(0.5) - abs(sc) + frag.scissorExt) * frag.scissorScale;
+	return clamp(sc.x, 0.0, 1.0) * clamp(sc.y, 0.0, 1.0);
+}
+
+// Signed distance function for rounded rectangle
+float sdroundrect(vec2 pt, vec2 ext, float rad) {
+	vec2 ext2 = ext - vec2(rad, rad);
+	vec2 d = abs(pt) - ext2;
+	return min(max(d.x, d.y), 0.0) + length(max(d, 0.0)) - rad;
+}
+
+// Chebyshev distance to a rectangle, its offsets keep square (mitered) corners
+float sdbox(vec2 pt, vec2 ext) {
+	vec2 d = abs(pt) - ext;
+	return max(d.x, d.y);
+}
+
+// First order distance to an ellipse, exact for circles
+float sdellipse(vec2 pt, vec2 rad) {
+	float k1 = length(pt / rad);
+	if (k1 < 1e-4) {
+		return -min(rad.x, rad.y);
+	}
+	float k2 = length(pt / (rad * rad));
+	return k1 * (k1 - 1.0) / k2;
+}
+
+void main() {
+	// Inverse shape transform, xform[0] = (a, b, c, d), xform[1].xy = (e, f)
+	vec2 p = vec2(dot(frag.xform[0].xz, fragPosition), dot(frag.xform[0].yw, fragPosition)) + frag.xform[1].xy;
+
+	float d;
+	if (frag.shapeType == SHAPE_BOX) {
+		d = sdbox(p, frag.shape.xy);
+	} else if (frag.shapeType == SHAPE_ROUNDBOX) {
+		d = sdroundrect(p, frag.shape.xy, frag.shape.z);
+	} else {
+		d = sdellipse(p, frag.shape.xy);
+	}
+
+	// Shape space units per pixel, taken before abs() folds the distance
+	float unit = max(length(vec2(dFdx(d), dFdy(d))), 1e-6);
+
+	// Strokes cover the band of half width shape.w around the outline
+	if (frag.shape.w > 0.0) {
+		d = abs(d) - frag.shape.w;
+	}
+
+	// AA ramp of one pixel centered on the edge, like the fringe of tessellated paths
+	float coverage = frag.shapeAntiAlias != 0 ? clamp(0.5 - d / unit, 0.0, 1.0) : step(d, 0.0);
+
+	// Gradient paint, same formula as fill_grad.frag
+	mat3 paintMat3 = mat3(
+		frag.paintMat[0].xyz,
+		frag.paintMat[1].xyz,
+		frag.paintMat[2].xyz
+	);
+	vec2 paintPos = (paintMat3 * vec3(fragPosition, 1.0)).xy;
+	float t = clamp((sdroundrect(paintPos, frag.extent, frag.radius) + frag.feather*0.5) / frag.feather, 0.0, 1.0);
+
+	outColor = mix(frag.innerCol, frag.outerCol, t) * (coverage * scissorMask(fragPosition));
+}
@@ -0,0 +1,27 @@
+#
+# Convert a SPIR-V binary to a C header with a uint32_t word array
+#
+# Usage: cmake -DINPUT=<in.spv> -DOUTPUT=<out.h> -DNAME=<array name> -P spv_to_header.cmake
+#
+
+file(READ "${INPUT}" SPV_HEX HEX)
+string(LENGTH "${SPV_HEX}" SPV_HEX_LENGTH)
+math(EXPR SPV_SIZE "${SPV_HEX_LENGTH} / 2")
+math(EXPR SPV_REMAINDER "${SPV_SIZE} % 4")
+if(SPV_SIZE EQUAL 0 OR NOT SPV_REMAINDER EQUAL 0)
+	message(FATAL_ERROR "${INPUT} is not a SPIR-V module")
+endif()
+
+# SPIR-V files are little-endian words; emit them as host integers
+string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1u," SPV_WORDS "${SPV_HEX}")
+string(REGEX REPLACE "(0x........u,0x........u,0x........u,0x........u,0x........u,0x........u,)" "\\1\n\t" SPV_WORDS "${SPV_WORDS}")
+string(REPLACE "," ", " SPV_WORDS "${SPV_WORDS}")
+string(REPLACE " \n" "\n" SPV_WORDS "${SPV_WORDS}")
+string(REGEX REPLACE "[ \t\n]+$" "" SPV_WORDS "${SPV_WORDS}")
+
+get_filename_component(SPV_SOURCE "${INPUT}" NAME)
+file(WRITE "${OUTPUT}"
+	"// Generated from ${SPV_SOURCE} at build time, do not edit\n"
+	"static const uint32_t ${NAME}[] = {\n"
+	"\t${SPV_WORDS}\n"
+	"};\n")
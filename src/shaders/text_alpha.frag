@@ -1,26 +1,12 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+#include "frag_texture.glsl"
 
 layout(location = 0) in vec2 fragTexCoord;
 
 layout(location = 0) out vec4 outColor;
 
-layout(binding = 1) uniform sampler2D texSampler;
-
-layout(push_constant) uniform FragUniforms {
-	mat3x4 scissorMat;
-	mat3x4 paintMat;
-	vec4 innerCol;
-	vec4 outerCol;
-	vec2 scissorExt;
-	vec2 scissorScale;
-	vec2 extent;
-	float radius;
-	float feather;
-	float strokeMult;
-	float strokeThr;
-	int texType;
-	int type;
-} frag;
+#include "frag_uniforms.glsl"
 
 void main() {
 	// Sample grayscale alpha texture
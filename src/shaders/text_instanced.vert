@@ -1,45 +1,36 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
-// Instance input (per glyph)
-layout(location = 2) in vec2 inInstancePosition;  // Glyph screen position
-layout(location = 3) in vec2 inInstanceSize;      // Glyph size
-layout(location = 4) in vec2 inInstanceUVOffset;  // Atlas UV offset
-layout(location = 5) in vec2 inInstanceUVSize;    // Atlas UV size
+// Instanced text: one instance per glyph, expanded to a 4 vertex triangle strip
+// (vkCmdDraw(4, glyphCount)). Must match NVGVkGlyph in C (nvg_vk_types.h).
+layout(location = 0) in vec4 inRect;          // Quad origin and size in text space
+layout(location = 1) in vec4 inUV;            // Atlas UV rect (s0, t0, s1, t1)
+layout(location = 2) in uint inUniformIndex;  // Text run (call) the glyph belongs to
 
-// Vertex output
-layout(location = 0) out vec2 outTexCoord;
-layout(location = 1) out vec2 outPosition;
+layout(location = 0) out vec2 fragTexCoord;
+layout(location = 2) flat out uint fragUniformIndex;
 
-// Push constants for view transformation
-layout(push_constant) uniform PushConstants {
+layout(binding = 0) uniform ViewUniforms {
 	vec2 viewSize;
-} pc;
+} view;
+
+#define NVGVK_VERTEX_STAGE
+#include "frag_uniforms.glsl"
 
 void main() {
-	// Generate quad corners from gl_VertexIndex
-	// 0 = top-left, 1 = top-right, 2 = bottom-left, 3 = bottom-right
-	// Using triangle strip ordering: 0, 1, 2, 3
-	vec2 corners[4] = vec2[](
-		vec2(0.0, 0.0),  // Top-left
-		vec2(1.0, 0.0),  // Top-right
-		vec2(0.0, 1.0),  // Bottom-left
-		vec2(1.0, 1.0)   // Bottom-right
-	);
-
-	vec2 corner = corners[gl_VertexIndex];
-
-	// Calculate vertex position
-	vec2 position = inInstancePosition + corner * inInstanceSize;
-	outPosition = position;
-
-	// Calculate UV coordinates
-	outTexCoord = inInstanceUVOffset + corner * inInstanceUVSize;
-
-	// Transform to NDC - Vulkan Y-up convention (Y=0 at bottom)
-	gl_Position = vec4(
-		2.0 * position.x / pc.viewSize.x - 1.0,
-		1.0 - 2.0 * position.y / pc.viewSize.y,
-		0.0,
-		1.0
-	);
+	// Strip order: top-left, top-right, bottom-left, bottom-right
+	vec2 corner = vec2(float(gl_VertexIndex & 1), float(gl_VertexIndex >> 1));
+
+	// The run's transform replaces four nvgTransformPoint calls per glyph on the CPU
+	vec4 m = fragUniforms.entries[inUniformIndex].xform[0];
+	vec2 t = fragUniforms.entries[inUniformIndex].xform[1].xy;
+	vec2 p = inRect.xy + corner * inRect.zw;
+	vec2 pos = vec2(m.x * p.x + m.z * p.y, m.y * p.x + m.w * p.y) + t;
+
+	fragUniformIndex = inUniformIndex;
+	fragTexCoord = mix(inUV.xy, inUV.zw, corner);
+
+	// Transform to NDC - NanoVG uses Y-down (0 at top), like img.vert
+	vec2 ndc = (2.0 * pos / view.viewSize) - 1.0;
+	gl_Position = vec4(ndc.x, ndc.y, 0.0, 1.0);
 }
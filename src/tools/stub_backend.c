@@ -0,0 +1,58 @@
+#include "stub_backend.h"
+#include <string.h>
+
+static int g_nextTexture = 1;
+
+static int renderCreate(void* uptr) { (void)uptr; return 1; }
+static int renderCreateTexture(void* uptr, int type, int w, int h, int imageFlags, const unsigned char* data)
+{
+	(void)uptr; (void)type; (void)w; (void)h; (void)imageFlags; (void)data;
+	return g_nextTexture++;
+}
+static int renderDeleteTexture(void* uptr, int image) { (void)uptr; (void)image; return 1; }
+static int renderUpdateTexture(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+	(void)uptr; (void)image; (void)x; (void)y; (void)w; (void)h; (void)data;
+	return 1;
+}
+static int renderGetTextureSize(void* uptr, int image, int* w, int* h)
+{
+	(void)uptr; (void)image;
+	*w = 512;
+	*h = 512;
+	return 1;
+}
+static void renderViewport(void* uptr, float width, float height, float devicePixelRatio)
+{
+	(void)uptr; (void)width; (void)height; (void)devicePixelRatio;
+}
+static void renderCancel(void* uptr) { (void)uptr; }
+static void renderFlush(void* uptr) { (void)uptr; }
+static void renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+                       float fringe, const float* bounds, const NVGpath* paths, int npaths)
+{
+	(void)uptr; (void)paint; (void)compositeOperation; (void)scissor; (void)fringe; (void)bounds; (void)paths; (void)npaths;
+}
+static void renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+                         float fringe, float strokeWidth, const NVGpath* paths, int npaths)
+{
+	(void)uptr; (void)paint; (void)compositeOperation; (void)scissor; (void)fringe; (void)strokeWidth; (void)paths; (void)npaths;
+}
+static void renderDelete(void* uptr) { (void)uptr; }
+
+void stub_backend_init(NVGparams* params)
+{
+	memset(params, 0, sizeof(*params));
+	params->renderCreate = renderCreate;
+	params->renderCreateTexture = renderCreateTexture;
+	params->renderDeleteTexture = renderDeleteTexture;
+	params->renderUpdateTexture = renderUpdateTexture;
+	params->renderGetTextureSize = renderGetTextureSize;
+	params->renderViewport = renderViewport;
+	params->renderCancel = renderCancel;
+	params->renderFlush = renderFlush;
+	params->renderFill = renderFill;
+	params->renderStroke = renderStroke;
+	params->renderDelete = renderDelete;
+	params->edgeAntiAlias = 1;
+}
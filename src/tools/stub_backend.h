@@ -0,0 +1,12 @@
+#ifndef STUB_BACKEND_H
+#define STUB_BACKEND_H
+
+#include "nanovg/nanovg.h"
+
+// Fills params with a back-end that accepts every call and draws nothing, for
+// tests of core NanoVG that run without a GPU. Textures get increasing ids and
+// report 512x512. Fill and stroke are no-ops and renderShape is unset; tests
+// install their own hooks afterwards.
+void stub_backend_init(NVGparams* params);
+
+#endif // STUB_BACKEND_H
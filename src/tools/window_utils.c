@@ -677,8 +677,21 @@ WindowVulkanContext* window_create_context(int width, int height, const char* ti
 
 	const char* layers[] = {validationLayerName};
 
+	// Vulkan 1.2 where the loader has it (descriptor indexing for NVG_BINDLESS_TEXTURES)
+	uint32_t instanceVersion = VK_API_VERSION_1_0;
+	PFN_vkEnumerateInstanceVersion enumerateInstanceVersion =
+		(PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(NULL, "vkEnumerateInstanceVersion");
+	if (enumerateInstanceVersion) {
+		enumerateInstanceVersion(&instanceVersion);
+	}
+
+	VkApplicationInfo appInfo = {0};
+	appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+	appInfo.apiVersion = instanceVersion >= VK_API_VERSION_1_2 ? VK_API_VERSION_1_2 : VK_API_VERSION_1_0;
+
 	VkInstanceCreateInfo instanceInfo = {0};
 	instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+	instanceInfo.pApplicationInfo = &appInfo;
 	instanceInfo.enabledExtensionCount = glfwExtensionCount + (validationLayerPresent ? 1 : 0);
 	instanceInfo.ppEnabledExtensionNames = extensions;
 
@@ -845,12 +858,37 @@ WindowVulkanContext* window_create_context(int width, int height, const char* ti
 
 	const char* deviceExtensions[] = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
 
+	// Enable multi-draw indirect where available (used with NVG_MULTI_DRAW_INDIRECT)
+	VkPhysicalDeviceFeatures supportedFeatures;
+	VkPhysicalDeviceFeatures enabledFeatures = {0};
+	vkGetPhysicalDeviceFeatures(ctx->physicalDevice, &supportedFeatures);
+	enabledFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+
+	// Likewise descriptor indexing (used with NVG_BINDLESS_TEXTURES, core in Vulkan 1.2)
+	VkPhysicalDeviceDescriptorIndexingFeatures enabledIndexing = {0};
+	enabledIndexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+	VkPhysicalDeviceProperties deviceProperties;
+	vkGetPhysicalDeviceProperties(ctx->physicalDevice, &deviceProperties);
+	int descriptorIndexing = appInfo.apiVersion >= VK_API_VERSION_1_2 && deviceProperties.apiVersion >= VK_API_VERSION_1_2;
+	if (descriptorIndexing) {
+		VkPhysicalDeviceDescriptorIndexingFeatures supportedIndexing = {0};
+		supportedIndexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+		VkPhysicalDeviceFeatures2 features2 = {0};
+		features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		features2.pNext = &supportedIndexing;
+		vkGetPhysicalDeviceFeatures2(ctx->physicalDevice, &features2);
+		enabledIndexing.shaderSampledImageArrayNonUniformIndexing = supportedIndexing.shaderSampledImageArrayNonUniformIndexing;
+		enabledIndexing.descriptorBindingPartiallyBound = supportedIndexing.descriptorBindingPartiallyBound;
+	}
+
 	VkDeviceCreateInfo deviceInfo = {0};
 	deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+	deviceInfo.pNext = descriptorIndexing ? &enabledIndexing : NULL;
 	deviceInfo.queueCreateInfoCount = queueCreateInfoCount;
 	deviceInfo.pQueueCreateInfos = queueInfos;
 	deviceInfo.enabledExtensionCount = 1;
 	deviceInfo.ppEnabledExtensionNames = deviceExtensions;
+	deviceInfo.pEnabledFeatures = &enabledFeatures;
 
 	if (vkCreateDevice(ctx->physicalDevice, &deviceInfo, NULL, &ctx->device) != VK_SUCCESS) {
 		fprintf(stderr, "Failed to create logical device\n");
@@ -0,0 +1,197 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nanovg/nanovg.h"
+#include "stub_backend.h"
+
+// Draws the same scene on a context with the geometry cache enabled and on one
+// without it, using a backend that records every fill and stroke. Misses and
+// hits go through the cache entry alike, so both frames of the cached context
+// are compared against the uncached reference, which must match byte for byte.
+
+typedef struct CaptureLog {
+	unsigned char* data;
+	size_t size;
+	size_t capacity;
+} CaptureLog;
+
+static CaptureLog* g_log = NULL;
+
+static void capture(const void* data, size_t size)
+{
+	if (g_log == NULL || size == 0) return;
+	if (g_log->size + size > g_log->capacity) {
+		size_t capacity = (g_log->size + size) * 2;
+		g_log->data = (unsigned char*)realloc(g_log->data, capacity);
+		g_log->capacity = capacity;
+	}
+	memcpy(g_log->data + g_log->size, data, size);
+	g_log->size += size;
+}
+
+static void capturePaths(const NVGpath* paths, int npaths)
+{
+	for (int i = 0; i < npaths; i++) {
+		capture(&paths[i].nfill, sizeof(int));
+		capture(&paths[i].nstroke, sizeof(int));
+		capture(&paths[i].convex, sizeof(int));
+		capture(paths[i].fill, sizeof(NVGvertex) * paths[i].nfill);
+		capture(paths[i].stroke, sizeof(NVGvertex) * paths[i].nstroke);
+	}
+}
+
+static void renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+                       float fringe, const float* bounds, const NVGpath* paths, int npaths)
+{
+	(void)uptr; (void)paint; (void)compositeOperation; (void)scissor;
+	capture(&fringe, sizeof(float));
+	capture(bounds, sizeof(float) * 4);
+	capture(&npaths, sizeof(int));
+	capturePaths(paths, npaths);
+}
+static void renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+                         float fringe, float strokeWidth, const NVGpath* paths, int npaths)
+{
+	(void)uptr; (void)paint; (void)compositeOperation; (void)scissor;
+	capture(&fringe, sizeof(float));
+	capture(&strokeWidth, sizeof(float));
+	capture(&npaths, sizeof(int));
+	capturePaths(paths, npaths);
+}
+
+static void drawScene(NVGcontext* vg, float strokeWidth)
+{
+	nvgBeginFrame(vg, 800, 600, 1.0f);
+
+	nvgBeginPath(vg);
+	nvgRoundedRect(vg, 20, 20, 200, 120, 16);
+	nvgFillColor(vg, nvgRGBA(40, 120, 200, 255));
+	nvgFill(vg);
+	nvgStrokeWidth(vg, strokeWidth);
+	nvgStroke(vg);
+
+	nvgBeginPath(vg);
+	nvgCircle(vg, 400, 300, 90);
+	nvgEllipse(vg, 400, 300, 40, 20);
+	nvgPathWinding(vg, NVG_HOLE);
+	nvgFill(vg);
+
+	nvgSave(vg);
+	nvgTranslate(vg, 600, 150);
+	nvgRotate(vg, 0.4f);
+	nvgBeginPath(vg);
+	nvgMoveTo(vg, -60, 40);
+	nvgBezierTo(vg, -30, -80, 30, 80, 60, -40);
+	nvgLineTo(vg, 80, 60);
+	nvgLineCap(vg, NVG_ROUND);
+	nvgLineJoin(vg, NVG_MITER);
+	nvgStrokeWidth(vg, strokeWidth * 2.0f);
+	nvgStroke(vg);
+	nvgRestore(vg);
+
+	nvgEndFrame(vg);
+}
+
+// One stroke whose tessellation exceeds the per-entry byte budget
+static void drawDenseScene(NVGcontext* vg)
+{
+	nvgBeginFrame(vg, 800, 600, 1.0f);
+	nvgBeginPath(vg);
+	nvgMoveTo(vg, 0, 300);
+	for (int i = 1; i < 20000; i++) {
+		nvgLineTo(vg, i * 0.04f, 300 + ((i & 1) ? 50.0f : -50.0f));
+	}
+	nvgStrokeWidth(vg, 2.0f);
+	nvgStroke(vg);
+	nvgEndFrame(vg);
+}
+
+static int sameLog(const char* name, const CaptureLog* a, const CaptureLog* b)
+{
+	if (a->size == 0 || a->size != b->size || memcmp(a->data, b->data, a->size) != 0) {
+		printf("%s differs from the uncached geometry (%zu vs %zu bytes)\n", name, a->size, b->size);
+		return 0;
+	}
+	return 1;
+}
+
+int main(void)
+{
+	printf("=== NanoVG Geometry Cache Test ===\n\n");
+
+	NVGparams params;
+	stub_backend_init(&params);
+	params.renderFill = renderFill;
+	params.renderStroke = renderStroke;
+	params.geometryCache = 1;
+
+	NVGcontext* vg = nvgCreateInternal(&params);
+	params.geometryCache = 0;
+	NVGcontext* ref = nvgCreateInternal(&params);
+	if (!vg || !ref) {
+		printf("Test FAILED: could not create context\n");
+		return 1;
+	}
+
+	CaptureLog reference = {0}, first = {0}, second = {0}, changed = {0};
+	NVGgeometryCacheStats stats;
+	int failed = 0;
+
+	g_log = &reference;
+	drawScene(ref, 3.0f);
+
+	g_log = &first;
+	drawScene(vg, 3.0f);
+	nvgGetGeometryCacheStats(vg, &stats);
+	printf("Frame 1: hits %d, misses %d, entries %d\n", stats.hits, stats.misses, stats.entries);
+	if (stats.hits != 0 || stats.misses != 4) {
+		printf("Expected 0 hits and 4 misses on the first frame\n");
+		failed = 1;
+	}
+
+	g_log = &second;
+	drawScene(vg, 3.0f);
+	nvgGetGeometryCacheStats(vg, &stats);
+	printf("Frame 2: hits %d, misses %d, entries %d\n", stats.hits, stats.misses, stats.entries);
+	if (stats.hits != 4 || stats.misses != 4) {
+		printf("Expected every path of the second frame to hit\n");
+		failed = 1;
+	}
+	if (!sameLog("Frame 1 (misses)", &first, &reference) || !sameLog("Frame 2 (hits)", &second, &reference)) {
+		failed = 1;
+	}
+
+	// A different stroke width must retessellate the strokes but keep the fills.
+	g_log = &changed;
+	drawScene(vg, 5.0f);
+	nvgGetGeometryCacheStats(vg, &stats);
+	printf("Frame 3: hits %d, misses %d, entries %d\n", stats.hits, stats.misses, stats.entries);
+	if (stats.hits != 6 || stats.misses != 6) {
+		printf("Expected fills to hit and strokes to miss after a stroke width change\n");
+		failed = 1;
+	}
+
+	// Over the byte budget the path is drawn but not stored.
+	g_log = NULL;
+	drawDenseScene(vg);
+	nvgGetGeometryCacheStats(vg, &stats);
+	printf("Dense frame: hits %d, misses %d, entries %d\n", stats.hits, stats.misses, stats.entries);
+	if (stats.misses != 7 || stats.entries != 6) {
+		printf("Expected the dense stroke to miss without adding an entry\n");
+		failed = 1;
+	}
+
+	nvgDeleteInternal(vg);
+	nvgDeleteInternal(ref);
+	free(reference.data);
+	free(first.data);
+	free(second.data);
+	free(changed.data);
+
+	if (failed) {
+		printf("Test FAILED\n");
+		return 1;
+	}
+	printf("Test PASSED\n");
+	return 0;
+}
@@ -0,0 +1,373 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "nanovg/nanovg.h"
+#include "nanovg/nvg_path_simd.h"
+#include "stub_backend.h"
+
+// Compares the SIMD path kernels against the scalar reference on random
+// polylines, including repeated points and straight runs. Then strokes a
+// polyline through NanoVG and compares the vertices with the original
+// array-of-structs join code kept below as a reference.
+
+#define MAX_POINTS 67
+#define TOLERANCE 1e-4f
+
+static float randf(float mn, float mx)
+{
+	return mn + (mx - mn) * ((float)rand() / (float)RAND_MAX);
+}
+
+static int nearlyEqual(float a, float b)
+{
+	return fabsf(a - b) <= TOLERANCE * fmaxf(1.0f, fmaxf(fabsf(a), fabsf(b)));
+}
+
+static int testKernels(void)
+{
+	static float x[MAX_POINTS], y[MAX_POINTS];
+	static float dx0[MAX_POINTS], dy0[MAX_POINTS], len0[MAX_POINTS];
+	static float dx1[MAX_POINTS], dy1[MAX_POINTS], len1[MAX_POINTS];
+	static float dmx0[MAX_POINTS], dmy0[MAX_POINTS], dmx1[MAX_POINTS], dmy1[MAX_POINTS];
+	static unsigned char f0[MAX_POINTS], f1[MAX_POINTS];
+	int iter, n, i, failures = 0, flagMismatches = 0, joins = 0;
+
+	srand(1234);
+	for (iter = 0; iter < 2000; iter++) {
+		float iw = (iter % 3 == 0) ? 0.0f : 1.0f / randf(0.5f, 20.0f);
+		float miterLimit = randf(1.0f, 10.0f);
+		n = 1 + iter % MAX_POINTS;
+
+		for (i = 0; i < n; i++) {
+			int kind = rand() % 8;
+			if (i > 0 && kind == 0) {
+				// Repeated point, zero length segment.
+				x[i] = x[i-1];
+				y[i] = y[i-1];
+			} else if (i > 1 && kind == 1) {
+				// Continue straight.
+				x[i] = 2.0f*x[i-1] - x[i-2];
+				y[i] = 2.0f*y[i-1] - y[i-2];
+			} else {
+				x[i] = randf(-500.0f, 500.0f);
+				y[i] = randf(-500.0f, 500.0f);
+			}
+		}
+
+		nvgPathSegmentsScalar(x, y, n, dx0, dy0, len0);
+		nvgPathSegments(x, y, n, dx1, dy1, len1);
+		for (i = 0; i < n; i++) {
+			if (!nearlyEqual(dx0[i], dx1[i]) || !nearlyEqual(dy0[i], dy1[i]) || !nearlyEqual(len0[i], len1[i])) {
+				if (failures++ < 10)
+					printf("segment %d/%d: scalar (%g %g %g) simd (%g %g %g)\n", i, n,
+						   dx0[i], dy0[i], len0[i], dx1[i], dy1[i], len1[i]);
+			}
+		}
+
+		nvgPathJoinsScalar(dx0, dy0, len0, n, iw, miterLimit, dmx0, dmy0, f0);
+		nvgPathJoins(dx0, dy0, len0, n, iw, miterLimit, dmx1, dmy1, f1);
+		for (i = 0; i < n; i++) {
+			if (!nearlyEqual(dmx0[i], dmx1[i]) || !nearlyEqual(dmy0[i], dmy1[i])) {
+				if (failures++ < 10)
+					printf("join %d/%d: scalar (%g %g) simd (%g %g)\n", i, n,
+						   dmx0[i], dmy0[i], dmx1[i], dmy1[i]);
+			}
+			// Flags come from threshold tests, rounding may only flip cases right at the threshold.
+			if (f0[i] != f1[i])
+				flagMismatches++;
+			joins++;
+		}
+	}
+
+	printf("Joins compared: %d, flag mismatches: %d\n", joins, flagMismatches);
+	if (flagMismatches * 1000 > joins)
+		failures++;
+	return failures;
+}
+
+// Array-of-structs reference, as the joins were computed before the SoA kernels.
+enum RefPointFlags {
+	REF_PT_CORNER = 0x01,
+	REF_PT_LEFT = 0x02,
+	REF_PT_BEVEL = 0x04,
+	REF_PT_INNERBEVEL = 0x08,
+};
+
+typedef struct RefPoint {
+	float x, y;
+	float dx, dy;
+	float len;
+	float dmx, dmy;
+	unsigned char flags;
+} RefPoint;
+
+static void refVset(NVGvertex* vtx, float x, float y, float u, float v)
+{
+	vtx->x = x;
+	vtx->y = y;
+	vtx->u = u;
+	vtx->v = v;
+}
+
+static void refCalculateJoins(RefPoint* pts, int count, float w, float miterLimit)
+{
+	RefPoint* p0 = &pts[count-1];
+	RefPoint* p1 = &pts[0];
+	float iw = w > 0.0f ? 1.0f / w : 0.0f;
+	int j;
+
+	for (j = 0; j < count; j++) {
+		float dlx0 = p0->dy, dly0 = -p0->dx;
+		float dlx1 = p1->dy, dly1 = -p1->dx;
+		float dmr2, cross, limit;
+		p1->dmx = (dlx0 + dlx1) * 0.5f;
+		p1->dmy = (dly0 + dly1) * 0.5f;
+		dmr2 = p1->dmx*p1->dmx + p1->dmy*p1->dmy;
+		if (dmr2 > 0.000001f) {
+			float scale = 1.0f / dmr2;
+			if (scale > 600.0f)
+				scale = 600.0f;
+			p1->dmx *= scale;
+			p1->dmy *= scale;
+		}
+		p1->flags = (p1->flags & REF_PT_CORNER) ? REF_PT_CORNER : 0;
+		cross = p1->dx * p0->dy - p0->dx * p1->dy;
+		if (cross > 0.0f)
+			p1->flags |= REF_PT_LEFT;
+		limit = fmaxf(1.01f, fminf(p0->len, p1->len) * iw);
+		if ((dmr2 * limit*limit) < 1.0f)
+			p1->flags |= REF_PT_INNERBEVEL;
+		if ((p1->flags & REF_PT_CORNER) && (dmr2 * miterLimit*miterLimit) < 1.0f)
+			p1->flags |= REF_PT_BEVEL;
+		p0 = p1++;
+	}
+}
+
+static void refChooseBevel(int bevel, const RefPoint* p0, const RefPoint* p1, float w,
+						   float* x0, float* y0, float* x1, float* y1)
+{
+	if (bevel) {
+		*x0 = p1->x + p0->dy * w;
+		*y0 = p1->y - p0->dx * w;
+		*x1 = p1->x + p1->dy * w;
+		*y1 = p1->y - p1->dx * w;
+	} else {
+		*x0 = *x1 = p1->x + p1->dmx * w;
+		*y0 = *y1 = p1->y + p1->dmy * w;
+	}
+}
+
+static NVGvertex* refBevelJoin(NVGvertex* dst, const RefPoint* p0, const RefPoint* p1, float w, float lu, float ru)
+{
+	float rx0, ry0, rx1, ry1, lx0, ly0, lx1, ly1;
+	float dlx0 = p0->dy, dly0 = -p0->dx;
+	float dlx1 = p1->dy, dly1 = -p1->dx;
+
+	if (p1->flags & REF_PT_LEFT) {
+		refChooseBevel(p1->flags & REF_PT_INNERBEVEL, p0, p1, w, &lx0,&ly0, &lx1,&ly1);
+		refVset(dst++, lx0, ly0, lu,1);
+		refVset(dst++, p1->x - dlx0*w, p1->y - dly0*w, ru,1);
+		if (p1->flags & REF_PT_BEVEL) {
+			refVset(dst++, lx0, ly0, lu,1);
+			refVset(dst++, p1->x - dlx0*w, p1->y - dly0*w, ru,1);
+			refVset(dst++, lx1, ly1, lu,1);
+			refVset(dst++, p1->x - dlx1*w, p1->y - dly1*w, ru,1);
+		} else {
+			rx0 = p1->x - p1->dmx * w;
+			ry0 = p1->y - p1->dmy * w;
+			refVset(dst++, p1->x, p1->y, 0.5f,1);
+			refVset(dst++, p1->x - dlx0*w, p1->y - dly0*w, ru,1);
+			refVset(dst++, rx0, ry0, ru,1);
+			refVset(dst++, rx0, ry0, ru,1);
+			refVset(dst++, p1->x, p1->y, 0.5f,1);
+			refVset(dst++, p1->x - dlx1*w, p1->y - dly1*w, ru,1);
+		}
+		refVset(dst++, lx1, ly1, lu,1);
+		refVset(dst++, p1->x - dlx1*w, p1->y - dly1*w, ru,1);
+	} else {
+		refChooseBevel(p1->flags & REF_PT_INNERBEVEL, p0, p1, -w, &rx0,&ry0, &rx1,&ry1);
+		refVset(dst++, p1->x + dlx0*w, p1->y + dly0*w, lu,1);
+		refVset(dst++, rx0, ry0, ru,1);
+		if (p1->flags & REF_PT_BEVEL) {
+			refVset(dst++, p1->x + dlx0*w, p1->y + dly0*w, lu,1);
+			refVset(dst++, rx0, ry0, ru,1);
+			refVset(dst++, p1->x + dlx1*w, p1->y + dly1*w, lu,1);
+			refVset(dst++, rx1, ry1, ru,1);
+		} else {
+			lx0 = p1->x + p1->dmx * w;
+			ly0 = p1->y + p1->dmy * w;
+			refVset(dst++, p1->x + dlx0*w, p1->y + dly0*w, lu,1);
+			refVset(dst++, p1->x, p1->y, 0.5f,1);
+			refVset(dst++, lx0, ly0, lu,1);
+			refVset(dst++, lx0, ly0, lu,1);
+			refVset(dst++, p1->x + dlx1*w, p1->y + dly1*w, lu,1);
+			refVset(dst++, p1->x, p1->y, 0.5f,1);
+		}
+		refVset(dst++, p1->x + dlx1*w, p1->y + dly1*w, lu,1);
+		refVset(dst++, rx1, ry1, ru,1);
+	}
+	return dst;
+}
+
+// Butt capped, miter joined stroke of an open polyline with half width w and fringe aa.
+static int refExpandStroke(const float* xy, int count, float w, float aa, float miterLimit, NVGvertex* dst)
+{
+	static RefPoint pts[64];
+	NVGvertex* start = dst;
+	RefPoint* p0;
+	RefPoint* p1;
+	float area = 0.0f, dx, dy, px, py;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		pts[i].x = xy[i*2];
+		pts[i].y = xy[i*2+1];
+		pts[i].flags = REF_PT_CORNER;
+	}
+	// NanoVG enforces counter clockwise winding on strokes too.
+	for (i = 2; i < count; i++)
+		area += (pts[i].x - pts[0].x)*(pts[i-1].y - pts[0].y) - (pts[i-1].x - pts[0].x)*(pts[i].y - pts[0].y);
+	if (area < 0.0f) {
+		for (i = 0; i < count/2; i++) {
+			RefPoint tmp = pts[i];
+			pts[i] = pts[count-1-i];
+			pts[count-1-i] = tmp;
+		}
+	}
+	for (i = 0; i < count; i++) {
+		RefPoint* p = &pts[i];
+		RefPoint* q = &pts[(i+1) % count];
+		p->dx = q->x - p->x;
+		p->dy = q->y - p->y;
+		p->len = sqrtf(p->dx*p->dx + p->dy*p->dy);
+		if (p->len > 1e-6f) {
+			p->dx /= p->len;
+			p->dy /= p->len;
+		}
+	}
+
+	w += aa * 0.5f;
+	refCalculateJoins(pts, count, w, miterLimit);
+
+	p0 = &pts[0];
+	p1 = &pts[1];
+	dx = p1->x - p0->x;
+	dy = p1->y - p0->y;
+	area = sqrtf(dx*dx + dy*dy);
+	dx /= area;
+	dy /= area;
+	px = p0->x + dx*aa*0.5f;
+	py = p0->y + dy*aa*0.5f;
+	refVset(dst++, px + dy*w - dx*aa, py - dx*w - dy*aa, 0,0);
+	refVset(dst++, px - dy*w - dx*aa, py + dx*w - dy*aa, 1,0);
+	refVset(dst++, px + dy*w, py - dx*w, 0,1);
+	refVset(dst++, px - dy*w, py + dx*w, 1,1);
+
+	for (i = 1; i < count-1; i++) {
+		if (p1->flags & (REF_PT_BEVEL | REF_PT_INNERBEVEL)) {
+			dst = refBevelJoin(dst, p0, p1, w, 0, 1);
+		} else {
+			refVset(dst++, p1->x + p1->dmx * w, p1->y + p1->dmy * w, 0,1);
+			refVset(dst++, p1->x - p1->dmx * w, p1->y - p1->dmy * w, 1,1);
+		}
+		p0 = p1++;
+	}
+
+	dx = p1->x - p0->x;
+	dy = p1->y - p0->y;
+	area = sqrtf(dx*dx + dy*dy);
+	dx /= area;
+	dy /= area;
+	px = p1->x - dx*aa*0.5f;
+	py = p1->y - dy*aa*0.5f;
+	refVset(dst++, px + dy*w, py - dx*w, 0,1);
+	refVset(dst++, px - dy*w, py + dx*w, 1,1);
+	refVset(dst++, px + dy*w + dx*aa, py - dx*w + dy*aa, 0,0);
+	refVset(dst++, px - dy*w + dx*aa, py + dx*w + dy*aa, 1,0);
+
+	return (int)(dst - start);
+}
+
+static NVGvertex g_stroke[1024];
+static int g_nstroke = 0;
+
+static void captureStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+						  float fringe, float strokeWidth, const NVGpath* paths, int npaths)
+{
+	(void)uptr; (void)paint; (void)compositeOperation; (void)scissor; (void)fringe; (void)strokeWidth;
+	g_nstroke = 0;
+	if (npaths == 1 && paths[0].nstroke <= 1024) {
+		memcpy(g_stroke, paths[0].stroke, sizeof(NVGvertex) * paths[0].nstroke);
+		g_nstroke = paths[0].nstroke;
+	}
+}
+
+static int testStrokeAgainstAoS(void)
+{
+	// Left and right turns, a straight run, a hairpin past the miter limit and
+	// a short segment next to a sharp turn for the inner bevel.
+	static const float xy[] = {
+		20,20, 120,40, 220,60, 260,180, 140,120, 150,260, 154,262, 300,120, 320,300, 60,280, 300,290,
+	};
+	const int count = (int)(sizeof(xy) / sizeof(xy[0])) / 2;
+	static NVGvertex expected[1024];
+	NVGparams params;
+	NVGcontext* vg;
+	int i, nexpected, failures = 0;
+
+	stub_backend_init(&params);
+	params.renderStroke = captureStroke;
+	vg = nvgCreateInternal(&params);
+	if (vg == NULL) {
+		printf("could not create context\n");
+		return 1;
+	}
+
+	nvgBeginFrame(vg, 400, 400, 1.0f);
+	nvgBeginPath(vg);
+	nvgMoveTo(vg, xy[0], xy[1]);
+	for (i = 1; i < count; i++)
+		nvgLineTo(vg, xy[i*2], xy[i*2+1]);
+	nvgStrokeWidth(vg, 12.0f);
+	nvgMiterLimit(vg, 4.0f);
+	nvgLineJoin(vg, NVG_MITER);
+	nvgLineCap(vg, NVG_BUTT);
+	nvgStroke(vg);
+	nvgEndFrame(vg);
+	nvgDeleteInternal(vg);
+
+	nexpected = refExpandStroke(xy, count, 6.0f, 1.0f, 4.0f, expected);
+	if (g_nstroke != nexpected) {
+		printf("stroke: %d vertices, AoS reference %d\n", g_nstroke, nexpected);
+		return 1;
+	}
+	for (i = 0; i < nexpected; i++) {
+		const NVGvertex* a = &g_stroke[i];
+		const NVGvertex* b = &expected[i];
+		if (!nearlyEqual(a->x, b->x) || !nearlyEqual(a->y, b->y) || a->u != b->u || a->v != b->v) {
+			if (failures++ < 10)
+				printf("stroke vertex %d: (%g %g %g %g) AoS reference (%g %g %g %g)\n", i,
+					   a->x, a->y, a->u, a->v, b->x, b->y, b->u, b->v);
+		}
+	}
+	printf("Stroke vertices compared: %d\n", nexpected);
+	return failures;
+}
+
+int main(void)
+{
+	int failures;
+
+	printf("=== NanoVG SoA Path Kernel Test ===\n\n");
+
+	failures = testKernels();
+	failures += testStrokeAgainstAoS();
+
+	if (failures > 0) {
+		printf("FAILED: %d mismatches\n", failures);
+		return 1;
+	}
+	printf("PASSED\n");
+	return 0;
+}
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "nanovg/nanovg.h"
+#include "stub_backend.h"
+
+// Checks which paths reach NVGparams::renderShape: a single rect, rounded rect,
+// circle or ellipse does, anything the shape shader cannot reproduce (more
+// sub-paths, bevel joins, sheared strokes, mixed corner radii) is tessellated.
+
+typedef struct ShapeLog {
+	int shapes;
+	int fills;
+	int strokes;
+	NVGshape last;
+	float lastStrokeWidth;
+} ShapeLog;
+
+static ShapeLog g_log;
+
+static void renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+                       float fringe, const float* bounds, const NVGpath* paths, int npaths)
+{
+	(void)uptr; (void)paint; (void)compositeOperation; (void)scissor; (void)fringe; (void)bounds; (void)paths; (void)npaths;
+	g_log.fills++;
+}
+static void renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+                         float fringe, float strokeWidth, const NVGpath* paths, int npaths)
+{
+	(void)uptr; (void)paint; (void)compositeOperation; (void)scissor; (void)fringe; (void)strokeWidth; (void)paths; (void)npaths;
+	g_log.strokes++;
+}
+static int renderShape(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+                       float fringe, const NVGshape* shape, float strokeWidth)
+{
+	(void)uptr; (void)compositeOperation; (void)scissor; (void)fringe;
+	if (paint->image > 0) return 0;
+	g_log.shapes++;
+	g_log.last = *shape;
+	g_log.lastStrokeWidth = strokeWidth;
+	return 1;
+}
+
+static int g_failed = 0;
+
+static int near(float a, float b)
+{
+	return fabsf(a - b) <= 1e-4f * fmaxf(1.0f, fabsf(b));
+}
+
+static void expectShape(const char* name, int type, float cx, float cy, float ex, float ey, float radius, float strokeWidth)
+{
+	const NVGshape* s = &g_log.last;
+	if (g_log.shapes != 1 || g_log.fills != 0 || g_log.strokes != 0 || s->type != type ||
+		!near(s->xform[4], cx) || !near(s->xform[5], cy) || !near(s->extent[0], ex) || !near(s->extent[1], ey) ||
+		!near(s->radius, radius) || !near(g_log.lastStrokeWidth, strokeWidth)) {
+		printf("%s: expected shape %d at (%g %g) extent (%g %g) radius %g stroke %g,\n"
+			   "  got %d shapes / %d fills / %d strokes, shape %d at (%g %g) extent (%g %g) radius %g stroke %g\n",
+			   name, type, cx, cy, ex, ey, radius, strokeWidth, g_log.shapes, g_log.fills, g_log.strokes,
+			   s->type, s->xform[4], s->xform[5], s->extent[0], s->extent[1], s->radius, g_log.lastStrokeWidth);
+		g_failed = 1;
+	} else {
+		printf("%s: shape\n", name);
+	}
+	memset(&g_log, 0, sizeof(g_log));
+}
+
+static void expectPath(const char* name)
+{
+	if (g_log.shapes != 0 || g_log.fills + g_log.strokes != 1) {
+		printf("%s: expected tessellation, got %d shapes / %d fills / %d strokes\n",
+			   name, g_log.shapes, g_log.fills, g_log.strokes);
+		g_failed = 1;
+	} else {
+		printf("%s: path\n", name);
+	}
+	memset(&g_log, 0, sizeof(g_log));
+}
+
+int main(void)
+{
+	printf("=== NanoVG Analytic Shape Detection Test ===\n\n");
+
+	NVGparams params;
+	stub_backend_init(&params);
+	params.renderFill = renderFill;
+	params.renderStroke = renderStroke;
+	params.renderShape = renderShape;
+
+	NVGcontext* vg = nvgCreateInternal(&params);
+	if (!vg) {
+		printf("Test FAILED: could not create context\n");
+		return 1;
+	}
+
+	nvgBeginFrame(vg, 800, 600, 1.0f);
+	memset(&g_log, 0, sizeof(g_log));
+
+	nvgBeginPath(vg);
+	nvgRect(vg, 10, 20, 100, 50);
+	nvgFill(vg);
+	expectShape("rect fill", NVG_SHAPE_BOX, 60, 45, 50, 25, 0, 0);
+
+	nvgBeginPath(vg);
+	nvgRect(vg, 110, 70, -100, -50);
+	nvgFill(vg);
+	expectShape("negative size rect", NVG_SHAPE_BOX, 60, 45, 50, 25, 0, 0);
+
+	nvgStrokeWidth(vg, 4.0f);
+	nvgBeginPath(vg);
+	nvgRoundedRect(vg, 0, 0, 80, 40, 8);
+	nvgStroke(vg);
+	expectShape("rounded rect stroke", NVG_SHAPE_ROUNDBOX, 40, 20, 40, 20, 8, 4);
+
+	nvgBeginPath(vg);
+	nvgRoundedRect(vg, 0, 0, 80, 40, 20);
+	nvgFill(vg);
+	expectShape("pill fill", NVG_SHAPE_ROUNDBOX, 40, 20, 40, 20, 20, 0);
+
+	nvgSave(vg);
+	nvgTranslate(vg, 300, 200);
+	nvgScale(vg, 2, 2);
+	nvgBeginPath(vg);
+	nvgCircle(vg, 10, 0, 30);
+	nvgStroke(vg);
+	expectShape("scaled circle stroke", NVG_SHAPE_ELLIPSE, 320, 200, 30, 30, 0, 4);
+	nvgRestore(vg);
+
+	nvgBeginPath(vg);
+	nvgEllipse(vg, 100, 100, 40, 20);
+	nvgFill(vg);
+	expectShape("ellipse fill", NVG_SHAPE_ELLIPSE, 100, 100, 40, 20, 0, 0);
+
+	nvgLineJoin(vg, NVG_ROUND);
+	nvgBeginPath(vg);
+	nvgRect(vg, 0, 0, 20, 20);
+	nvgStroke(vg);
+	expectShape("round joined rect stroke", NVG_SHAPE_ROUNDBOX, 10, 10, 10, 10, 0, 4);
+
+	nvgLineJoin(vg, NVG_BEVEL);
+	nvgBeginPath(vg);
+	nvgRect(vg, 0, 0, 20, 20);
+	nvgStroke(vg);
+	expectPath("bevel joined rect stroke");
+
+	nvgLineJoin(vg, NVG_MITER);
+	nvgMiterLimit(vg, 1.2f);
+	nvgBeginPath(vg);
+	nvgRect(vg, 0, 0, 20, 20);
+	nvgStroke(vg);
+	expectPath("rect stroke below the miter limit");
+	nvgMiterLimit(vg, 10.0f);
+
+	nvgBeginPath(vg);
+	nvgRect(vg, 0, 0, 20, 20);
+	nvgCircle(vg, 10, 10, 5);
+	nvgFill(vg);
+	expectPath("rect with a hole");
+
+	nvgBeginPath(vg);
+	nvgMoveTo(vg, 0, 0);
+	nvgLineTo(vg, 5, 5);
+	nvgRect(vg, 0, 0, 20, 20);
+	nvgFill(vg);
+	expectPath("rect after another sub-path");
+
+	nvgBeginPath(vg);
+	nvgRoundedRectVarying(vg, 0, 0, 80, 40, 4, 8, 4, 8);
+	nvgFill(vg);
+	expectPath("mixed corner radii");
+
+	nvgBeginPath(vg);
+	nvgRoundedRect(vg, 0, 0, 80, 10, 8);
+	nvgFill(vg);
+	expectPath("radius clamped on one axis");
+
+	nvgSave(vg);
+	nvgSkewX(vg, 0.3f);
+	nvgBeginPath(vg);
+	nvgRect(vg, 0, 0, 20, 20);
+	nvgFill(vg);
+	expectShape("sheared rect fill", NVG_SHAPE_BOX, 10 + 10 * tanf(0.3f), 10, 10, 10, 0, 0);
+	nvgStroke(vg);
+	expectPath("sheared rect stroke");
+	nvgRestore(vg);
+
+	nvgBeginPath(vg);
+	nvgEllipse(vg, 100, 100, 40, 10);
+	nvgStrokeWidth(vg, 8.0f);
+	nvgStroke(vg);
+	expectPath("thick ellipse stroke");
+
+	nvgBeginPath(vg);
+	nvgRect(vg, 0, 0, 20, 20);
+	nvgFillPaint(vg, nvgImagePattern(vg, 0, 0, 20, 20, 0, 1, 1.0f));
+	nvgFill(vg);
+	expectPath("image paint declined by the back-end");
+
+	nvgEndFrame(vg);
+	nvgDeleteInternal(vg);
+
+	if (g_failed) {
+		printf("Test FAILED\n");
+		return 1;
+	}
+	printf("Test PASSED\n");
+	return 0;
+}